@@ -0,0 +1,632 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+// upa-urltool - parses newline-delimited URLs of a large file on many threads,
+// and outputs the selected URL components as TSV or NDJSON.
+//
+
+#include "upa/mapped_file.h"
+#include "upa/public_suffix_list.h"
+#include "upa/url.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Output fields
+
+enum class field {
+    input, href, origin, protocol, username, password, host, hostname, port,
+    pathname, search, hash, registrable_domain, query_keys
+};
+
+struct field_name {
+    std::string_view name;
+    field value;
+};
+
+const field_name kFieldNames[] = {
+    { "input", field::input },
+    { "href", field::href },
+    { "origin", field::origin },
+    { "protocol", field::protocol },
+    { "username", field::username },
+    { "password", field::password },
+    { "host", field::host },
+    { "hostname", field::hostname },
+    { "port", field::port },
+    { "pathname", field::pathname },
+    { "search", field::search },
+    { "hash", field::hash },
+    { "registrable_domain", field::registrable_domain },
+    { "query_keys", field::query_keys },
+};
+
+enum class output_format { tsv, ndjson };
+
+struct options {
+    std::vector<field_name> fields;
+    output_format format = output_format::tsv;
+    std::size_t thread_count = 0;
+    std::size_t chunk_size = 1 << 20;
+    bool ordered = true;
+    bool skip_invalid = false;
+    bool stats = false;
+    const char* input_path = nullptr;
+    const char* output_path = nullptr;
+    const char* psl_path = nullptr;
+    const char* base = nullptr;
+};
+
+// Work-stealing queue of chunk indexes. Each worker takes chunks from the
+// front of its own queue, and when it is empty, steals from the back of
+// the other workers' queues.
+
+class work_queue {
+public:
+    explicit work_queue(std::size_t worker_count) {
+        for (std::size_t ind = 0; ind < worker_count; ++ind)
+            queues_.push_back(std::make_unique<worker_queue>());
+    }
+
+    void push(std::size_t worker, std::size_t task) {
+        auto& q = *queues_[worker];
+        const std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(task);
+    }
+
+    bool pop(std::size_t worker, std::size_t& task) {
+        {
+            auto& q = *queues_[worker];
+            const std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        // steal
+        for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+            auto& q = *queues_[(worker + offset) % queues_.size()];
+            const std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = q.tasks.back();
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+};
+
+// Output
+
+class output_sink {
+public:
+    explicit output_sink(std::ostream& os)
+        : os_(os)
+    {}
+
+    // Unordered output: the buffer is written as soon as possible
+    void write(const std::string& buff) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        os_.write(buff.data(), static_cast<std::streamsize>(buff.size()));
+    }
+
+    // Ordered output: the chunk outputs are written by write_ordered() in
+    // the chunk order. Workers take chunks in order with next_chunk(), which
+    // waits while the chunk is `window` or more chunks ahead of the writer,
+    // so at most `window` chunk outputs are kept in memory.
+    void init_ordered(std::size_t chunk_count, std::size_t window) {
+        chunks_.resize(chunk_count);
+        ready_.resize(chunk_count);
+        window_ = std::max<std::size_t>(window, 1);
+    }
+
+    bool next_chunk(std::size_t& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (next_chunk_ >= chunks_.size())
+            return false;
+        chunk = next_chunk_++;
+        written_cv_.wait(lock, [&] { return chunk < next_to_write_ + window_; });
+        return true;
+    }
+
+    void put_chunk(std::size_t chunk, std::string&& buff) {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            chunks_[chunk] = std::move(buff);
+            ready_[chunk] = 1;
+        }
+        ready_cv_.notify_one();
+    }
+
+    void write_ordered() {
+        for (std::size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+            std::string buff;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_cv_.wait(lock, [&] { return ready_[chunk] != 0; });
+                buff = std::move(chunks_[chunk]);
+            }
+            os_.write(buff.data(), static_cast<std::streamsize>(buff.size()));
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                next_to_write_ = chunk + 1;
+            }
+            written_cv_.notify_all();
+        }
+    }
+
+private:
+    std::ostream& os_;
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::condition_variable written_cv_;
+    std::vector<std::string> chunks_;
+    std::vector<char> ready_;
+    std::size_t window_ = 1;
+    std::size_t next_chunk_ = 0;
+    std::size_t next_to_write_ = 0;
+};
+
+// Escaping
+
+void append_tsv(std::string& out, std::string_view str) {
+    for (const char c : str) {
+        switch (c) {
+        case '\t': out += "\\t"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\\': out += "\\\\"; break;
+        default: out.push_back(c); break;
+        }
+    }
+}
+
+void append_json(std::string& out, std::string_view str) {
+    out.push_back('"');
+    for (const char c : str) {
+        const auto uc = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (uc < 0x20) {
+            out += "\\u00";
+            out.push_back(upa::util::kHexDigit[uc >> 4]);
+            out.push_back(upa::util::kHexDigit[uc & 0xF]);
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+// Worker: parses lines of the chunks and formats output
+
+class worker {
+public:
+    worker(const options& opt, const upa::public_suffix_list* psl, const upa::url* base)
+        : opt_(opt)
+        , psl_(psl)
+        , base_(base)
+    {}
+
+    void process_chunk(std::string_view chunk, std::string& out) {
+        while (!chunk.empty()) {
+            auto pos = chunk.find('\n');
+            if (pos == std::string_view::npos)
+                pos = chunk.length();
+            std::string_view line = chunk.substr(0, pos);
+            chunk.remove_prefix(std::min(pos + 1, chunk.length()));
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            process_line(line, out);
+        }
+    }
+
+    std::uint64_t line_count = 0;
+    std::uint64_t valid_count = 0;
+
+private:
+    void process_line(std::string_view line, std::string& out) {
+        ++line_count;
+        // the url object is reused, so its buffers are reused too
+        const bool valid = upa::success(url_.parse(line, base_));
+        if (valid)
+            ++valid_count;
+        else if (opt_.skip_invalid)
+            return;
+
+        if (opt_.format == output_format::ndjson)
+            out.push_back('{');
+        bool first = true;
+        for (const auto& f : opt_.fields) {
+            if (opt_.format == output_format::tsv) {
+                if (!first)
+                    out.push_back('\t');
+                if (f.value == field::input || valid)
+                    append_field(f.value, line, out);
+            } else {
+                if (!first)
+                    out.push_back(',');
+                append_json(out, f.name);
+                out.push_back(':');
+                if (f.value == field::input || valid)
+                    append_field(f.value, line, out);
+                else
+                    out += "null";
+            }
+            first = false;
+        }
+        if (opt_.format == output_format::ndjson)
+            out.push_back('}');
+        out.push_back('\n');
+    }
+
+    void append_value(std::string_view value, std::string& out) const {
+        if (opt_.format == output_format::tsv)
+            append_tsv(out, value);
+        else
+            append_json(out, value);
+    }
+
+    void append_field(field f, std::string_view line, std::string& out) {
+        switch (f) {
+        case field::input: append_value(line, out); break;
+        case field::href: append_value(url_.href(), out); break;
+        case field::origin: append_value(url_.origin(), out); break;
+        case field::protocol: append_value(url_.protocol(), out); break;
+        case field::username: append_value(url_.username(), out); break;
+        case field::password: append_value(url_.password(), out); break;
+        case field::host: append_value(url_.host(), out); break;
+        case field::hostname: append_value(url_.hostname(), out); break;
+        case field::port: append_value(url_.port(), out); break;
+        case field::pathname: append_value(url_.pathname(), out); break;
+        case field::search: append_value(url_.search(), out); break;
+        case field::hash: append_value(url_.hash(), out); break;
+        case field::registrable_domain:
+            append_value(psl_->get_suffix_view(url_,
+                upa::public_suffix_list::option::registrable_domain), out);
+            break;
+        case field::query_keys:
+            append_query_keys(out);
+            break;
+        }
+    }
+
+    // Query keys (not percent decoded): comma separated in TSV, and array
+    // of strings in NDJSON
+    void append_query_keys(std::string& out) const {
+        const bool json = opt_.format == output_format::ndjson;
+        if (json)
+            out.push_back('[');
+        if (!url_.is_null(upa::url::QUERY)) {
+            std::string_view query = url_.get_part_view(upa::url::QUERY);
+            bool first = true;
+            while (!query.empty()) {
+                auto amp = query.find('&');
+                if (amp == std::string_view::npos)
+                    amp = query.length();
+                const auto part = query.substr(0, amp);
+                query.remove_prefix(std::min(amp + 1, query.length()));
+                if (part.empty())
+                    continue;
+                if (!first)
+                    out.push_back(',');
+                append_value(part.substr(0, part.find('=')), out);
+                first = false;
+            }
+        }
+        if (json)
+            out.push_back(']');
+    }
+
+    const options& opt_;
+    const upa::public_suffix_list* psl_;
+    const upa::url* base_;
+    upa::url url_;
+};
+
+// Splits the data into chunks which end at the line end
+
+std::vector<std::string_view> split_chunks(std::string_view data, std::size_t chunk_size) {
+    std::vector<std::string_view> chunks;
+    while (!data.empty()) {
+        std::size_t len = std::min(chunk_size, data.length());
+        if (len < data.length()) {
+            const auto pos = data.find('\n', len - 1);
+            len = pos == std::string_view::npos ? data.length() : pos + 1;
+        }
+        chunks.push_back(data.substr(0, len));
+        data.remove_prefix(len);
+    }
+    return chunks;
+}
+
+int run(const options& opt) {
+    // Load inputs
+    upa::public_suffix_list psl;
+    if (opt.psl_path && !psl.load(opt.psl_path)) {
+        std::cerr << "Can't load Public Suffix List: " << opt.psl_path << std::endl;
+        return 1;
+    }
+    upa::url base;
+    if (opt.base && !upa::success(base.parse(opt.base))) {
+        std::cerr << "Invalid base URL: " << opt.base << std::endl;
+        return 1;
+    }
+
+    upa::mapped_file file;
+    if (!file.open(opt.input_path)) {
+        std::cerr << "Can't open input file: " << opt.input_path << std::endl;
+        return 1;
+    }
+
+    std::ofstream fout;
+    if (opt.output_path) {
+        fout.open(opt.output_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!fout.is_open()) {
+            std::cerr << "Can't create output file: " << opt.output_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = opt.output_path ? fout : std::cout;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Header
+    if (opt.format == output_format::tsv) {
+        std::string header;
+        for (const auto& f : opt.fields) {
+            if (!header.empty())
+                header.push_back('\t');
+            header.append(f.name);
+        }
+        header.push_back('\n');
+        os.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+
+    // In the ordered mode, workers take chunks in order from the output sink,
+    // which bounds the buffered output. In the unordered mode, chunks are
+    // distributed over the workers in contiguous ranges, so each worker reads
+    // sequentially until it starts to steal.
+    const auto chunks = split_chunks(file.view(), opt.chunk_size);
+    const std::size_t thread_count = std::max<std::size_t>(1,
+        std::min(opt.thread_count, chunks.size()));
+    work_queue queue(thread_count);
+    output_sink sink(os);
+    if (opt.ordered) {
+        sink.init_ordered(chunks.size(), 2 * thread_count);
+    } else {
+        for (std::size_t ind = 0; ind < chunks.size(); ++ind)
+            queue.push(ind * thread_count / chunks.size(), ind);
+    }
+    const auto next_chunk = [&](std::size_t worker_ind, std::size_t& chunk) {
+        return opt.ordered ? sink.next_chunk(chunk) : queue.pop(worker_ind, chunk);
+    };
+
+    std::atomic<std::uint64_t> line_count{ 0 };
+    std::atomic<std::uint64_t> valid_count{ 0 };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto work = [&](std::size_t worker_ind) {
+        constexpr std::size_t no_chunk = static_cast<std::size_t>(-1);
+        std::size_t chunk = no_chunk;
+        try {
+            worker w(opt, &psl, opt.base ? &base : nullptr);
+            std::string out; // per-thread buffer in the unordered mode
+            while (next_chunk(worker_ind, chunk)) {
+                if (opt.ordered) {
+                    std::string chunk_out;
+                    w.process_chunk(chunks[chunk], chunk_out);
+                    sink.put_chunk(chunk, std::move(chunk_out));
+                } else {
+                    w.process_chunk(chunks[chunk], out);
+                    if (out.size() >= opt.chunk_size) {
+                        sink.write(out);
+                        out.clear();
+                    }
+                }
+                chunk = no_chunk;
+            }
+            if (!out.empty())
+                sink.write(out);
+            line_count += w.line_count;
+            valid_count += w.valid_count;
+        }
+        catch (...) {
+            {
+                const std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            // unblock the ordered writer
+            if (opt.ordered) {
+                if (chunk != no_chunk)
+                    sink.put_chunk(chunk, {});
+                while (sink.next_chunk(chunk))
+                    sink.put_chunk(chunk, {});
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t ind = 1; ind < thread_count; ++ind)
+        threads.emplace_back(work, ind);
+    if (opt.ordered) {
+        // the writer runs on the main thread
+        threads.emplace_back(work, 0);
+        sink.write_ordered();
+    } else {
+        work(0);
+    }
+    for (auto& thread : threads)
+        thread.join();
+    os.flush();
+
+    if (error)
+        std::rethrow_exception(error);
+    if (!os) {
+        std::cerr << "Output error" << std::endl;
+        return 1;
+    }
+
+    if (opt.stats) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const double seconds = elapsed.count();
+        std::cerr << "Lines: " << line_count
+            << "; valid URLs: " << valid_count
+            << "; bytes: " << file.size()
+            << "; threads: " << thread_count
+            << "; time: " << seconds << " s"
+            << "; throughput: " << (seconds > 0 ? static_cast<double>(file.size()) / 1e9 / seconds : 0.0)
+            << " GB/s" << std::endl;
+    }
+    return 0;
+}
+
+bool parse_fields(std::string_view list, std::vector<field_name>& fields) {
+    fields.clear();
+    while (!list.empty()) {
+        auto pos = list.find(',');
+        if (pos == std::string_view::npos)
+            pos = list.length();
+        const auto name = list.substr(0, pos);
+        list.remove_prefix(std::min(pos + 1, list.length()));
+
+        const auto it = std::find_if(std::begin(kFieldNames), std::end(kFieldNames),
+            [&](const field_name& f) { return f.name == name; });
+        if (it == std::end(kFieldNames)) {
+            std::cerr << "Unknown field: " << name << std::endl;
+            return false;
+        }
+        fields.push_back(*it);
+    }
+    return !fields.empty();
+}
+
+void print_usage() {
+    std::cerr <<
+        "upa-urltool [<options>] <input file>\n"
+        "\n"
+        "Parses URLs of the newline-delimited input file, and outputs the selected\n"
+        "URL components (one line per input line).\n"
+        "\n"
+        "Options:\n"
+        " -f <fields>   comma separated list of fields (default: href,hostname,pathname):\n"
+        "               input, href, origin, protocol, username, password, host, hostname,\n"
+        "               port, pathname, search, hash, registrable_domain, query_keys\n"
+        " -F <format>   output format: tsv (default) or ndjson\n"
+        " -o <file>     output file (default: standard output)\n"
+        " -p <file>     Public Suffix List file (public_suffix_list.dat), required for\n"
+        "               the registrable_domain field\n"
+        " -b <URL>      base URL\n"
+        " -j <count>    number of threads (default: number of hardware threads)\n"
+        " -c <bytes>    chunk size (default: 1048576)\n"
+        " -u            unordered output (lines of different chunks may be reordered)\n"
+        " -s            skip invalid URLs\n"
+        " -S            print statistics and throughput to standard error\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    options opt;
+    parse_fields("href,hostname,pathname", opt.fields);
+    opt.thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int ind = 1; ind < argc; ++ind) {
+        const char* arg = argv[ind];
+        if (arg[0] == '-' && arg[1] != 0 && arg[2] == 0) {
+            const char flag = arg[1];
+            switch (flag) {
+            case 'u': opt.ordered = false; continue;
+            case 's': opt.skip_invalid = true; continue;
+            case 'S': opt.stats = true; continue;
+            default: break;
+            }
+            if (ind + 1 >= argc) {
+                print_usage();
+                return 1;
+            }
+            const char* value = argv[++ind];
+            switch (flag) {
+            case 'f':
+                if (!parse_fields(value, opt.fields))
+                    return 1;
+                break;
+            case 'F':
+                if (std::strcmp(value, "tsv") == 0) {
+                    opt.format = output_format::tsv;
+                } else if (std::strcmp(value, "ndjson") == 0) {
+                    opt.format = output_format::ndjson;
+                } else {
+                    std::cerr << "Unknown format: " << value << std::endl;
+                    return 1;
+                }
+                break;
+            case 'o': opt.output_path = value; break;
+            case 'p': opt.psl_path = value; break;
+            case 'b': opt.base = value; break;
+            case 'j': opt.thread_count = std::max<std::size_t>(1, std::strtoul(value, nullptr, 10)); break;
+            case 'c': opt.chunk_size = std::max<std::size_t>(1, std::strtoul(value, nullptr, 10)); break;
+            default:
+                print_usage();
+                return 1;
+            }
+        } else if (!opt.input_path) {
+            opt.input_path = arg;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (!opt.input_path) {
+        print_usage();
+        return 1;
+    }
+
+    const bool needs_psl = std::any_of(opt.fields.begin(), opt.fields.end(),
+        [](const field_name& f) { return f.value == field::registrable_domain; });
+    if (needs_psl && !opt.psl_path) {
+        std::cerr << "The registrable_domain field requires the Public Suffix List (-p option)" << std::endl;
+        return 1;
+    }
+
+    std::ios_base::sync_with_stdio(false);
+    try {
+        return run(opt);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,186 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+// This file contains portions of modified code from the wyhash
+// (final version 4) hash function:
+// https://github.com/wangyi-fudan/wyhash
+// released into the public domain (The Unlicense).
+//
+
+#ifndef UPA_HASH_H
+#define UPA_HASH_H
+
+#include "config.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#if defined(_MSC_VER) && defined(_M_X64)
+# include <intrin.h>
+#endif
+
+namespace upa {
+namespace detail {
+
+// Multiplies two 64-bit integers; the low 64 bits of the 128-bit product are
+// stored in a, and the high 64 bits in b
+inline void wy_mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128_t = unsigned __int128;
+    const uint128_t r = static_cast<uint128_t>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    const std::uint64_t ha = a >> 32;
+    const std::uint64_t hb = b >> 32;
+    const std::uint64_t la = static_cast<std::uint32_t>(a);
+    const std::uint64_t lb = static_cast<std::uint32_t>(b);
+    const std::uint64_t rh = ha * hb;
+    const std::uint64_t rm0 = ha * lb;
+    const std::uint64_t rm1 = hb * la;
+    const std::uint64_t rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    const std::uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t wy_mix(std::uint64_t a, std::uint64_t b) noexcept {
+    wy_mum(a, b);
+    return a ^ b;
+}
+
+// Reads bytes in little-endian order, so the hash value does not depend
+// on the platform
+
+inline std::uint64_t wy_bswap64(std::uint64_t v) noexcept {
+    return
+        ((v >> 56) & 0xffull) | ((v >> 40) & 0xff00ull) |
+        ((v >> 24) & 0xff0000ull) | ((v >> 8) & 0xff000000ull) |
+        ((v << 8) & 0xff00000000ull) | ((v << 24) & 0xff0000000000ull) |
+        ((v << 40) & 0xff000000000000ull) | (v << 56);
+}
+
+inline std::uint32_t wy_bswap32(std::uint32_t v) noexcept {
+    return
+        ((v >> 24) & 0xffu) | ((v >> 8) & 0xff00u) |
+        ((v << 8) & 0xff0000u) | (v << 24);
+}
+
+inline std::uint64_t wy_r8(const unsigned char* p) noexcept {
+    std::uint64_t v = 0;
+    std::memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = wy_bswap64(v);
+#endif
+    return v;
+}
+
+inline std::uint64_t wy_r4(const unsigned char* p) noexcept {
+    std::uint32_t v = 0;
+    std::memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = wy_bswap32(v);
+#endif
+    return v;
+}
+
+inline std::uint64_t wy_r3(const unsigned char* p, std::size_t k) noexcept {
+    return (static_cast<std::uint64_t>(p[0]) << 16) |
+        (static_cast<std::uint64_t>(p[k >> 1]) << 8) |
+        p[k - 1];
+}
+
+// The default secret of wyhash
+inline constexpr std::uint64_t kWySecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+} // namespace detail
+
+/// @brief Computes a 64-bit hash value of the bytes
+///
+/// The hash function is wyhash (final version 4). It is fast, and its value
+/// depends only on the input bytes and the seed, so it is the same on all
+/// platforms and standard libraries. It is not a cryptographic hash function.
+///
+/// @param[in] data pointer to the bytes to hash
+/// @param[in] len  the number of bytes
+/// @param[in] seed the seed value
+/// @return hash value
+[[nodiscard]] inline std::uint64_t hash_bytes(const void* data, std::size_t len, std::uint64_t seed) noexcept {
+    using detail::kWySecret;
+    using detail::wy_mix;
+    using detail::wy_r4;
+    using detail::wy_r8;
+
+    const auto* p = static_cast<const unsigned char*>(data);
+    seed ^= wy_mix(seed ^ kWySecret[0], kWySecret[1]);
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t d = (len >> 3) << 2;
+            a = (wy_r4(p) << 32) | wy_r4(p + d);
+            b = (wy_r4(p + len - 4) << 32) | wy_r4(p + len - 4 - d);
+        } else if (len > 0) {
+            a = detail::wy_r3(p, len);
+        }
+    } else {
+        std::size_t i = len;
+        if (i >= 48) {
+            std::uint64_t see1 = seed;
+            std::uint64_t see2 = seed;
+            do {
+                seed = wy_mix(wy_r8(p) ^ kWySecret[1], wy_r8(p + 8) ^ seed);
+                see1 = wy_mix(wy_r8(p + 16) ^ kWySecret[2], wy_r8(p + 24) ^ see1);
+                see2 = wy_mix(wy_r8(p + 32) ^ kWySecret[3], wy_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_r8(p) ^ kWySecret[1], wy_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_r8(p + i - 16);
+        b = wy_r8(p + i - 8);
+    }
+    a ^= kWySecret[1];
+    b ^= seed;
+    detail::wy_mum(a, b);
+    return wy_mix(a ^ kWySecret[0] ^ len, b ^ kWySecret[1]);
+}
+
+/// @brief Computes a 64-bit hash value of the string
+///
+/// @param[in] str  string to hash
+/// @param[in] seed the seed value
+/// @return hash value
+/// @see hash_bytes
+[[nodiscard]] inline std::uint64_t hash_bytes(std::string_view str, std::uint64_t seed = 0) noexcept {
+    return hash_bytes(str.data(), str.length(), seed);
+}
+
+/// @brief Mixes two 64-bit hash values into one
+///
+/// Can be used to combine the hash values of several strings.
+///
+/// @param[in] h1,h2 hash values to mix
+/// @return mixed hash value
+[[nodiscard]] inline std::uint64_t hash_mix(std::uint64_t h1, std::uint64_t h2) noexcept {
+    return detail::wy_mix(h1 ^ detail::kWySecret[0], h2 ^ detail::kWySecret[1]);
+}
+
+} // namespace upa
+
+#endif // UPA_HASH_H
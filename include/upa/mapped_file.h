@@ -0,0 +1,163 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_MAPPED_FILE_H
+#define UPA_MAPPED_FILE_H
+
+#include "config.h"
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+/// @brief Read-only memory-mapped file
+///
+/// Maps the whole file into memory. The mapping is released when the object
+/// is destroyed, or when close() or open() is called.
+class mapped_file {
+public:
+    /// @brief Constructs an object without a mapped file
+    mapped_file() noexcept = default;
+
+    /// @brief Opens and maps the file
+    ///
+    /// Check is_open() for success.
+    ///
+    /// @param[in] path path of the file to map
+    explicit mapped_file(const std::filesystem::path& path) {
+        open(path);
+    }
+
+    /// @brief Move constructor
+    mapped_file(mapped_file&& other) noexcept;
+
+    /// @brief Move assignment
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /// @brief Destructor; unmaps the file
+    ~mapped_file() {
+        close();
+    }
+
+    /// @brief Opens and maps the file
+    ///
+    /// The previously mapped file is unmapped first. The empty file is opened
+    /// successfully, but nothing is mapped.
+    ///
+    /// @param[in] path path of the file to map
+    /// @return `true` on success
+    UPA_API bool open(const std::filesystem::path& path);
+
+    /// @brief Unmaps the file
+    UPA_API void close() noexcept;
+
+    /// @return `true` if the file is opened
+    [[nodiscard]] bool is_open() const noexcept {
+        return is_open_;
+    }
+
+    /// @return pointer to the mapped file contents
+    [[nodiscard]] const char* data() const noexcept {
+        return data_;
+    }
+
+    /// @return size of the mapped file in bytes
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /// @return view of the mapped file contents
+    [[nodiscard]] std::string_view view() const noexcept {
+        return { data_, size_ };
+    }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool is_open_ = false;
+};
+
+inline mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(other.data_)
+    , size_(other.size_)
+    , is_open_(other.is_open_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.is_open_ = false;
+}
+
+inline mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        is_open_ = other.is_open_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.is_open_ = false;
+    }
+    return *this;
+}
+
+namespace detail {
+
+// Array of trivially copyable elements. It either owns its elements, or refers
+// to the external (memory-mapped) storage; in the latter case the elements
+// are copied to the owned storage before the first modification.
+template <typename T>
+class pod_array {
+public:
+    [[nodiscard]] const T* data() const noexcept {
+        return ext_data_ ? ext_data_ : vec_.data();
+    }
+    [[nodiscard]] std::size_t size() const noexcept {
+        return ext_data_ ? ext_size_ : vec_.size();
+    }
+    [[nodiscard]] const T& operator[](std::size_t ind) const noexcept {
+        return data()[ind];
+    }
+    [[nodiscard]] std::size_t capacity_bytes() const noexcept {
+        return vec_.capacity() * sizeof(T);
+    }
+
+    void set_external(const T* data, std::size_t size) noexcept {
+        vec_ = std::vector<T>{};
+        ext_data_ = data;
+        ext_size_ = size;
+    }
+
+    // the owned storage to modify
+    std::vector<T>& vec() {
+        if (ext_data_) {
+            vec_.assign(ext_data_, ext_data_ + ext_size_);
+            ext_data_ = nullptr;
+            ext_size_ = 0;
+        }
+        return vec_;
+    }
+
+    void clear() noexcept {
+        vec_.clear();
+        ext_data_ = nullptr;
+        ext_size_ = 0;
+    }
+
+private:
+    std::vector<T> vec_;
+    const T* ext_data_ = nullptr;
+    std::size_t ext_size_ = 0;
+};
+
+} // namespace detail
+
+} // namespace upa
+
+#endif // UPA_MAPPED_FILE_H
@@ -0,0 +1,225 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_SHARED_URL_H
+#define UPA_SHARED_URL_H
+
+#include "url.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace upa {
+
+/// @brief Immutable, reference-counted URL
+///
+/// Holds the parsed URL in an immutable shared record with the atomic
+/// reference counter, so copying the shared_url only increments the counter,
+/// and copies can be used from different threads simultaneously. It is
+/// useful to pass the URL parsed once to many consumers (for example the
+/// pipeline stages on different threads), where copying upa::url would copy
+/// its strings and search parameters.
+///
+/// It provides the const getters of upa::url; to modify the URL, make the
+/// copy with mutable_copy().
+///
+/// @par Example
+/// @code
+/// const upa::shared_url su{ "https://example.org/path?q=1" };
+/// std::thread t([su] { std::cout << su.hostname() << '\n'; });
+/// upa::url u = su.mutable_copy();
+/// u.search("");
+/// t.join();
+/// @endcode
+class shared_url {
+public:
+    /// @brief Constructs an empty (invalid) URL
+    shared_url() noexcept = default;
+
+    /// @brief Parsing constructor
+    ///
+    /// Throws url_error exception on parse error.
+    ///
+    /// @param[in] str_url URL string to parse
+    /// @param[in] base pointer to base URL, may be `nullptr`
+    template <class T, enable_if_str_arg_t<T> = 0>
+    explicit shared_url(const T& str_url, const url* base = nullptr)
+        : ptr_(std::make_shared<const url>(str_url, base))
+    {}
+
+    /// @brief Constructs from the URL by copying it
+    ///
+    /// @param[in] u URL to copy
+    explicit shared_url(const url& u)
+        : ptr_(std::make_shared<const url>(u))
+    {}
+
+    /// @brief Constructs from the URL by moving it
+    ///
+    /// @param[in] u URL to move
+    explicit shared_url(url&& u)
+        : ptr_(std::make_shared<const url>(std::move(u)))
+    {}
+
+    /// @brief Constructs from the shared pointer to URL
+    ///
+    /// For example from the pointer returned by url_parse_cache::get().
+    ///
+    /// @param[in] ptr pointer to URL, may be `nullptr`
+    explicit shared_url(std::shared_ptr<const url> ptr) noexcept
+        : ptr_(std::move(ptr))
+    {}
+
+    /// @return the reference to the shared URL
+    [[nodiscard]] const url& get() const noexcept {
+        return ptr_ ? *ptr_ : empty_url();
+    }
+
+    /// @return the reference to the shared URL
+    [[nodiscard]] const url& operator*() const noexcept {
+        return get();
+    }
+
+    /// @return the pointer to the shared URL
+    [[nodiscard]] const url* operator->() const noexcept {
+        return &get();
+    }
+
+    /// @return the copy of URL, which can be modified
+    [[nodiscard]] url mutable_copy() const {
+        return get();
+    }
+
+    /// @return the shared pointer to URL (`nullptr` if URL is empty)
+    [[nodiscard]] const std::shared_ptr<const url>& get_shared_ptr() const noexcept {
+        return ptr_;
+    }
+
+    /// @return the number of shared_url objects sharing the URL (0 if URL
+    ///   is empty)
+    [[nodiscard]] long use_count() const noexcept {
+        return ptr_.use_count();
+    }
+
+    /// @brief Swaps the contents of two shared URLs
+    ///
+    /// @param[in,out] other shared_url to exchange the contents with
+    void swap(shared_url& other) noexcept {
+        ptr_.swap(other.ptr_);
+    }
+
+    // Getters; see the upa::url functions of the same name
+
+    [[nodiscard]] std::string_view href() const UPA_LIFETIMEBOUND { return get().href(); }
+    [[nodiscard]] std::string_view get_href() const UPA_LIFETIMEBOUND { return get().href(); }
+    [[nodiscard]] std::string origin() const { return get().origin(); }
+    [[nodiscard]] origin_view get_origin_view() const UPA_LIFETIMEBOUND { return get().get_origin_view(); }
+    [[nodiscard]] bool same_origin(const url& other) const { return get().same_origin(other); }
+    [[nodiscard]] bool same_origin(const shared_url& other) const { return get().same_origin(other.get()); }
+    [[nodiscard]] std::string_view protocol() const UPA_LIFETIMEBOUND { return get().protocol(); }
+    [[nodiscard]] std::string_view get_protocol() const UPA_LIFETIMEBOUND { return get().protocol(); }
+    [[nodiscard]] std::string_view username() const UPA_LIFETIMEBOUND { return get().username(); }
+    [[nodiscard]] std::string_view get_username() const UPA_LIFETIMEBOUND { return get().username(); }
+    [[nodiscard]] std::string_view password() const UPA_LIFETIMEBOUND { return get().password(); }
+    [[nodiscard]] std::string_view get_password() const UPA_LIFETIMEBOUND { return get().password(); }
+    [[nodiscard]] std::string_view host() const UPA_LIFETIMEBOUND { return get().host(); }
+    [[nodiscard]] std::string_view get_host() const UPA_LIFETIMEBOUND { return get().host(); }
+    [[nodiscard]] std::string_view hostname() const UPA_LIFETIMEBOUND { return get().hostname(); }
+    [[nodiscard]] std::string_view get_hostname() const UPA_LIFETIMEBOUND { return get().hostname(); }
+    [[nodiscard]] HostType host_type() const noexcept { return get().host_type(); }
+    [[nodiscard]] std::string_view port() const UPA_LIFETIMEBOUND { return get().port(); }
+    [[nodiscard]] std::string_view get_port() const UPA_LIFETIMEBOUND { return get().port(); }
+    [[nodiscard]] int port_int() const { return get().port_int(); }
+    [[nodiscard]] int real_port_int() const { return get().real_port_int(); }
+    [[nodiscard]] std::string_view path() const UPA_LIFETIMEBOUND { return get().path(); }
+    [[nodiscard]] std::string_view get_path() const UPA_LIFETIMEBOUND { return get().path(); }
+    [[nodiscard]] std::string_view pathname() const UPA_LIFETIMEBOUND { return get().pathname(); }
+    [[nodiscard]] std::string_view get_pathname() const UPA_LIFETIMEBOUND { return get().pathname(); }
+    [[nodiscard]] std::string_view search() const UPA_LIFETIMEBOUND { return get().search(); }
+    [[nodiscard]] std::string_view get_search() const UPA_LIFETIMEBOUND { return get().search(); }
+    [[nodiscard]] std::string_view hash() const UPA_LIFETIMEBOUND { return get().hash(); }
+    [[nodiscard]] std::string_view get_hash() const UPA_LIFETIMEBOUND { return get().hash(); }
+    [[nodiscard]] std::string_view serialize(bool exclude_fragment = false) const UPA_LIFETIMEBOUND {
+        return get().serialize(exclude_fragment);
+    }
+    [[nodiscard]] bool empty() const noexcept { return get().empty(); }
+    [[nodiscard]] bool is_valid() const noexcept { return get().is_valid(); }
+    [[nodiscard]] std::pair<std::size_t, std::size_t> get_part_pos(url::PartType t,
+        bool with_sep = false) const {
+        return get().get_part_pos(t, with_sep);
+    }
+    [[nodiscard]] std::string_view get_part_view(url::PartType t) const UPA_LIFETIMEBOUND {
+        return get().get_part_view(t);
+    }
+    [[nodiscard]] bool is_empty(url::PartType t) const { return get().is_empty(t); }
+    [[nodiscard]] bool is_null(url::PartType t) const noexcept { return get().is_null(t); }
+    [[nodiscard]] bool is_special_scheme() const noexcept { return get().is_special_scheme(); }
+    [[nodiscard]] bool is_file_scheme() const noexcept { return get().is_file_scheme(); }
+    [[nodiscard]] bool is_http_scheme() const noexcept { return get().is_http_scheme(); }
+    [[nodiscard]] bool has_credentials() const { return get().has_credentials(); }
+    [[nodiscard]] bool has_opaque_path() const noexcept { return get().has_opaque_path(); }
+    [[nodiscard]] std::string to_string() const { return get().to_string(); }
+    [[nodiscard]] std::uint64_t hash_value() const noexcept { return get().hash_value(); }
+    void serialize_record(std::string& output) const { get().serialize_record(output); }
+
+private:
+    static const url& empty_url() noexcept {
+        static const url empty;
+        return empty;
+    }
+
+    std::shared_ptr<const url> ptr_;
+};
+
+/// @brief Makes the shared URL; the URL is parsed and its hash value is
+///   cached
+///
+/// Throws url_error exception on parse error.
+///
+/// @param[in] str_url URL string to parse
+/// @param[in] base pointer to base URL, may be `nullptr`
+/// @return shared URL
+template <class T, enable_if_str_arg_t<T> = 0>
+[[nodiscard]] inline shared_url make_shared_url(const T& str_url, const url* base = nullptr) {
+    url u{ str_url, base };
+    u.cache_hash();
+    return shared_url{ std::move(u) };
+}
+
+/// @brief Swaps the contents of two shared URLs
+inline void swap(shared_url& lhs, shared_url& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/// @brief Lexicographically compares two URL's
+[[nodiscard]] inline bool operator==(const shared_url& lhs, const shared_url& rhs) noexcept {
+    return lhs.get_shared_ptr() == rhs.get_shared_ptr() || lhs.get() == rhs.get();
+}
+
+/// @brief Performs stream output on URL
+inline std::ostream& operator<<(std::ostream& os, const shared_url& su) {
+    return os << su.get();
+}
+
+} // namespace upa
+
+namespace std {
+
+/// @brief std::hash specialization for upa::shared_url class
+template<>
+struct hash<upa::shared_url> {
+    [[nodiscard]] std::size_t operator()(const upa::shared_url& su) const noexcept {
+        return static_cast<std::size_t>(su.hash_value());
+    }
+};
+
+} // namespace std
+
+#endif // UPA_SHARED_URL_H
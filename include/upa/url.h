@@ -19,11 +19,14 @@
 
 #include "buffer.h"
 #include "config.h"             // IWYU pragma: export
+#include "hash.h"               // IWYU pragma: export
 #include "str_arg.h"            // IWYU pragma: export
 #include "url_host.h"           // IWYU pragma: export
+#include "url_path_segments.h"  // IWYU pragma: export
 #include "url_percent_encode.h" // IWYU pragma: export
 #include "url_result.h"         // IWYU pragma: export
 #include "url_search_params.h"  // IWYU pragma: export
+#include "url_stats.h"          // IWYU pragma: export
 #include "url_version.h"        // IWYU pragma: export
 #include "util.h"
 #include <algorithm>
@@ -45,6 +48,11 @@
 // #define UPA_URL_USE_ENCODING
 
 namespace upa {
+
+// Forward declarations
+class url_stream_parser;
+class url_table;
+
 namespace detail {
 
 // Forward declarations
@@ -71,6 +79,147 @@ inline constexpr const char* kBaseURLParseError = "Base URL parse error";
 
 } // namespace detail
 
+/// @brief Non-owning view of the URL's origin
+///
+/// The origin is either opaque, or a tuple consisting of a scheme, a host and
+/// a port. The scheme, host and port views refer to the URL's string, so the
+/// origin view is valid until the URL is modified or destroyed.
+///
+/// More info: https://html.spec.whatwg.org/multipage/browsers.html#concept-origin
+///
+/// @see url::get_origin_view(), url::same_origin()
+class origin_view {
+public:
+    /// @brief Constructs an opaque origin view
+    constexpr origin_view() noexcept = default;
+
+    /// @brief Constructs a tuple origin view
+    ///
+    /// @param[in] scheme the scheme
+    /// @param[in] host   the serialized host
+    /// @param[in] port   the serialized port, or the empty string if port is null
+    constexpr origin_view(std::string_view scheme, std::string_view host, std::string_view port) noexcept
+        : scheme_(scheme)
+        , host_(host)
+        , port_(port)
+        , is_opaque_(false)
+    {}
+
+    /// @return `true` if origin is opaque, `false` if it is a tuple origin
+    [[nodiscard]] constexpr bool is_opaque() const noexcept {
+        return is_opaque_;
+    }
+
+    /// @return origin's scheme, or the empty string if origin is opaque
+    [[nodiscard]] constexpr std::string_view scheme() const noexcept {
+        return scheme_;
+    }
+
+    /// @return origin's serialized host, or the empty string if origin is opaque
+    [[nodiscard]] constexpr std::string_view host() const noexcept {
+        return host_;
+    }
+
+    /// @return origin's serialized port, or the empty string if port is null or
+    ///   origin is opaque
+    [[nodiscard]] constexpr std::string_view port() const noexcept {
+        return port_;
+    }
+
+    /// @return the length of the ASCII serialized origin
+    [[nodiscard]] constexpr std::size_t serialized_length() const noexcept {
+        if (is_opaque_)
+            return 4; // "null"
+        // "scheme://host[:port]"
+        return scheme_.length() + 3 + host_.length() +
+            (port_.empty() ? 0 : port_.length() + 1);
+    }
+
+    /// @brief ASCII serializes the origin into the caller's buffer
+    ///
+    /// Nothing is written if the buffer is too small. The serialized string
+    /// is not null-terminated.
+    ///
+    /// More info: https://html.spec.whatwg.org/multipage/browsers.html#ascii-serialisation-of-an-origin
+    ///
+    /// @param[out] buffer the buffer to write to
+    /// @param[in] size    the size of the @a buffer
+    /// @return the length of the serialized origin (see serialized_length())
+    std::size_t serialize(char* buffer, std::size_t size) const noexcept {
+        const std::size_t len = serialized_length();
+        if (len <= size) {
+            if (is_opaque_) {
+                std::char_traits<char>::copy(buffer, "null", 4);
+            } else {
+                char* out = buffer;
+                out = copy_to(out, scheme_);
+                out = copy_to(out, std::string_view{ "://", 3 });
+                out = copy_to(out, host_);
+                if (!port_.empty()) {
+                    *out++ = ':';
+                    copy_to(out, port_);
+                }
+            }
+        }
+        return len;
+    }
+
+    /// @brief Appends the ASCII serialized origin to the string
+    ///
+    /// @param[in,out] output the string to append to
+    void append_to(std::string& output) const {
+        const std::size_t pos = output.length();
+        output.resize(pos + serialized_length());
+        serialize(output.data() + pos, output.length() - pos);
+    }
+
+    /// @return ASCII serialized origin
+    [[nodiscard]] std::string to_string() const {
+        std::string str;
+        append_to(str);
+        return str;
+    }
+
+    /// @brief Computes the hash value of the origin
+    ///
+    /// Origins with equal serializations have equal hash values.
+    ///
+    /// @param[in] seed the seed value
+    /// @return hash value
+    [[nodiscard]] std::uint64_t hash(std::uint64_t seed = 0) const noexcept {
+        if (is_opaque_)
+            return hash_bytes(std::string_view{ "null", 4 }, seed);
+        return hash_bytes(port_, hash_bytes(host_, hash_bytes(scheme_, seed)));
+    }
+
+    /// @brief Compares serialized origins
+    ///
+    /// Note: two opaque origins are equal here, as their serializations ("null")
+    /// are. Use url::same_origin() to check the URLs are same origin.
+    [[nodiscard]] friend constexpr bool operator==(const origin_view& lhs, const origin_view& rhs) noexcept {
+        return lhs.is_opaque_ == rhs.is_opaque_ &&
+            lhs.scheme_ == rhs.scheme_ &&
+            lhs.host_ == rhs.host_ &&
+            lhs.port_ == rhs.port_;
+    }
+
+    /// @brief Compares serialized origins
+    [[nodiscard]] friend constexpr bool operator!=(const origin_view& lhs, const origin_view& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    static char* copy_to(char* out, std::string_view str) noexcept {
+        std::char_traits<char>::copy(out, str.data(), str.length());
+        return out + str.length();
+    }
+
+    std::string_view scheme_;
+    std::string_view host_;
+    std::string_view port_;
+    bool is_opaque_ = true;
+};
+
 /// @brief URL class
 ///
 /// Follows specification in
@@ -206,6 +355,29 @@ class url {
         return parse(str_url, &base);
     }
 
+    /// @brief Parses given URL string against base URL, reusing the string's buffer.
+    ///
+    /// The same as `parse(const T&, const url*)`, but if @a str_url is the http or
+    /// https URL, which the parser does not change (lower case scheme and ASCII
+    /// host, no default port, no credentials, no dot segments, no characters to
+    /// percent-encode), then it is validated in place and its buffer becomes this
+    /// URL's serialized URL without copying. Use it when the input string is not
+    /// needed after parsing. The @a str_url is left in a valid but unspecified state.
+    ///
+    /// @param[in,out] str_url URL string to parse
+    /// @param[in] base    pointer to base URL, may be nullptr
+    /// @return error code (@a validation_errc::ok on success)
+    validation_errc parse(std::string&& str_url, const url* base = nullptr);
+
+    /// @brief Parses given URL string against base URL, reusing the string's buffer.
+    ///
+    /// @param[in,out] str_url URL string to parse
+    /// @param[in] base    base URL
+    /// @return error code (@a validation_errc::ok on success)
+    validation_errc parse(std::string&& str_url, const url& base) {
+        return parse(std::move(str_url), &base);
+    }
+
     /// @brief Parses given URL string against base URL.
     ///
     /// @param[in] str_url  URL string to parse
@@ -264,6 +436,60 @@ class url {
             can_parse(str_url, &base);
     }
 
+    // HTTP request-target parser
+
+    /// @brief Parses the HTTP request-target
+    ///
+    /// Reconstructs the target URI of the HTTP request (RFC 9112, section 3.3).
+    /// The form of request-target is determined by its first character:
+    /// * origin-form (`/path?query`): the URL is made of @a scheme, @a host and
+    ///   @a target;
+    /// * asterisk-form (`*`): the URL is made of @a scheme and @a host;
+    /// * absolute-form (`http://host/path?query`): the @a target is parsed as
+    ///   an absolute URL, @a scheme and @a host are ignored.
+    ///
+    /// In the origin-form and asterisk-form, each piece is parsed directly into
+    /// this URL, without concatenating them into an intermediate string.
+    /// Use parse_authority_target() to parse the authority-form of CONNECT
+    /// requests.
+    ///
+    /// @param[in] scheme the request's scheme, for example "https"
+    /// @param[in] host   the Host header field value: host and optional port
+    /// @param[in] target the request-target
+    /// @return error code (@a validation_errc::ok on success)
+    validation_errc parse_request_target(std::string_view scheme, std::string_view host,
+        std::string_view target);
+
+    /// @brief Parses the authority-form of HTTP request-target
+    ///
+    /// The authority-form (`host:port`) is used in the CONNECT requests; the
+    /// URL is made of @a scheme and @a authority, and it has the empty path.
+    ///
+    /// @param[in] scheme    the request's scheme, for example "https"
+    /// @param[in] authority the request-target: host and optional port
+    /// @return error code (@a validation_errc::ok on success)
+    validation_errc parse_authority_target(std::string_view scheme, std::string_view authority);
+
+    /// @brief Creates the URL from the HTTP request-target
+    ///
+    /// @param[in] scheme the request's scheme, for example "https"
+    /// @param[in] host   the Host header field value: host and optional port
+    /// @param[in] target the request-target
+    /// @return URL
+    /// @throws url_error if the URL can not be made of the given pieces
+    /// @see parse_request_target()
+    [[nodiscard]] static url from_request_target(std::string_view scheme, std::string_view host,
+        std::string_view target);
+
+    /// @brief Creates the URL from the authority-form of HTTP request-target
+    ///
+    /// @param[in] scheme    the request's scheme, for example "https"
+    /// @param[in] authority the request-target: host and optional port
+    /// @return URL
+    /// @throws url_error if the URL can not be made of the given pieces
+    /// @see parse_authority_target()
+    [[nodiscard]] static url from_authority_target(std::string_view scheme, std::string_view authority);
+
     // Setters
 
     /// @brief The href setter
@@ -417,6 +643,29 @@ class url {
     /// @return ASCII serialized URL's origin
     [[nodiscard]] std::string origin() const;
 
+    /// @brief Gets the URL's origin as a view of scheme, host and port
+    ///
+    /// Unlike origin(), it does not build a string and does not allocate. For
+    /// blob URLs, the origin is obtained from the URL's path, if the path starts
+    /// with the serialized origin in the canonical form (as it is in blob URLs
+    /// created by user agents); otherwise the returned origin is opaque, even
+    /// if origin() returns a tuple origin.
+    ///
+    /// @return view of the URL's origin, valid until the URL is modified
+    [[nodiscard]] origin_view get_origin_view() const UPA_LIFETIMEBOUND;
+
+    /// @brief Checks whether URLs are same origin
+    ///
+    /// Compares origins without building strings. Opaque origins are not
+    /// same origin with any other origin. Agrees with origin(): the blob URL,
+    /// whose path has a non-canonical origin, is compared by parsing its path.
+    ///
+    /// More info: https://html.spec.whatwg.org/multipage/browsers.html#same-origin
+    ///
+    /// @param[in] other URL to compare origins with
+    /// @return `true` if both URLs have the same tuple origin, `false` otherwise
+    [[nodiscard]] bool same_origin(const url& other) const;
+
     /// @brief The protocol getter
     ///
     /// More info: https://url.spec.whatwg.org/#dom-url-protocol
@@ -501,6 +750,16 @@ class url {
     /// Equivalent to @link pathname() const @endlink
     [[nodiscard]] std::string_view get_pathname() const UPA_LIFETIMEBOUND { return pathname(); }
 
+    /// @brief The path segments getter
+    ///
+    /// Returns the lazy range of the URL’s path segments, which does not
+    /// allocate; use its `decoded()` function to get the range of
+    /// percent-decoded segments. The range is empty if the URL has an opaque
+    /// path.
+    ///
+    /// @return path_segments_view, which is valid until the URL is modified
+    [[nodiscard]] path_segments_view path_segments() const noexcept UPA_LIFETIMEBOUND;
+
     /// @brief The search getter
     ///
     /// More info: https://url.spec.whatwg.org/#dom-url-search
@@ -647,6 +906,55 @@ class url {
     /// @return serialized URL as `std::string`
     [[nodiscard]] std::string to_string() const;
 
+    // Hash
+
+    /// @brief Computes the hash value of the URL and caches it in this object
+    ///
+    /// The cached value is used by the hash_value() function (and so by the
+    /// `std::hash<upa::url>` and the `upa::url_hasher{}`) until the URL is
+    /// modified.
+    void cache_hash() noexcept;
+
+    /// @brief Gets the hash value of the serialized URL
+    ///
+    /// Returns the value cached by the cache_hash(), or computes it with the
+    /// upa::hash_bytes function and the zero seed. The value is the same on
+    /// all platforms.
+    ///
+    /// @return hash value of the serialized URL
+    [[nodiscard]] std::uint64_t hash_value() const noexcept;
+
+    // Binary record
+
+    /// @brief Appends the binary record of the URL to the @a output
+    ///
+    /// The record contains the serialized URL and the parsed URL's state (offsets
+    /// of the URL parts, flags, host type and path segment count). It is compact,
+    /// versioned and does not depend on the platform's byte order, so it can be
+    /// stored and loaded later with load_record() or from_record() without
+    /// reparsing the URL. The URL must be valid.
+    ///
+    /// @param[in,out] output string to append the record to
+    void serialize_record(std::string& output) const;
+
+    /// @brief Loads the URL from the binary record
+    ///
+    /// The record must be created by the serialize_record(). The URL parser is
+    /// not used: only the record's structure and offsets are validated.
+    ///
+    /// @param[in] record binary record
+    /// @return error code (@a validation_errc::ok on success, @a validation_errc::invalid_record
+    ///   if record is invalid or unsupported; in this case URL is unchanged)
+    validation_errc load_record(std::string_view record);
+
+    /// @brief Creates the URL from the binary record
+    ///
+    /// @param[in] record binary record created by the serialize_record()
+    /// @return URL
+    /// @throws url_error if record is invalid or unsupported
+    /// @see load_record()
+    [[nodiscard]] static url from_record(std::string_view record);
+
 private:
     enum UrlFlag : unsigned {
         // not null flags
@@ -664,6 +972,8 @@ class url {
         // host type
         HOST_TYPE_SHIFT = (PART_COUNT + 2),
         HOST_TYPE_MASK = (7u << HOST_TYPE_SHIFT),
+        // cached hash value
+        HASH_VALUE_FLAG = (1u << (PART_COUNT + 5)),
 
         // initial flags (empty (but not null) parts)
         // https://url.spec.whatwg.org/#url-representation
@@ -685,6 +995,18 @@ class url {
         FRAGMENT_FLAG
     };
 
+    // binary record format version
+    static constexpr std::uint8_t kRecordVersion = 1;
+
+    // checks the flags and the first part_count part end offsets of the
+    // serialized URL str; used by load_record() and url_table::load()
+    static bool is_valid_record(std::string_view str,
+        const std::array<std::size_t, PART_COUNT>& part_end, std::size_t part_count,
+        std::uint64_t flags) noexcept;
+
+    // takes the serialized http(s) URL str_url, if the parser does not change it
+    bool adopt_canonical_http_url(std::string& str_url);
+
     // parsing constructor
     template <class T, enable_if_str_arg_t<T> = 0>
     explicit url(const T& str_url, const url* base, const char* what_arg);
@@ -696,6 +1018,9 @@ class url {
     template <class T, enable_if_str_arg_t<T> = 0>
     validation_errc for_can_parse(const T& str_url, const url* base);
 
+    validation_errc do_parse_request_target(std::string_view scheme, std::string_view host,
+        std::string_view target);
+
     // set scheme
     void set_scheme_str(std::string_view str);
     void set_scheme(const url& src);
@@ -718,12 +1043,17 @@ class url {
 
     void set_host_type(HostType ht) noexcept;
 
+    void clear_hash_value() noexcept;
+
     // info
     bool canHaveUsernamePasswordPort() const;
 
     // url record
     void move_record(url& other) noexcept;
 
+    // origin; parses the blob URL's path into path_url if needed
+    origin_view get_origin_view(url& path_url) const;
+
     // search params
     void clear_search_params() noexcept;
     void parse_search_params();
@@ -734,6 +1064,7 @@ class url {
     const detail::scheme_info* scheme_inf_ = nullptr;
     unsigned flags_ = INITIAL_FLAGS;
     std::size_t path_segment_count_ = 0;
+    std::uint64_t hash_value_ = 0;
     detail::url_search_params_ptr search_params_ptr_;
 
     friend bool operator==(const url& lhs, const url& rhs) noexcept;
@@ -743,6 +1074,9 @@ class url {
     friend class detail::url_setter;
     friend class detail::url_parser;
     friend class url_search_params;
+    friend class url_stream_parser;
+    friend class url_table;
+    friend class url_hasher;
 };
 
 
@@ -758,7 +1092,10 @@ class url_serializer : public host_output {
         : host_output(need_save)
         , url_(dest_url)
         , last_pt_(url::SCHEME)
-    {}
+    {
+        // the URL will be modified, so the cached hash value becomes invalid
+        url_.clear_hash_value();
+    }
 
     ~url_serializer() override = default;
 
@@ -864,7 +1201,9 @@ class url_setter : public url_serializer {
         : url_serializer(dest_url)
         , use_strp_(true)
         , curr_pt_(url::SCHEME)
-    {}
+    {
+        UPA_STATS_INC(setter_calls);
+    }
 
     ~url_setter() override = default;
 
@@ -944,12 +1283,44 @@ class url_parser {
     template <typename CharT>
     static void parse_path(url_serializer& urls, const CharT* first, const CharT* last);
 
+    template <typename CharT>
+    static void make_posix_file_url(url_serializer& urls, const CharT* first, const CharT* last);
+
+    // Component canonicalizers: they append the canonical component to the
+    // output, as the corresponding state with the state override does
+    template <typename CharT>
+    static validation_errc canonicalize_scheme(const CharT* first, const CharT* last, std::string& output);
+
+    template <typename CharT>
+    static validation_errc canonicalize_host(const CharT* first, const CharT* last, bool is_special, std::string& output);
+
+    template <typename CharT>
+    static validation_errc canonicalize_port(const CharT* first, const CharT* last, const scheme_info* scheme_inf, std::string& output);
+
+    template <typename CharT>
+    static void canonicalize_path(const CharT* first, const CharT* last, bool is_special, std::string& output);
+
+    template <typename CharT>
+    static void canonicalize_opaque_path(const CharT* first, const CharT* last, std::string& output);
+
+    template <typename CharT>
+    static void canonicalize_query(const CharT* first, const CharT* last, bool is_special, std::string& output);
+
+    template <typename CharT>
+    static void canonicalize_fragment(const CharT* first, const CharT* last, std::string& output);
+
 private:
     template <typename CharT>
     static void do_path_segment(const CharT* pointer, const CharT* last, std::string& output);
 
     template <typename CharT>
     static void do_opaque_path(const CharT* pointer, const CharT* last, std::string& output);
+
+    template <typename CharT>
+    static void do_query(const CharT* pointer, const CharT* last, const code_point_set& query_cpset, std::string& output);
+
+    template <typename CharT>
+    static void do_fragment(const CharT* pointer, const CharT* last, std::string& output);
 };
 
 
@@ -1003,10 +1374,14 @@ inline void do_remove_whitespace(const CharT*& first, const CharT*& last, simple
     // Fast verification that there's nothing that needs removal. This is the 99%
     // case, so we want it to be fast and don't care about impacting the speed
     // when we do find whitespace.
-    for (auto it = first; it < last; ++it) {
+    const auto* start = util::swar::skip_words(first, last, [](std::uint64_t word) {
+        return util::swar::has_less(word, '\r' + 1) != 0;
+    });
+    for (auto it = start; it < last; ++it) {
         if (!is_removable_char(*it))
             continue;
         // copy non whitespace chars into the new buffer and return it
+        UPA_STATS_INC(whitespace_removals);
         buff.reserve(last - first);
         buff.append(first, it);
         for (; it < last; ++it) {
@@ -1064,6 +1439,86 @@ constexpr bool is_special_authority_end_char(CharT c) noexcept {
     return c == '/' || c == '?' || c == '#' || c == '\\';
 }
 
+// Blob URL's origin
+
+// Returns true if the str is the IPv4 address in the dotted-decimal form,
+// which the IPv4 parser does not change
+inline bool is_canonical_ipv4(std::string_view str) noexcept {
+    std::size_t pos = 0;
+    for (int part = 0; part < 4; ++part) {
+        if (part != 0) {
+            if (pos >= str.length() || str[pos] != '.')
+                return false;
+            ++pos;
+        }
+        const std::size_t start = pos;
+        unsigned value = 0;
+        while (pos < str.length() && pos - start < 3 && is_ascii_digit(str[pos]))
+            value = value * 10 + static_cast<unsigned>(str[pos++] - '0');
+        const std::size_t len = pos - start;
+        if (len == 0 || value > 255 || (len > 1 && str[start] == '0'))
+            return false;
+    }
+    return pos == str.length();
+}
+
+// Gets the origin of the URL string, which starts with the serialized http(s)
+// origin in the form the URL parser does not change (lower case scheme and
+// ASCII host, no default port). Returns opaque origin if it is not the case,
+// even if the parsed URL has the tuple origin.
+inline origin_view canonical_http_origin_view(std::string_view str) noexcept {
+    const std::size_t scheme_len = str.find(':');
+    if (scheme_len == std::string_view::npos)
+        return {};
+    const auto* scheme_inf = get_scheme_info(str.substr(0, scheme_len));
+    if (scheme_inf == nullptr || !scheme_inf->is_http ||
+        str.compare(scheme_len, 3, "://", 3) != 0)
+        return {};
+
+    // host: lower case ASCII letters, digits, '-' and non-consecutive '.'
+    const std::size_t host_pos = scheme_len + 3;
+    std::size_t label_pos = host_pos; // start of the last non-empty label
+    std::size_t pos = host_pos;
+    for (; pos < str.length(); ++pos) {
+        const char c = str[pos];
+        if (c == '.') {
+            if (pos == host_pos || str[pos - 1] == '.')
+                return {};
+        } else if ((c >= 'a' && c <= 'z') || is_ascii_digit(c) || c == '-') {
+            if (pos == host_pos || str[pos - 1] == '.') {
+                // punycode labels must be validated
+                if (str.compare(pos, 4, "xn--", 4) == 0)
+                    return {};
+                label_pos = pos;
+            }
+        } else {
+            break;
+        }
+    }
+    const auto host = str.substr(host_pos, pos - host_pos);
+    if (host.empty())
+        return {};
+    // the host that ends in a number must be the canonical IPv4 address
+    if (is_ascii_digit(str[label_pos]) && !is_canonical_ipv4(host))
+        return {};
+
+    // port: digits without leading zeros, not the default port
+    std::string_view port;
+    if (pos < str.length() && str[pos] == ':') {
+        const std::size_t port_pos = ++pos;
+        long value = 0;
+        while (pos < str.length() && pos - port_pos < 5 && is_ascii_digit(str[pos]))
+            value = value * 10 + (str[pos++] - '0');
+        port = str.substr(port_pos, pos - port_pos);
+        if (port.empty() || value > 0xFFFF || value == scheme_inf->default_port ||
+            (port.length() > 1 && port[0] == '0'))
+            return {};
+    }
+    if (pos < str.length() && !is_special_authority_end_char(str[pos]))
+        return {};
+    return { str.substr(0, scheme_len), host, port };
+}
+
 // Windows drive letter
 
 // https://url.spec.whatwg.org/#windows-drive-letter
@@ -1128,6 +1583,7 @@ inline url::url(url&& other) noexcept
     , scheme_inf_(other.scheme_inf_)
     , flags_(other.flags_)
     , path_segment_count_(other.path_segment_count_)
+    , hash_value_(other.hash_value_)
     , search_params_ptr_(std::move(other.search_params_ptr_))
 {
     search_params_ptr_.set_url_ptr(this);
@@ -1167,6 +1623,7 @@ inline void url::move_record(url& other) noexcept {
     scheme_inf_ = other.scheme_inf_;
     flags_ = other.flags_;
     path_segment_count_ = other.path_segment_count_;
+    hash_value_ = other.hash_value_;
 }
 
 // url getters
@@ -1179,6 +1636,163 @@ inline std::string url::to_string() const {
     return norm_url_;
 }
 
+// Hash
+
+inline void url::cache_hash() noexcept {
+    hash_value_ = hash_bytes(norm_url_);
+    set_flag(HASH_VALUE_FLAG);
+}
+
+inline std::uint64_t url::hash_value() const noexcept {
+    return (flags_ & HASH_VALUE_FLAG) ? hash_value_ : hash_bytes(norm_url_);
+}
+
+// Binary record
+//
+// Format (version 1); integers are unsigned LEB128 varints (see util::append_varint):
+//   version byte (1)
+//   flags (without the cached hash value flag)
+//   path segment count
+//   number N of the stored part end offsets (1..PART_COUNT)
+//   N part end offsets, each as difference from the previous one
+//   serialized URL length and bytes
+// The part end offsets after the first N are zero.
+
+inline void url::serialize_record(std::string& output) const {
+    std::size_t part_count = PART_COUNT;
+    while (part_count > 1 && part_end_[part_count - 1] == 0)
+        --part_count;
+
+    output.push_back(static_cast<char>(kRecordVersion));
+    util::append_varint(output, flags_ & ~HASH_VALUE_FLAG);
+    util::append_varint(output, path_segment_count_);
+    util::append_varint(output, part_count);
+    std::size_t prev_end = 0;
+    for (std::size_t ind = 0; ind < part_count; ++ind) {
+        util::append_varint(output, part_end_[ind] - prev_end);
+        prev_end = part_end_[ind];
+    }
+    util::append_varint(output, norm_url_.length());
+    output.append(norm_url_);
+}
+
+inline bool url::is_valid_record(std::string_view str,
+    const std::array<std::size_t, PART_COUNT>& part_end, std::size_t part_count,
+    std::uint64_t flags) noexcept
+{
+    constexpr std::uint64_t kKnownFlags = HASH_VALUE_FLAG - 1;
+    const std::size_t length = str.length();
+
+    // part end offsets: non-decreasing, the last one is the end of string
+    if (part_count == 0 || part_count > PART_COUNT || part_end[part_count - 1] != length)
+        return false;
+    for (std::size_t ind = 1; ind < part_count; ++ind) {
+        if (part_end[ind] < part_end[ind - 1])
+            return false;
+    }
+
+    // flags: URL must be valid, scheme and path are non-null
+    constexpr std::uint64_t kRequiredFlags = VALID_FLAG | SCHEME_FLAG | USERNAME_FLAG | PASSWORD_FLAG | PATH_FLAG;
+    constexpr std::uint64_t kNoPartFlags = (1u << SCHEME_SEP) | (1u << HOST_START) | (1u << PATH_PREFIX);
+    if ((flags & ~kKnownFlags) != 0 ||
+        (flags & kRequiredFlags) != kRequiredFlags ||
+        (flags & kNoPartFlags) != 0)
+        return false;
+
+    // separators
+    if (part_end[SCHEME] == 0 || part_end[SCHEME] >= length || str[part_end[SCHEME]] != ':')
+        return false;
+    const auto has_separator = [&](PartType t, char c) {
+        return !(flags & (1u << t)) || (t < part_count &&
+            part_end[t - 1] < part_end[t] && str[part_end[t - 1]] == c);
+    };
+    if (!has_separator(PORT, ':') ||
+        !has_separator(QUERY, '?') ||
+        !has_separator(FRAGMENT, '#'))
+        return false;
+
+    // host type
+    const auto host_type = static_cast<unsigned>((flags & HOST_TYPE_MASK) >> HOST_TYPE_SHIFT);
+    if (flags & HOST_FLAG) {
+        const bool empty_host = part_end[HOST] <= part_end[HOST_START];
+        if (HOST >= part_count ||
+            host_type > static_cast<unsigned>(HostType::IPv6) ||
+            empty_host != (host_type == static_cast<unsigned>(HostType::Empty)) ||
+            (!empty_host && (str[part_end[HOST_START]] == '[') !=
+                (host_type == static_cast<unsigned>(HostType::IPv6))))
+            return false;
+    } else if (host_type != 0) {
+        return false;
+    }
+
+    return true;
+}
+
+inline validation_errc url::load_record(std::string_view record) {
+    const char* first = record.data();
+    const char* last = first + record.length();
+
+    if (first == last || static_cast<std::uint8_t>(*first++) != kRecordVersion)
+        return validation_errc::invalid_record;
+
+    std::uint64_t flags = 0;
+    std::uint64_t path_segment_count = 0;
+    std::uint64_t part_count = 0;
+    if (!util::read_varint(first, last, flags) ||
+        !util::read_varint(first, last, path_segment_count) ||
+        !util::read_varint(first, last, part_count) ||
+        part_count == 0 || part_count > PART_COUNT)
+        return validation_errc::invalid_record;
+
+    // part end offsets (non-decreasing, as differences are stored)
+    std::array<std::size_t, PART_COUNT> part_end{};
+    std::uint64_t end = 0;
+    for (std::size_t ind = 0; ind < part_count; ++ind) {
+        std::uint64_t delta = 0;
+        if (!util::read_varint(first, last, delta) || delta > static_cast<std::uint64_t>(last - first))
+            return validation_errc::invalid_record;
+        end += delta;
+        part_end[ind] = static_cast<std::size_t>(end);
+    }
+    std::uint64_t length = 0;
+    if (!util::read_varint(first, last, length) ||
+        length != static_cast<std::uint64_t>(last - first) ||
+        end != length)
+        return validation_errc::invalid_record;
+    const std::string_view str{ first, static_cast<std::size_t>(length) };
+
+    if (!is_valid_record(str, part_end, static_cast<std::size_t>(part_count), flags))
+        return validation_errc::invalid_record;
+
+    // path segment count
+    if (flags & OPAQUE_PATH_FLAG) {
+        if (path_segment_count != 0)
+            return validation_errc::invalid_record;
+    } else {
+        const auto b = part_end[PATH - 1];
+        const auto e = std::max(part_end[PATH], b);
+        if (path_segment_count != static_cast<std::uint64_t>(
+            std::count(str.data() + b, str.data() + e, '/')))
+            return validation_errc::invalid_record;
+    }
+
+    // the record is valid
+    norm_url_.assign(str);
+    part_end_ = part_end;
+    flags_ = static_cast<unsigned>(flags);
+    path_segment_count_ = static_cast<std::size_t>(path_segment_count);
+    scheme_inf_ = detail::get_scheme_info(get_part_view(SCHEME));
+    parse_search_params();
+    return validation_errc::ok;
+}
+
+inline url url::from_record(std::string_view record) {
+    url u;
+    if (u.load_record(record) != validation_errc::ok)
+        throw url_error(validation_errc::invalid_record, "Invalid URL record");
+    return u;
+}
+
 // Origin
 // https://url.spec.whatwg.org/#concept-url-origin
 
@@ -1201,6 +1815,42 @@ inline std::string url::origin() const {
     return "null"; // opaque origin
 }
 
+inline origin_view url::get_origin_view() const UPA_LIFETIMEBOUND {
+    if (is_special_scheme()) {
+        if (!is_file_scheme())
+            return { get_part_view(SCHEME), get_part_view(HOST), get_part_view(PORT) };
+    } else if (get_part_view(SCHEME) == std::string_view{ "blob", 4 }) {
+        // See url::origin(). The returned view must refer to this URL, so the
+        // path must start with the serialized origin of the path URL.
+        return detail::canonical_http_origin_view(get_part_view(PATH));
+    }
+    return {}; // opaque origin
+}
+
+inline origin_view url::get_origin_view(url& path_url) const {
+    const auto origin = get_origin_view();
+    if (origin.is_opaque() && !is_special_scheme() &&
+        get_part_view(SCHEME) == std::string_view{ "blob", 4 }) {
+        // The path of the blob URL is not the canonical origin
+        if (path_url.parse(get_part_view(PATH)) == validation_errc::ok &&
+            path_url.is_http_scheme())
+            return path_url.get_origin_view();
+    }
+    return origin;
+}
+
+inline bool url::same_origin(const url& other) const {
+    const auto origin1 = get_origin_view();
+    const auto origin2 = other.get_origin_view();
+    if (!origin1.is_opaque() && !origin2.is_opaque())
+        return origin1 == origin2;
+    // Slow path for blob URLs with non-canonical origin in the path
+    url path_url1, path_url2;
+    const auto full_origin1 = origin1.is_opaque() ? get_origin_view(path_url1) : origin1;
+    return !full_origin1.is_opaque() &&
+        full_origin1 == (origin2.is_opaque() ? other.get_origin_view(path_url2) : origin2);
+}
+
 inline std::string url::origin_of_special_url() const {
     // "scheme://"
     std::string str_origin(norm_url_, 0, part_end_[SCHEME_SEP]);
@@ -1269,6 +1919,12 @@ inline std::string_view url::pathname() const UPA_LIFETIMEBOUND {
     return get_part_view(PATH);
 }
 
+inline path_segments_view url::path_segments() const noexcept UPA_LIFETIMEBOUND {
+    if (has_opaque_path())
+        return {};
+    return { get_part_view(PATH), path_segment_count_ };
+}
+
 inline std::string_view url::search() const UPA_LIFETIMEBOUND {
     const std::size_t b = part_end_[QUERY - 1];
     const std::size_t e = part_end_[QUERY];
@@ -1407,6 +2063,10 @@ inline void url::set_host_type(const HostType ht) noexcept {
     flags_ = (flags_ & ~HOST_TYPE_MASK) | HOST_FLAG | (static_cast<unsigned int>(ht) << HOST_TYPE_SHIFT);
 }
 
+inline void url::clear_hash_value() noexcept {
+    flags_ &= ~HASH_VALUE_FLAG;
+}
+
 inline bool url::canHaveUsernamePasswordPort() const {
     return is_valid() && !(is_empty(url::HOST) || is_file_scheme());
 }
@@ -1440,12 +2100,21 @@ inline void url::swap(url& other) noexcept {
 
 // Parser
 
+inline validation_errc url::parse(std::string&& str_url, const url* base) {
+    if ((base == nullptr || base->is_valid()) && adopt_canonical_http_url(str_url))
+        return validation_errc::ok;
+    return do_parse(str_url.data(), str_url.data() + str_url.length(), base);
+}
+
 // Implements "basic URL parser" https://url.spec.whatwg.org/#concept-basic-url-parser
 // without encoding, url and state override parameters. It resets this url object to
 // an empty value and then parses the input and modifies this url object.
 // Returns validation_errc::ok on success, or an error value on parsing failure.
 template <typename CharT>
 inline validation_errc url::do_parse(const CharT* first, const CharT* last, const url* base) {
+    UPA_STATS_INC(urls_parsed);
+    UPA_STATS_ADD(bytes_parsed, static_cast<std::uint64_t>(last - first));
+
     const validation_errc res = [&]() {
         detail::url_serializer urls(*this);
 
@@ -1495,6 +2164,121 @@ validation_errc url::for_can_parse(const T& str_url, const url* base) {
     return res;
 }
 
+// HTTP request-target parser
+// https://www.rfc-editor.org/rfc/rfc9112#section-3.3
+
+inline validation_errc url::parse_request_target(std::string_view scheme, std::string_view host,
+    std::string_view target)
+{
+    if (target.empty() || target[0] != '/') {
+        // absolute-form: the Host header field is ignored
+        if (target != std::string_view{ "*", 1 })
+            return parse(target, nullptr);
+        // asterisk-form: the target URI has the empty path and query
+        target = {};
+    }
+    return do_parse_request_target(scheme, host, target);
+}
+
+inline validation_errc url::parse_authority_target(std::string_view scheme, std::string_view authority) {
+    return do_parse_request_target(scheme, authority, {});
+}
+
+inline url url::from_request_target(std::string_view scheme, std::string_view host,
+    std::string_view target)
+{
+    url u;
+    const auto res = u.parse_request_target(scheme, host, target);
+    if (res != validation_errc::ok)
+        throw url_error(res, detail::kURLParseError);
+    return u;
+}
+
+inline url url::from_authority_target(std::string_view scheme, std::string_view authority) {
+    url u;
+    const auto res = u.parse_authority_target(scheme, authority);
+    if (res != validation_errc::ok)
+        throw url_error(res, detail::kURLParseError);
+    return u;
+}
+
+// Makes the URL of the scheme, host and origin-form request-target (or the
+// empty target). Each piece is parsed by the url_parser state, which parses
+// the corresponding URL part, so they are serialized directly to norm_url_.
+inline validation_errc url::do_parse_request_target(std::string_view scheme, std::string_view host,
+    std::string_view target)
+{
+    UPA_STATS_INC(urls_parsed);
+    UPA_STATS_ADD(bytes_parsed, static_cast<std::uint64_t>(
+        scheme.length() + host.length() + target.length()));
+
+    const validation_errc res = [&]() {
+        detail::url_serializer urls(*this);
+
+        // reset URL
+        urls.new_url();
+        // reserve size for the whole URL: url_parse reserves the size of
+        // the input piece plus 32
+        urls.reserve(scheme.length() + host.length() + target.length() + 32);
+
+        // scheme
+        if (scheme.empty() || !detail::is_first_scheme_char(scheme[0]) ||
+            !std::all_of(scheme.begin() + 1, scheme.end(), detail::is_scheme_char<char>))
+            return validation_errc::scheme_invalid_code_point;
+        std::string& str_scheme = urls.start_scheme();
+        for (const char c : scheme)
+            str_scheme.push_back(static_cast<char>(c | 0x20));
+        urls.save_scheme();
+
+        // host and port: the host state with state override stops at the
+        // end of authority or port, so check the rest isn't there
+        if (host.find_first_of("/\\?#") != std::string_view::npos)
+            return validation_errc::host_invalid_code_point;
+        const auto colon_pos = host.rfind(':');
+        if (colon_pos != std::string_view::npos && (host.rfind(']') == std::string_view::npos ||
+            host.rfind(']') < colon_pos)) {
+            const auto port = host.substr(colon_pos + 1);
+            if (!std::all_of(port.begin(), port.end(), detail::is_ascii_digit<char>))
+                return validation_errc::port_invalid;
+            // the empty port is allowed as in the "http://host:/" URL
+            if (port.empty() && !urls.is_file_scheme())
+                host.remove_suffix(1);
+        }
+        auto res = detail::url_parser::url_parse(urls, host.data(), host.data() + host.length(),
+            nullptr, detail::url_parser::host_state);
+        if (res != validation_errc::ok)
+            return res;
+
+        // path
+        const auto end_of_path = std::min(target.find_first_of("?#"), target.length());
+        res = detail::url_parser::url_parse(urls, target.data(), target.data() + end_of_path,
+            nullptr, detail::url_parser::path_start_state);
+        if (res != validation_errc::ok || end_of_path == target.length())
+            return res;
+
+        // query
+        auto pointer = target.data() + end_of_path + 1;
+        const auto* last = target.data() + target.length();
+        if (target[end_of_path] == '?') {
+            const auto* end_of_query = std::find(pointer, last, '#');
+            res = detail::url_parser::url_parse(urls, pointer, end_of_query,
+                nullptr, detail::url_parser::query_state);
+            if (res != validation_errc::ok || end_of_query == last)
+                return res;
+            pointer = end_of_query + 1;
+        }
+
+        // fragment
+        return detail::url_parser::url_parse(urls, pointer, last,
+            nullptr, detail::url_parser::fragment_state);
+    }();
+    if (res == validation_errc::ok) {
+        set_flag(VALID_FLAG);
+        parse_search_params();
+    }
+    return res;
+}
+
 // Setters
 
 template <class StrT, enable_if_str_arg_t<StrT>>
@@ -1529,6 +2313,7 @@ inline bool url::username(const StrT& str) {
 
         std::string& str_username = urls.start_part(url::USERNAME);
         // UTF-8 percent encode it using the userinfo encode set
+        UPA_STATS_COMPONENT(pct_encoded_userinfo);
         detail::append_utf8_percent_encoded(inp.begin(), inp.end(), userinfo_no_encode_set, str_username);
         urls.save_part();
         return true;
@@ -1545,6 +2330,7 @@ inline bool url::password(const StrT& str) {
 
         std::string& str_password = urls.start_part(url::PASSWORD);
         // UTF-8 percent encode it using the userinfo encode set
+        UPA_STATS_COMPONENT(pct_encoded_userinfo);
         detail::append_utf8_percent_encoded(inp.begin(), inp.end(), userinfo_no_encode_set, str_password);
         urls.save_part();
         return true;
@@ -1657,8 +2443,6 @@ namespace detail {
 template <typename CharT>
 inline validation_errc url_parser::url_parse(url_serializer& urls, const CharT* first, const CharT* last, const url* base, State state_override)
 {
-    using UCharT = std::make_unsigned_t<CharT>;
-
     // remove all ASCII tab or newline from URL
     simple_buffer<CharT> buff_no_ws;
     detail::do_remove_whitespace(first, last, buff_no_ws);
@@ -1924,6 +2708,7 @@ inline validation_errc url_parser::url_parse(url_serializer& urls, const CharT*
             }
             //TODO-WARN: validation error
             if (urls.need_save()) {
+                UPA_STATS_COMPONENT(pct_encoded_userinfo);
                 const auto it_colon = std::find(pointer, it_eta, ':');
                 // url includes credentials?
                 const bool not_empty_password = std::distance(it_colon, it_eta) > 1;
@@ -2262,8 +3047,11 @@ inline validation_errc url_parser::url_parse(url_serializer& urls, const CharT*
     }
 
     if (state == opaque_path_state) {
-        const auto end_of_path =
-            std::find_if(pointer, last, [](CharT c) { return c == '?' || c == '#'; });
+        const auto end_of_path = std::find_if(
+            util::swar::skip_words(pointer, last, [](std::uint64_t word) {
+                return (util::swar::has_byte(word, '?') | util::swar::has_byte(word, '#')) != 0;
+            }),
+            last, [](CharT c) { return c == '?' || c == '#'; });
 
         // UTF-8 percent encode using the C0 control percent-encode set,
         // and append the result to url's path string
@@ -2312,28 +3100,7 @@ inline validation_errc url_parser::url_parse(url_serializer& urls, const CharT*
         // the result to url’s query.
         // TODO: now supports UTF-8 encoding only, maybe later add other encodings
         std::string& str_query = urls.start_part(url::QUERY);
-        // detail::append_utf8_percent_encoded(pointer, end_of_query, query_cpset, str_query);
-        while (pointer != end_of_query) {
-            // UTF-8 percent encode c using the fragment percent-encode set
-            // and ignore '\0'
-            const auto uch = static_cast<UCharT>(*pointer);
-            if (uch >= 0x80) {
-                // invalid utf-8/16/32 sequences will be replaced with kUnicodeReplacementCharacter
-                detail::append_utf8_percent_encoded_char(pointer, end_of_query, str_query);
-            } else {
-                // Just append the 7-bit character, possibly percent encoding it
-                const auto uc = static_cast<unsigned char>(uch);
-                if (!detail::is_char_in_set(uc, query_cpset))
-                    detail::append_percent_encoded_byte(uc, str_query);
-                else
-                    str_query.push_back(uc);
-                ++pointer;
-            }
-            // TODO-WARN:
-            // If c is not a URL code point and not "%", validation error.
-            // If c is "%" and remaining does not start with two ASCII hex digits, validation error.
-            // Let bytes be the result of encoding c using encoding ...
-        }
+        do_query(pointer, end_of_query, query_cpset, str_query);
         urls.save_part();
         urls.set_flag(url::QUERY_FLAG);
 
@@ -2349,27 +3116,7 @@ inline validation_errc url_parser::url_parse(url_serializer& urls, const CharT*
     if (state == fragment_state) {
         // https://url.spec.whatwg.org/#fragment-state
         std::string& str_frag = urls.start_part(url::FRAGMENT);
-        while (pointer < last) {
-            // UTF-8 percent encode c using the fragment percent-encode set
-            const auto uch = static_cast<UCharT>(*pointer);
-            if (uch >= 0x80) {
-                // invalid utf-8/16/32 sequences will be replaced with kUnicodeReplacementCharacter
-                detail::append_utf8_percent_encoded_char(pointer, last, str_frag);
-            } else {
-                // Just append the 7-bit character, possibly percent encoding it
-                const auto uc = static_cast<unsigned char>(uch);
-                if (detail::is_char_in_set(uc, fragment_no_encode_set)) {
-                    str_frag.push_back(uc);
-                } else {
-                    // other characters are percent encoded
-                    detail::append_percent_encoded_byte(uc, str_frag);
-                }
-                ++pointer;
-            }
-            // TODO-WARN:
-            // If c is not a URL code point and not "%", validation error.
-            // If c is "%" and remaining does not start with two ASCII hex digits, validation error.
-        }
+        do_fragment(pointer, last, str_frag);
         urls.save_part();
         urls.set_flag(url::FRAGMENT_FLAG);
     }
@@ -2384,35 +3131,43 @@ inline validation_errc url_parser::parse_host(url_serializer& urls, const CharT*
     return host_parser::parse_host(first, last, !urls.is_special_scheme(), urls);
 }
 
+// Dot path segments
+
+template <typename CharT>
+constexpr bool is_escaped_dot(const CharT* const pointer) noexcept {
+    // "%2e" or "%2E"
+    return pointer[0] == '%' && pointer[1] == '2' && (pointer[2] | 0x20) == 'e';
+}
+
+template <typename CharT>
+constexpr bool is_double_dot_segment(const CharT* const pointer, const std::size_t len) noexcept {
+    switch (len) {
+    case 2: // ".."
+        return pointer[0] == '.' && pointer[1] == '.';
+    case 4: // ".%2e" or "%2e."
+        return (pointer[0] == '.' && is_escaped_dot(pointer + 1)) ||
+            (is_escaped_dot(pointer) && pointer[3] == '.');
+    case 6: // "%2e%2e"
+        return is_escaped_dot(pointer) && is_escaped_dot(pointer + 3);
+    default:
+        return false;
+    }
+}
+
+template <typename CharT>
+constexpr bool is_single_dot_segment(const CharT* const pointer, const std::size_t len) noexcept {
+    switch (len) {
+    case 1: return pointer[0] == '.';
+    case 3: return is_escaped_dot(pointer); // "%2e"
+    default: return false;
+    }
+}
+
 template <typename CharT>
 inline void url_parser::parse_path(url_serializer& urls, const CharT* first, const CharT* last) {
     // path state; includes:
     // 1. [ (/,\) - 1, 2, 3, 4 - [ 1 (if first segment), 2 ] ]
     // 2. [ 1 ... 4 ]
-    static constexpr auto escaped_dot = [](const CharT* const pointer) constexpr -> bool {
-        // "%2e" or "%2E"
-        return pointer[0] == '%' && pointer[1] == '2' && (pointer[2] | 0x20) == 'e';
-    };
-    static constexpr auto double_dot = [](const CharT* const pointer, const std::size_t len) constexpr -> bool {
-        switch (len) {
-        case 2: // ".."
-            return pointer[0] == '.' && pointer[1] == '.';
-        case 4: // ".%2e" or "%2e."
-            return (pointer[0] == '.' && escaped_dot(pointer + 1)) ||
-                (escaped_dot(pointer) && pointer[3] == '.');
-        case 6: // "%2e%2e"
-            return escaped_dot(pointer) && escaped_dot(pointer + 3);
-        default:
-            return false;
-        }
-    };
-    static constexpr auto single_dot = [](const CharT* const pointer, const std::size_t len) constexpr -> bool {
-        switch (len) {
-        case 1: return pointer[0] == '.';
-        case 3: return escaped_dot(pointer); // "%2e"
-        default: return false;
-        }
-    };
 
     // parse path's segments
     auto pointer = first;
@@ -2426,10 +3181,10 @@ inline void url_parser::parse_path(url_serializer& urls, const CharT* first, con
         const bool is_last = end_of_segment == last;
         // TODO-WARN: 1. If url is special and c is "\", validation error.
 
-        if (double_dot(pointer, len)) {
+        if (is_double_dot_segment(pointer, len)) {
             urls.shorten_path();
             if (is_last) urls.append_empty_path_segment();
-        } else if (single_dot(pointer, len)) {
+        } else if (is_single_dot_segment(pointer, len)) {
             if (is_last) urls.append_empty_path_segment();
         } else {
             if (len == 2 &&
@@ -2461,6 +3216,7 @@ template <typename CharT>
 inline void url_parser::do_path_segment(const CharT* pointer, const CharT* last, std::string& output) {
     using UCharT = std::make_unsigned_t<CharT>;
 
+    UPA_STATS_COMPONENT(pct_encoded_path);
     // TODO-WARN: 2. [ 1 ... 2 ] validation error.
     while (pointer < last) {
         // UTF-8 percent encode c using the default encode set
@@ -2490,12 +3246,32 @@ inline void url_parser::do_opaque_path(const CharT* pointer, const CharT* last,
     //  2. If c is "%" and remaining does not start with two ASCII hex digits, validation error.
 
     if (pointer != last) {
+        UPA_STATS_COMPONENT(pct_encoded_path);
         // If path ends with a space, the space is percent encoded and appended
         // to the output at the end of processing.
         const bool ends_with_space = *(last - 1) == ' ';
         if (ends_with_space)
             --last;
+        // Opaque paths can be very long (e.g. data: URLs), and mostly consist of
+        // characters which are not percent encoded
+        util::reserve(output, output.size() + static_cast<std::size_t>(last - pointer) + 3);
         while (pointer < last) {
+            // Append the run of characters which are not percent encoded at once
+            const auto* end_of_run = std::find_if(
+                util::swar::skip_words(pointer, last, [](std::uint64_t word) {
+                    return (util::swar::has_less(word, 0x20) | util::swar::has_more(word, 0x7e)) != 0;
+                }),
+                last, [](CharT c) {
+                    const auto uc = static_cast<UCharT>(c);
+                    return uc <= 0x1f || uc >= 0x7f;
+                });
+            if (end_of_run != pointer) {
+                util::append(output, std::basic_string_view<CharT>(pointer,
+                    static_cast<std::size_t>(end_of_run - pointer)));
+                pointer = end_of_run;
+                if (pointer == last)
+                    break;
+            }
             // UTF-8 percent encode c using the C0 control percent-encode set (U+0000 ... U+001F and >U+007E)
             const auto uch = static_cast<UCharT>(*pointer);
             if (uch >= 0x7f) {
@@ -2512,14 +3288,375 @@ inline void url_parser::do_opaque_path(const CharT* pointer, const CharT* last,
             }
         }
         // %20 - percent encoded space
-        if (ends_with_space)
+        if (ends_with_space) {
             output.append("%20");
+            UPA_STATS_INC(pct_encoded_path);
+        }
+    }
+}
+
+template <typename CharT>
+inline void url_parser::do_query(const CharT* pointer, const CharT* last, const code_point_set& query_cpset, std::string& output) {
+    using UCharT = std::make_unsigned_t<CharT>;
+
+    UPA_STATS_COMPONENT(pct_encoded_query);
+    // detail::append_utf8_percent_encoded(pointer, last, query_cpset, output);
+    while (pointer != last) {
+        // UTF-8 percent encode c using the query_cpset
+        const auto uch = static_cast<UCharT>(*pointer);
+        if (uch >= 0x80) {
+            // invalid utf-8/16/32 sequences will be replaced with kUnicodeReplacementCharacter
+            detail::append_utf8_percent_encoded_char(pointer, last, output);
+        } else {
+            // Just append the 7-bit character, possibly percent encoding it
+            const auto uc = static_cast<unsigned char>(uch);
+            if (!detail::is_char_in_set(uc, query_cpset))
+                detail::append_percent_encoded_byte(uc, output);
+            else
+                output.push_back(uc);
+            ++pointer;
+        }
+        // TODO-WARN:
+        // If c is not a URL code point and not "%", validation error.
+        // If c is "%" and remaining does not start with two ASCII hex digits, validation error.
+        // Let bytes be the result of encoding c using encoding ...
+    }
+}
+
+template <typename CharT>
+inline void url_parser::do_fragment(const CharT* pointer, const CharT* last, std::string& output) {
+    using UCharT = std::make_unsigned_t<CharT>;
+
+    UPA_STATS_COMPONENT(pct_encoded_fragment);
+    while (pointer < last) {
+        // UTF-8 percent encode c using the fragment percent-encode set
+        const auto uch = static_cast<UCharT>(*pointer);
+        if (uch >= 0x80) {
+            // invalid utf-8/16/32 sequences will be replaced with kUnicodeReplacementCharacter
+            detail::append_utf8_percent_encoded_char(pointer, last, output);
+        } else {
+            // Just append the 7-bit character, possibly percent encoding it
+            const auto uc = static_cast<unsigned char>(uch);
+            if (detail::is_char_in_set(uc, fragment_no_encode_set)) {
+                output.push_back(uc);
+            } else {
+                // other characters are percent encoded
+                detail::append_percent_encoded_byte(uc, output);
+            }
+            ++pointer;
+        }
+        // TODO-WARN:
+        // If c is not a URL code point and not "%", validation error.
+        // If c is "%" and remaining does not start with two ASCII hex digits, validation error.
+    }
+}
+
+// Component canonicalizers
+//
+// They do the same as the basic URL parser with the state override, but the
+// result is appended to the output string instead of the URL record, so no
+// dummy URL is needed.
+
+// Host output to the string
+class string_host_output : public host_output {
+public:
+    explicit string_host_output(std::string& output) noexcept
+        : output_(output)
+    {}
+    std::string& hostStart() override {
+        return output_;
+    }
+    void hostDone(HostType /*ht*/) override {}
+private:
+    std::string& output_; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+};
+
+// scheme state with the state override
+template <typename CharT>
+inline validation_errc url_parser::canonicalize_scheme(const CharT* first, const CharT* last, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    if (first == last || !detail::is_first_scheme_char(*first))
+        return validation_errc::scheme_invalid_code_point;
+
+    // the scheme ends with ':' or EOF
+    const auto end_of_scheme = std::find_if_not(first + 1, last, detail::is_scheme_char<CharT>);
+    if (end_of_scheme != last && *end_of_scheme != ':')
+        return validation_errc::scheme_invalid_code_point;
+
+    // lowercase ASCII alphas, see the scheme_state in the url_parse
+    for (auto it = first; it != end_of_scheme; ++it)
+        output.push_back(static_cast<char>(*it | 0x20));
+    return validation_errc::ok;
+}
+
+// hostname state with the state override
+template <typename CharT>
+inline validation_errc url_parser::canonicalize_host(const CharT* first, const CharT* last, bool is_special, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    const auto end_of_authority = is_special ?
+        std::find_if(first, last, detail::is_special_authority_end_char<CharT>) :
+        std::find_if(first, last, detail::is_authority_end_char<CharT>);
+
+    // the host with port is not accepted
+    bool in_square_brackets = false; // [] flag
+    for (auto it = first; it != end_of_authority; ++it) {
+        const CharT ch = *it;
+        if (ch == ':') {
+            if (!in_square_brackets)
+                return is_special
+                    ? validation_errc::domain_invalid_code_point
+                    : validation_errc::host_invalid_code_point;
+        } else if (ch == '[') {
+            in_square_brackets = true;
+        } else if (ch == ']') {
+            in_square_brackets = false;
+        }
+    }
+
+    const auto length = output.length();
+    string_host_output dest(output);
+    const auto res = host_parser::parse_host(first, end_of_authority, !is_special, dest);
+    if (res != validation_errc::ok)
+        output.resize(length);
+    return res;
+}
+
+// port state with the state override
+template <typename CharT>
+inline validation_errc url_parser::canonicalize_port(const CharT* first, const CharT* last, const scheme_info* scheme_inf, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    // the port ends with the first non digit
+    const auto end_of_digits = std::find_if_not(first, last, detail::is_ascii_digit<CharT>);
+    if (first == end_of_digits)
+        return validation_errc::port_invalid;
+
+    // skip the leading zeros except the last
+    first = std::find_if(first, end_of_digits - 1, [](CharT c) { return c != '0'; });
+    // check port <= 65535 (0xFFFF)
+    if (std::distance(first, end_of_digits) > 5)
+        return validation_errc::port_out_of_range;
+    int port = 0;
+    for (auto it = first; it < end_of_digits; ++it)
+        port = port * 10 + (*it - '0');
+    if (port > 0xFFFF)
+        return validation_errc::port_out_of_range;
+
+    // the default port of the scheme is the empty string
+    if (scheme_inf == nullptr || scheme_inf->default_port != port)
+        util::append(output, str_arg<CharT>{ first, end_of_digits });
+    return validation_errc::ok;
+}
+
+// path start state with the state override, for the non-file URL without
+// host; each path segment is appended with the leading '/'
+template <typename CharT>
+inline void url_parser::canonicalize_path(const CharT* first, const CharT* last, bool is_special, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    const auto path_start = output.length();
+    auto pointer = first;
+    if (pointer != last && (*pointer == '/' || (is_special && *pointer == '\\')))
+        ++pointer;
+
+    // path state
+    while (true) {
+        const auto end_of_segment = is_special
+            ? std::find_if(pointer, last, detail::is_slash<CharT>)
+            : std::find(pointer, last, '/');
+
+        // end_of_segment >= pointer
+        const std::size_t len = end_of_segment - pointer;
+        const bool is_last = end_of_segment == last;
+
+        if (is_double_dot_segment(pointer, len)) {
+            // shorten path
+            const auto pos = output.rfind('/');
+            if (pos != std::string::npos && pos >= path_start)
+                output.resize(pos);
+            if (is_last) output.push_back('/');
+        } else if (is_single_dot_segment(pointer, len)) {
+            if (is_last) output.push_back('/');
+        } else {
+            output.push_back('/');
+            do_path_segment(pointer, end_of_segment, output);
+        }
+        // next segment
+        if (is_last) break;
+        pointer = end_of_segment + 1; // skip '/' or '\'
+    }
+}
+
+// opaque path state with the state override
+template <typename CharT>
+inline void url_parser::canonicalize_opaque_path(const CharT* first, const CharT* last, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    const auto end_of_path =
+        std::find_if(first, last, [](CharT c) { return c == '?' || c == '#'; });
+    do_opaque_path(first, end_of_path, output);
+}
+
+// query state with the state override
+template <typename CharT>
+inline void url_parser::canonicalize_query(const CharT* first, const CharT* last, bool is_special, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    do_query(first, last, is_special ? special_query_no_encode_set : query_no_encode_set, output);
+}
+
+// fragment state with the state override
+template <typename CharT>
+inline void url_parser::canonicalize_fragment(const CharT* first, const CharT* last, std::string& output) {
+    // remove all ASCII tab or newline
+    simple_buffer<CharT> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    do_fragment(first, last, output);
+}
+
+// Makes the file URL of the absolute POSIX path, which has no ".." segments
+// and null characters. The path segments are percent-encoded using the
+// posix_path_no_encode_set directly into the URL, so the result is the same
+// as parsing "file://" + the percent-encoded path, but without the parsing.
+template <typename CharT>
+inline void url_parser::make_posix_file_url(url_serializer& urls, const CharT* first, const CharT* last) {
+    assert(first != last && is_posix_slash(*first));
+
+    urls.new_url();
+    urls.reserve(static_cast<std::size_t>(last - first) + 32);
+
+    // "file:" and the empty host
+    std::string& str_scheme = urls.start_scheme();
+    str_scheme.append("file", 4);
+    urls.save_scheme();
+    urls.set_empty_host();
+
+    // path
+    const auto* pointer = first;
+    while (pointer != last) {
+        ++pointer; // skip '/'
+        const auto* end_of_segment = std::find_if(pointer, last, is_posix_slash<CharT>);
+        if (end_of_segment - pointer == 1 && *pointer == '.') {
+            // the single-dot segment is removed, but if it is the last
+            // segment, then the empty string is appended to the path
+            if (end_of_segment == last)
+                urls.append_empty_path_segment();
+        } else {
+            std::string& str_path = urls.start_path_segment();
+            UPA_STATS_COMPONENT(pct_encoded_path);
+            append_utf8_percent_encoded(pointer, end_of_segment, posix_path_no_encode_set, str_path);
+            urls.save_path_segment();
+        }
+        pointer = end_of_segment;
     }
+    urls.commit_path();
+    urls.set_flag(url::VALID_FLAG);
 }
 
 } // namespace detail
 
 
+// Canonical http(s) URL
+//
+// The serialized http(s) URL, which the URL parser does not change, is the
+// canonical origin (see detail::canonical_http_origin_view) followed by the
+// non-empty path without dot segments and '\', the optional query and the
+// optional fragment, whose characters are not in the percent-encode sets.
+
+inline bool url::adopt_canonical_http_url(std::string& str_url) {
+    const std::string_view str{ str_url };
+    const auto origin = detail::canonical_http_origin_view(str);
+    if (origin.is_opaque())
+        return false;
+    const std::size_t host_start = origin.scheme().length() + 3; // "://"
+    const std::size_t host_end = host_start + origin.host().length();
+    const std::size_t port_end = origin.port().empty()
+        ? host_end : host_end + 1 + origin.port().length();
+
+    const auto scan = [&](std::size_t pos, const code_point_set& no_encode_set) {
+        while (pos < str.length() && detail::is_char_in_set(
+            static_cast<unsigned char>(str[pos]), no_encode_set))
+            ++pos;
+        return pos;
+    };
+
+    // path
+    std::size_t pos = port_end;
+    std::size_t path_segment_count = 0;
+    if (pos >= str.length() || str[pos] != '/')
+        return false;
+    while (pos < str.length() && str[pos] == '/') {
+        const std::size_t start = ++pos;
+        while (pos < str.length() && str[pos] != '/' && str[pos] != '\\' &&
+            detail::is_char_in_set(static_cast<unsigned char>(str[pos]), path_no_encode_set))
+            ++pos;
+        const char* segment = str.data() + start;
+        if (detail::is_single_dot_segment(segment, pos - start) ||
+            detail::is_double_dot_segment(segment, pos - start))
+            return false;
+        ++path_segment_count;
+    }
+    const std::size_t path_end = pos;
+    // query
+    const bool has_query = pos < str.length() && str[pos] == '?';
+    if (has_query)
+        pos = scan(pos + 1, special_query_no_encode_set);
+    const std::size_t query_end = pos;
+    // fragment
+    const bool has_fragment = pos < str.length() && str[pos] == '#';
+    if (has_fragment)
+        pos = scan(pos + 1, fragment_no_encode_set);
+    if (pos != str.length())
+        return false;
+
+    UPA_STATS_INC(urls_parsed);
+    UPA_STATS_ADD(bytes_parsed, static_cast<std::uint64_t>(str.length()));
+
+    // the URL parts; see detail::url_serializer::start_part
+    clear();
+    part_end_[SCHEME] = origin.scheme().length();
+    part_end_[SCHEME_SEP] = host_start;
+    part_end_[USERNAME] = host_start;
+    part_end_[PASSWORD] = host_start;
+    part_end_[HOST_START] = host_start;
+    part_end_[HOST] = host_end;
+    part_end_[PORT] = port_end;
+    part_end_[PATH_PREFIX] = port_end;
+    part_end_[PATH] = path_end;
+    if (has_query || has_fragment)
+        part_end_[QUERY] = query_end;
+    if (has_fragment)
+        part_end_[FRAGMENT] = pos;
+    set_host_type(detail::is_canonical_ipv4(origin.host()) ? HostType::IPv4 : HostType::Domain);
+    if (!origin.port().empty())
+        set_flag(PORT_FLAG);
+    if (has_query)
+        set_flag(QUERY_FLAG);
+    if (has_fragment)
+        set_flag(FRAGMENT_FLAG);
+    set_flag(VALID_FLAG);
+    path_segment_count_ = path_segment_count;
+    scheme_inf_ = detail::get_scheme_info(origin.scheme());
+    norm_url_.swap(str_url);
+    parse_search_params();
+    return true;
+}
+
 // path util
 
 inline std::string_view url::get_path_first_string(std::size_t len) const UPA_LIFETIMEBOUND {
@@ -2564,7 +3701,10 @@ inline bool url::get_shorten_path(std::size_t& path_end, std::size_t& path_segme
             return false;
     }
     // Remove path's last item
-    return get_path_rem_last(path_end, path_segment_count);
+    if (!get_path_rem_last(path_end, path_segment_count))
+        return false;
+    UPA_STATS_INC(path_shortenings);
+    return true;
 }
 
 
@@ -2995,9 +4135,11 @@ inline void url_setter::shorten_path() {
             return;
         path_seg_end_.pop_back();
         strp_.clear();
+        UPA_STATS_INC(path_shortenings);
     } else if (path_seg_end_.size() >= 2) {
         path_seg_end_.pop_back();
         strp_.resize(path_seg_end_.back());
+        UPA_STATS_INC(path_shortenings);
     }
 }
 
@@ -3142,6 +4284,87 @@ inline std::ostream& operator<<(std::ostream& os, const url& url) {
     return os << url.norm_url_;
 }
 
+/// @brief URL hasher
+///
+/// Computes seeded 64-bit hash values of the URL and its components with the
+/// upa::hash_bytes function. The values are the same on all platforms and
+/// standard libraries, so they can be used to distribute URLs across nodes.
+///
+/// Can be used as a hash function object of unordered containers, for example
+/// `std::unordered_set<upa::url, upa::url_hasher>`.
+class url_hasher {
+public:
+    /// @brief Constructs hasher with the given seed
+    ///
+    /// @param[in] seed the seed value
+    constexpr explicit url_hasher(std::uint64_t seed = 0) noexcept
+        : seed_(seed)
+    {}
+
+    /// @return the seed value
+    [[nodiscard]] constexpr std::uint64_t seed() const noexcept {
+        return seed_;
+    }
+
+    /// @brief Computes the hash value of the serialized URL
+    ///
+    /// If the seed is zero, then it uses the value cached by the url::cache_hash().
+    ///
+    /// @param[in] u URL
+    /// @return hash value
+    [[nodiscard]] std::uint64_t operator()(const url& u) const noexcept {
+        return seed_ == 0 ? u.hash_value() : hash_bytes(u.href(), seed_);
+    }
+
+    /// @brief Computes the hash value of the string
+    ///
+    /// @param[in] str string to hash
+    /// @return hash value
+    [[nodiscard]] std::uint64_t operator()(std::string_view str) const noexcept {
+        return hash_bytes(str, seed_);
+    }
+
+    /// @brief Computes the hash value of the URL's part
+    ///
+    /// @param[in] u URL
+    /// @param[in] t URL's part
+    /// @return hash value of the string returned by `u.get_part_view(t)`
+    [[nodiscard]] std::uint64_t part(const url& u, url::PartType t) const noexcept {
+        return hash_bytes(u.get_part_view(t), seed_);
+    }
+
+    /// @brief Computes the hash value of the URL's host
+    ///
+    /// @param[in] u URL
+    /// @return hash value of the string returned by `u.hostname()`
+    [[nodiscard]] std::uint64_t host(const url& u) const noexcept {
+        return part(u, url::HOST);
+    }
+
+    /// @brief Computes the hash value of the URL's path (without query)
+    ///
+    /// @param[in] u URL
+    /// @return hash value of the string returned by `u.pathname()`
+    [[nodiscard]] std::uint64_t path(const url& u) const noexcept {
+        return part(u, url::PATH);
+    }
+
+    /// @brief Computes the hash value of the URL's origin
+    ///
+    /// Same origin URLs (see url::same_origin()) have equal origin hash
+    /// values. The hash value is computed without serializing the origin.
+    ///
+    /// @param[in] u URL
+    /// @return hash value of the URL's origin
+    [[nodiscard]] std::uint64_t origin(const url& u) const {
+        url path_url;
+        return u.get_origin_view(path_url).hash(seed_);
+    }
+
+private:
+    std::uint64_t seed_;
+};
+
 /// @brief Swaps the contents of two URLs
 ///
 /// Swaps the contents of the @a lhs and @a rhs URLs
@@ -3152,6 +4375,111 @@ inline void swap(url& lhs, url& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// Component canonicalizers
+//
+// These functions canonicalize a single URL component, as the basic URL
+// parser does with the state override, but without creating a URL. The
+// result is appended to the output string, so the same buffer can be reused
+// for many components. The ASCII tab and newline code points are removed
+// from the input.
+
+/// @brief Canonicalizes the URL's scheme
+///
+/// The scheme ends with ':' or the end of input; the rest of input is ignored.
+///
+/// @param[in] str scheme string
+/// @param[out] output string to append the ASCII lowercase scheme to
+/// @return validation_errc::ok on success, or an error code on failure
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline validation_errc canonicalize_scheme(const StrT& str, std::string& output) {
+    const auto inp = make_str_arg(str);
+    return detail::url_parser::canonicalize_scheme(inp.begin(), inp.end(), output);
+}
+
+/// @brief Canonicalizes the URL's host
+///
+/// Does the same as the hostname setter: the host ends with the end of
+/// authority, and the host followed by a port is not accepted.
+///
+/// @param[in] str host string
+/// @param[out] output string to append the serialized host to; it is not
+///   changed on failure
+/// @param[in] is_special `true` if the host is of the special URL, otherwise
+///   the host is parsed as an opaque host
+/// @return validation_errc::ok on success, or an error code on failure
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline validation_errc canonicalize_host(const StrT& str, std::string& output, bool is_special = true) {
+    const auto inp = make_str_arg(str);
+    return detail::url_parser::canonicalize_host(inp.begin(), inp.end(), is_special, output);
+}
+
+/// @brief Canonicalizes the URL's port
+///
+/// The port ends with the first non-digit code point; the rest of input is
+/// ignored. Nothing is appended if the port is the default port of the
+/// @a scheme.
+///
+/// @param[in] str port string
+/// @param[out] output string to append the port to
+/// @param[in] scheme canonical scheme of the URL
+/// @return validation_errc::ok on success, or an error code on failure
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline validation_errc canonicalize_port(const StrT& str, std::string& output, std::string_view scheme = {}) {
+    const auto inp = make_str_arg(str);
+    return detail::url_parser::canonicalize_port(inp.begin(), inp.end(),
+        detail::get_scheme_info(scheme), output);
+}
+
+/// @brief Canonicalizes the URL's path
+///
+/// Percent-encodes the path segments and resolves the dot segments of the
+/// path of the non-file URL. Each path segment is appended with the leading
+/// '/', so at least "/" is appended.
+///
+/// @param[in] str path string
+/// @param[out] output string to append the path to
+/// @param[in] is_special `true` if the path is of the special URL, then '\'
+///   is treated as '/'
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline void canonicalize_path(const StrT& str, std::string& output, bool is_special = true) {
+    const auto inp = make_str_arg(str);
+    detail::url_parser::canonicalize_path(inp.begin(), inp.end(), is_special, output);
+}
+
+/// @brief Canonicalizes the URL's opaque path
+///
+/// The opaque path ends with '?', '#' or the end of input; the rest of
+/// input is ignored.
+///
+/// @param[in] str opaque path string
+/// @param[out] output string to append the opaque path to
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline void canonicalize_opaque_path(const StrT& str, std::string& output) {
+    const auto inp = make_str_arg(str);
+    detail::url_parser::canonicalize_opaque_path(inp.begin(), inp.end(), output);
+}
+
+/// @brief Canonicalizes the URL's query
+///
+/// @param[in] str query string without leading '?'
+/// @param[out] output string to append the percent-encoded query to
+/// @param[in] is_special `true` to use the special-query percent-encode set
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline void canonicalize_query(const StrT& str, std::string& output, bool is_special = true) {
+    const auto inp = make_str_arg(str);
+    detail::url_parser::canonicalize_query(inp.begin(), inp.end(), is_special, output);
+}
+
+/// @brief Canonicalizes the URL's fragment
+///
+/// @param[in] str fragment string without leading '#'
+/// @param[out] output string to append the percent-encoded fragment to
+template <class StrT, enable_if_str_arg_t<StrT> = 0>
+inline void canonicalize_fragment(const StrT& str, std::string& output) {
+    const auto inp = make_str_arg(str);
+    detail::url_parser::canonicalize_fragment(inp.begin(), inp.end(), output);
+}
+
 /// @brief File path format
 enum class file_path_format {
     posix = 1,  ///< POSIX file path format
@@ -3199,65 +4527,68 @@ template <class StrT, enable_if_str_arg_t<StrT> = 0>
     }
 
     const auto* pointer = first;
-    const auto* start_of_check = first;
-    const code_point_set* no_encode_set = nullptr;
-
-    std::string str_url("file://");
 
     if (format == file_path_format::posix) {
         if (!detail::is_posix_slash(*first))
             throw url_error(validation_errc::file_unsupported_path, "Non-absolute POSIX path");
-        if (detail::has_dot_dot_segment(start_of_check, last, detail::is_posix_slash<CharT>))
+        if (detail::has_dot_dot_segment(first, last, detail::is_posix_slash<CharT>))
             throw url_error(validation_errc::file_unsupported_path, "Unsupported file path");
-        // Absolute POSIX path
-        no_encode_set = &posix_path_no_encode_set;
-    } else {
-        // Windows path?
-        bool is_unc = false;
+        // Check for null characters
+        if (util::contains_null(first, last))
+            throw url_error(validation_errc::null_character, "Path contains null character");
+
+        // Absolute POSIX path: make URL without parsing
+        url u;
+        detail::url_serializer urls(u);
+        detail::url_parser::make_posix_file_url(urls, first, last);
+        return u;
+    }
 
-        // https://learn.microsoft.com/en-us/windows/win32/fileio/naming-a-file
-        // https://learn.microsoft.com/en-us/dotnet/standard/io/file-path-formats
-        // https://learn.microsoft.com/en-us/windows/win32/fileio/maximum-file-path-limitation
+    // Windows path
+    bool is_unc = false;
+
+    // https://learn.microsoft.com/en-us/windows/win32/fileio/naming-a-file
+    // https://learn.microsoft.com/en-us/dotnet/standard/io/file-path-formats
+    // https://learn.microsoft.com/en-us/windows/win32/fileio/maximum-file-path-limitation
+    if (last - pointer >= 2 &&
+        detail::is_windows_slash(pointer[0]) &&
+        detail::is_windows_slash(pointer[1])) {
+        pointer += 2; // skip '\\'
+
+        // It is Win32 namespace path or UNC path?
         if (last - pointer >= 2 &&
-            detail::is_windows_slash(pointer[0]) &&
+            (pointer[0] == '?' || pointer[0] == '.') &&
             detail::is_windows_slash(pointer[1])) {
-            pointer += 2; // skip '\\'
-
-            // It is Win32 namespace path or UNC path?
-            if (last - pointer >= 2 &&
-                (pointer[0] == '?' || pointer[0] == '.') &&
-                detail::is_windows_slash(pointer[1])) {
-                // Win32 File ("\\?\") or Device ("\\.\") namespace path
-                pointer += 2; // skip "?\" or ".\"
-                if (last - pointer >= 4 &&
-                    (pointer[0] | 0x20) == 'u' &&
-                    (pointer[1] | 0x20) == 'n' &&
-                    (pointer[2] | 0x20) == 'c' &&
-                    detail::is_windows_slash(pointer[3])) {
-                    pointer += 4; // skip "UNC\"
-                    is_unc = true;
-                }
-            } else {
-                // UNC path
+            // Win32 File ("\\?\") or Device ("\\.\") namespace path
+            pointer += 2; // skip "?\" or ".\"
+            if (last - pointer >= 4 &&
+                (pointer[0] | 0x20) == 'u' &&
+                (pointer[1] | 0x20) == 'n' &&
+                (pointer[2] | 0x20) == 'c' &&
+                detail::is_windows_slash(pointer[3])) {
+                pointer += 4; // skip "UNC\"
                 is_unc = true;
             }
+        } else {
+            // UNC path
+            is_unc = true;
         }
-        start_of_check = is_unc
-            ? detail::is_unc_path(pointer, last)
-            : detail::is_windows_os_drive_absolute_path(pointer, last);
-        if (start_of_check == nullptr ||
-            detail::has_dot_dot_segment(start_of_check, last, detail::is_windows_slash<CharT>))
-            throw url_error(validation_errc::file_unsupported_path, "Unsupported file path");
-        no_encode_set = &raw_path_no_encode_set;
-        if (!is_unc) str_url.push_back('/'); // start path
     }
+    const auto* start_of_check = is_unc
+        ? detail::is_unc_path(pointer, last)
+        : detail::is_windows_os_drive_absolute_path(pointer, last);
+    if (start_of_check == nullptr ||
+        detail::has_dot_dot_segment(start_of_check, last, detail::is_windows_slash<CharT>))
+        throw url_error(validation_errc::file_unsupported_path, "Unsupported file path");
 
     // Check for null characters
     if (util::contains_null(start_of_check, last))
         throw url_error(validation_errc::null_character, "Path contains null character");
 
     // make URL
-    detail::append_utf8_percent_encoded(pointer, last, *no_encode_set, str_url);
+    std::string str_url("file://");
+    if (!is_unc) str_url.push_back('/'); // start path
+    detail::append_utf8_percent_encoded(pointer, last, raw_path_no_encode_set, str_url);
     return url(str_url);
 }
 
@@ -3277,6 +4608,42 @@ template <class StrT, enable_if_str_arg_t<StrT> = 0>
 #endif
 }
 
+/// @brief Make URLs from OS file paths
+///
+/// Makes the URL of each file path in the range as url_from_file_path()
+/// does, and writes it to the output. Conversion does not stop on the paths
+/// which can not be converted: the empty (invalid) URL is written for each of
+/// them, so the output URLs correspond to the input paths.
+///
+/// @par Example
+/// @code
+/// std::vector<std::string> paths;
+/// for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+///     paths.push_back(entry.path().string());
+/// std::vector<upa::url> urls;
+/// upa::urls_from_file_paths(paths.begin(), paths.end(), std::back_inserter(urls));
+/// @endcode
+///
+/// @param[in] first,last range of absolute file path strings
+/// @param[out] d_first output iterator of upa::url
+/// @param[in] format file path format, one of upa::file_path_format::posix,
+///   upa::file_path_format::windows, upa::file_path_format::native
+/// @return output iterator to the element past the last URL written
+template <class InputIt, class OutputIt>
+inline OutputIt urls_from_file_paths(InputIt first, InputIt last, OutputIt d_first,
+    file_path_format format = file_path_format::native)
+{
+    for (; first != last; ++first, ++d_first) {
+        try {
+            *d_first = url_from_file_path(*first, format);
+        }
+        catch (const url_error&) {
+            *d_first = url{};
+        }
+    }
+    return d_first;
+}
+
 /// @brief Get OS path from file URL
 ///
 /// Throws url_error exception on error.
@@ -3405,10 +4772,13 @@ inline bool check_version() {
 namespace std {
 
 /// @brief std::hash specialization for upa::url class
+///
+/// Uses the upa::url::hash_value(), so the hash value does not depend on
+/// the standard library.
 template<>
 struct hash<upa::url> {
     [[nodiscard]] std::size_t operator()(const upa::url& url) const noexcept {
-        return std::hash<std::string>{}(url.norm_url_);
+        return static_cast<std::size_t>(url.hash_value());
     }
 };
 
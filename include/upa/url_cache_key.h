@@ -0,0 +1,135 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_CACHE_KEY_H
+#define UPA_URL_CACHE_KEY_H
+
+#include "url.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+/// @brief Normalization rules of the cache_key_builder
+///
+/// The URL parser already lowercases the scheme and the hosts of special
+/// URLs, and removes the default port of special schemes, so there are no
+/// rules for them.
+struct cache_key_options {
+    /// Keep the non-empty fragment in the key
+    bool keep_fragment = false;
+    /// Sort the query parameters by their names; the sort is stable, so the
+    /// parameters with the same name keep their order
+    bool sort_query = true;
+    /// Lowercase the ASCII letters of the opaque host of non-special URL
+    bool lowercase_host = true;
+    /// Names of the query parameters to drop from the key; the name ending
+    /// with `*` matches all names with that prefix, for example "utm_*"
+    std::vector<std::string> ignored_params;
+    /// If not empty, only the query parameters with these names are kept in
+    /// the key; the name ending with `*` matches all names with that prefix
+    std::vector<std::string> kept_params;
+};
+
+/// @brief 128-bit cache key fingerprint
+struct cache_key_fingerprint {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    [[nodiscard]] friend bool operator==(const cache_key_fingerprint& lhs, const cache_key_fingerprint& rhs) noexcept {
+        return lhs.low == rhs.low && lhs.high == rhs.high;
+    }
+    [[nodiscard]] friend bool operator!=(const cache_key_fingerprint& lhs, const cache_key_fingerprint& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+
+/// @brief HTTP cache key builder
+///
+/// Makes the cache key of the parsed URL in a single pass over its
+/// components, according to the rules given in the constructor: the
+/// fragment is removed, the query parameters are filtered and sorted, and
+/// the empty parameters and the empty query are removed.
+///
+/// The query parameters are compared and sorted by their names as they are
+/// serialized in the URL, that is, percent-encoded and without decoding the
+/// `+` to space.
+///
+/// The key can be appended to the caller's buffer, or only its fingerprint
+/// can be calculated, without making the key string. The URLs with equal
+/// keys have equal fingerprints. The fingerprint is not a cryptographic hash.
+///
+/// @par Example
+/// @code
+/// upa::cache_key_options options;
+/// options.ignored_params = { "utm_*", "fbclid" };
+/// const upa::cache_key_builder builder{ options };
+///
+/// std::string key;
+/// builder.append_key(upa::url{ "https://example.org/?b=2&utm_source=x&a=1#top" }, key);
+/// // key == "https://example.org/?a=1&b=2"
+/// @endcode
+class cache_key_builder {
+public:
+    /// @brief Constructs the builder with the given rules
+    ///
+    /// @param[in] options normalization rules
+    UPA_API explicit cache_key_builder(cache_key_options options = {});
+
+    /// @return the normalization rules
+    [[nodiscard]] const cache_key_options& options() const noexcept {
+        return options_;
+    }
+
+    /// @brief Appends the cache key of the URL to the @a output
+    ///
+    /// @param[in] u URL
+    /// @param[in,out] output string to append the key to
+    /// @return `true` on success, `false` if @a u is invalid (nothing is
+    ///   appended then)
+    UPA_API bool append_key(const url& u, std::string& output) const;
+
+    /// @brief Makes the cache key of the URL
+    ///
+    /// @param[in] u URL
+    /// @return the cache key, or the empty string if @a u is invalid
+    [[nodiscard]] std::string key(const url& u) const {
+        std::string output;
+        append_key(u, output);
+        return output;
+    }
+
+    /// @brief Calculates the 64-bit fingerprint of the URL's cache key
+    ///
+    /// The key string is not made.
+    ///
+    /// @param[in] u URL
+    /// @return the fingerprint; the fingerprint of the empty key if @a u is
+    ///   invalid
+    [[nodiscard]] UPA_API std::uint64_t fingerprint(const url& u) const;
+
+    /// @brief Calculates the 128-bit fingerprint of the URL's cache key
+    ///
+    /// The key string is not made.
+    ///
+    /// @param[in] u URL
+    /// @return the fingerprint; the fingerprint of the empty key if @a u is
+    ///   invalid
+    [[nodiscard]] UPA_API cache_key_fingerprint fingerprint128(const url& u) const;
+
+private:
+    template <class Sink>
+    bool build(const url& u, Sink& sink) const;
+
+    [[nodiscard]] bool is_kept_param(std::string_view name) const noexcept;
+
+    cache_key_options options_;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_CACHE_KEY_H
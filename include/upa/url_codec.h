@@ -0,0 +1,177 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_CODEC_H
+#define UPA_URL_CODEC_H
+
+#include "url.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+class public_suffix_list;
+
+/// @brief Options for the url_codec dictionaries learning
+struct url_codec_options {
+    /// The maximum number of entries in the host dictionary
+    std::size_t max_hosts = 1 << 16;
+    /// The maximum number of entries in the path segment dictionary
+    std::size_t max_path_segments = 1 << 16;
+    /// The maximum number of entries in the query key dictionary
+    std::size_t max_query_keys = 1 << 12;
+    /// The minimum number of occurrences in the training URLs for the string
+    /// to get into the dictionary
+    std::size_t min_frequency = 2;
+    /// If not null, the hosts are split into the subdomain and the registrable
+    /// domain, and both parts are coded against the host dictionary
+    const public_suffix_list* psl = nullptr;
+};
+
+/// @brief URL-aware binary encoder and decoder
+///
+/// Encodes the parsed URLs into the compact binary form using the URL
+/// structure: the special schemes are encoded as small integers, the port as
+/// a varint, and the host, path segments and query keys are coded against
+/// the dictionaries learned from the training URLs. The strings which are not
+/// in the dictionaries are stored literally, so any valid URL can be encoded,
+/// and decoding rebuilds its href byte for byte.
+///
+/// The dictionaries are needed to decode, so store them along with the
+/// encoded URLs (see serialize(), load()).
+///
+/// @par Example
+/// @code
+/// const upa::url_codec codec(sample.begin(), sample.end());
+/// std::string data;
+/// for (const auto& u : urls)
+///     codec.encode(u, data);
+///
+/// const char* first = data.data();
+/// const char* last = first + data.size();
+/// std::string href;
+/// while (first != last && codec.decode(first, last, href))
+///     std::cout << href << '\n';
+/// @endcode
+class url_codec {
+public:
+    /// @brief Constructs the codec with empty dictionaries
+    ///
+    /// Such codec stores all strings literally.
+    url_codec() = default;
+
+    /// @brief Constructs the codec and learns the dictionaries
+    ///
+    /// @param[in] first,last range of the upa::url objects to learn the
+    ///   dictionaries from; invalid URLs are ignored
+    /// @param[in] options learning options
+    template <class InputIt>
+    url_codec(InputIt first, InputIt last, const url_codec_options& options = {}) {
+        std::vector<const url*> urls;
+        for (; first != last; ++first) {
+            const url& u = *first;
+            if (u.is_valid())
+                urls.push_back(&u);
+        }
+        learn(urls, options);
+    }
+
+    /// @brief Sets the Public Suffix List used to split hosts
+    ///
+    /// Encoding uses it only if the dictionaries were learned with the
+    /// url_codec_options::psl, and without it the hosts are coded as a whole.
+    /// Decoding does not need it.
+    ///
+    /// @param[in] psl pointer to the Public Suffix List, or `nullptr`
+    void set_public_suffix_list(const public_suffix_list* psl) noexcept {
+        psl_ = psl;
+    }
+
+    /// @return the number of entries in the host dictionary
+    [[nodiscard]] std::size_t host_dictionary_size() const noexcept {
+        return hosts_.entries.size();
+    }
+
+    /// @return the number of entries in the path segment dictionary
+    [[nodiscard]] std::size_t path_segment_dictionary_size() const noexcept {
+        return segments_.entries.size();
+    }
+
+    /// @return the number of entries in the query key dictionary
+    [[nodiscard]] std::size_t query_key_dictionary_size() const noexcept {
+        return query_keys_.entries.size();
+    }
+
+    // Encoding and decoding
+
+    /// @brief Encodes the URL and appends it to the @a output
+    ///
+    /// @param[in] u URL to encode
+    /// @param[in,out] output string to append the encoded URL to
+    /// @return `true` on success, `false` if @a u is invalid (nothing is
+    ///   appended then)
+    UPA_API bool encode(const url& u, std::string& output) const;
+
+    /// @brief Decodes one URL
+    ///
+    /// @param[in,out] first pointer to the encoded URL; on success it is
+    ///   advanced past the encoded URL
+    /// @param[in] last end of the encoded data
+    /// @param[out] href the serialized URL
+    /// @return `true` on success, `false` if the data is truncated or corrupted
+    UPA_API bool decode(const char*& first, const char* last, std::string& href) const;
+
+    /// @brief Decodes and parses one URL
+    ///
+    /// @param[in,out] first pointer to the encoded URL; on success it is
+    ///   advanced past the encoded URL
+    /// @param[in] last end of the encoded data
+    /// @param[out] u the decoded URL
+    /// @return `true` on success, `false` if the data is truncated or corrupted
+    UPA_API bool decode(const char*& first, const char* last, url& u) const;
+
+    // Dictionaries
+
+    /// @brief Serializes the dictionaries and appends them to the @a output
+    ///
+    /// @param[in,out] output string to append to
+    UPA_API void serialize(std::string& output) const;
+
+    /// @brief Loads the dictionaries serialized by serialize()
+    ///
+    /// @param[in] data serialized dictionaries
+    /// @return `true` on success; on failure the codec is left unchanged
+    UPA_API bool load(std::string_view data);
+
+private:
+    // Dictionary entries and the open addressing hash table of their indexes
+    struct dictionary {
+        std::vector<std::string> entries;
+        std::vector<std::uint32_t> slots; // entry index + 1, or 0 if empty
+
+        void build_index();
+        [[nodiscard]] std::size_t find(std::string_view str) const noexcept;
+        void encode(std::string_view str, std::string& output) const;
+        bool decode(const char*& first, const char* last, std::string& output) const;
+    };
+
+    UPA_API void learn(const std::vector<const url*>& urls, const url_codec_options& options);
+    [[nodiscard]] std::size_t split_host(const url& u, std::string_view host) const;
+
+    static constexpr std::uint8_t kVersion = 1;
+
+    dictionary hosts_;
+    dictionary segments_;
+    dictionary query_keys_;
+    bool split_hosts_ = false;
+    const public_suffix_list* psl_ = nullptr;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_CODEC_H
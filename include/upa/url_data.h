@@ -0,0 +1,149 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_DATA_H
+#define UPA_URL_DATA_H
+
+#include "url.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace upa {
+
+/// @brief MIME type record
+///
+/// See: https://mimesniff.spec.whatwg.org/#mime-type-representation
+struct mime_type {
+    /// The ASCII lowercase type, e.g. "text"
+    std::string type;
+    /// The ASCII lowercase subtype, e.g. "plain"
+    std::string subtype;
+    /// The parameters in the input order; the names are ASCII lowercase and unique
+    std::vector<std::pair<std::string, std::string>> parameters;
+
+    /// @return the MIME type's essence: type + "/" + subtype
+    [[nodiscard]] std::string essence() const {
+        std::string res;
+        res.reserve(type.length() + 1 + subtype.length());
+        res += type;
+        res += '/';
+        res += subtype;
+        return res;
+    }
+
+    /// @brief Finds the parameter value
+    ///
+    /// @param[in] name ASCII lowercase parameter name
+    /// @return pointer to the parameter value, or `nullptr` if there is no such parameter
+    [[nodiscard]] const std::string* parameter(std::string_view name) const noexcept {
+        for (const auto& param : parameters) {
+            if (param.first == name)
+                return &param.second;
+        }
+        return nullptr;
+    }
+
+    /// @brief Serializes the MIME type
+    ///
+    /// See: https://mimesniff.spec.whatwg.org/#serialize-a-mime-type
+    ///
+    /// @return serialized MIME type
+    [[nodiscard]] UPA_API std::string serialize() const;
+};
+
+/// @brief Parses a MIME type
+///
+/// The input bytes are treated as the code points U+0000 to U+00FF.
+///
+/// See: https://mimesniff.spec.whatwg.org/#parse-a-mime-type
+///
+/// @param[in] input string to parse
+/// @return MIME type record, or `std::nullopt` on failure
+[[nodiscard]] UPA_API std::optional<mime_type> parse_mime_type(std::string_view input);
+
+/// @brief The `data:` URL processor
+///
+/// Implements the data: URL processor of the Fetch standard:
+/// https://fetch.spec.whatwg.org/#data-url-processor
+///
+/// The processing is split in two steps: parse() gets the MIME type, the
+/// base64 flag and the encoded body of the URL, and the body is decoded
+/// later by decode_body() or append_body() into the caller's buffer. The body
+/// is percent-decoded and, if the base64 flag is set, forgiving-base64
+/// decoded in a single pass over the encoded body.
+///
+/// The encoded body is a view of the URL's serialized string, so the URL
+/// must outlive the data_url object and must not be modified.
+///
+/// @par Example
+/// @code
+/// const upa::url u{ "data:image/png;base64,iVBORw0KGgo=" };
+/// upa::data_url du;
+/// std::string body;
+/// if (du.parse(u) && du.append_body(body)) {
+///     // du.mime().essence() == "image/png"
+///     // body contains the PNG signature
+/// }
+/// @endcode
+class data_url {
+public:
+    /// @brief Processes the data: URL, except its body
+    ///
+    /// @param[in] u URL to process
+    /// @return `true` on success, `false` if @a u is not a valid `data:` URL, or
+    ///   it has no comma; then the MIME type and the encoded body are empty
+    UPA_API bool parse(const url& u);
+
+    /// @return the MIME type; "text/plain;charset=US-ASCII" if the URL's MIME
+    ///   type is empty or invalid
+    [[nodiscard]] const mime_type& mime() const noexcept {
+        return mime_;
+    }
+
+    /// @return `true` if the URL's MIME type ends with ";base64"
+    [[nodiscard]] bool is_base64() const noexcept {
+        return base64_;
+    }
+
+    /// @return the encoded body: the part of the URL after the first comma,
+    ///   without the fragment
+    [[nodiscard]] std::string_view encoded_body() const noexcept {
+        return encoded_body_;
+    }
+
+    /// @return the maximum size of the decoded body in bytes
+    [[nodiscard]] std::size_t max_body_size() const noexcept {
+        return base64_
+            ? encoded_body_.length() / 4 * 3 + 2
+            : encoded_body_.length();
+    }
+
+    /// @brief Decodes the body into the caller's buffer
+    ///
+    /// @param[out] output buffer of at least max_body_size() bytes
+    /// @return the size of the decoded body, or `std::nullopt` if the base64
+    ///   body is invalid; the data: URL processor fails then
+    [[nodiscard]] UPA_API std::optional<std::size_t> decode_body(char* output) const;
+
+    /// @brief Decodes the body and appends it to the @a output
+    ///
+    /// @param[in,out] output string to append the body to
+    /// @return `true` on success, `false` if the base64 body is invalid (nothing
+    ///   is appended then); the data: URL processor fails then
+    UPA_API bool append_body(std::string& output) const;
+
+private:
+    mime_type mime_;
+    std::string_view encoded_body_;
+    bool base64_ = false;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_DATA_H
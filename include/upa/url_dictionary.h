@@ -0,0 +1,189 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_DICTIONARY_H
+#define UPA_URL_DICTIONARY_H
+
+#include "mapped_file.h"
+#include "url.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+/// @brief Sorted, front-coded set of serialized URLs
+///
+/// Stores the sorted unique serialized URLs in blocks. The first URL of each
+/// block is stored in full, and each other URL as the length of the prefix
+/// shared with the previous URL, plus the remaining suffix. As URLs share long
+/// prefixes (scheme, host, path), it uses several times less memory than
+/// `std::unordered_set<upa::url>`.
+///
+/// Lookup functions do binary search over the blocks and then decode at most
+/// one block. Each URL has an ordinal - the zero-based index in the sorted order.
+///
+/// The dictionary is immutable; it can be saved to a file, and loaded from it
+/// using memory mapping (see save(), load()).
+///
+/// @par Example
+/// @code
+/// std::vector<upa::url> urls = ...;
+/// const upa::url_dictionary dict(urls.begin(), urls.end());
+/// if (dict.contains(upa::url{ "https://example.org/" }))
+///     std::cout << "seen\n";
+/// @endcode
+class url_dictionary {
+public:
+    using size_type = std::size_t;
+
+    /// The value returned by find() if URL is not found
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    /// The default number of URLs in one block
+    static constexpr size_type default_block_size = 16;
+
+    /// @brief Constructs an empty dictionary
+    url_dictionary() = default;
+
+    /// @brief Constructs the dictionary from the URLs
+    ///
+    /// Duplicates and invalid URLs are ignored.
+    ///
+    /// @param[in] first,last range of the upa::url objects
+    /// @param[in] block_size the number of URLs in one block (bigger block
+    ///   gives smaller size, but slower lookup)
+    template <class InputIt>
+    url_dictionary(InputIt first, InputIt last, size_type block_size = default_block_size) {
+        std::vector<std::string_view> hrefs;
+        for (; first != last; ++first) {
+            const url& u = *first;
+            if (u.is_valid())
+                hrefs.push_back(u.href());
+        }
+        build(std::move(hrefs), block_size);
+    }
+
+    /// @brief Move constructor
+    url_dictionary(url_dictionary&&) noexcept = default;
+
+    /// @brief Move assignment
+    url_dictionary& operator=(url_dictionary&&) noexcept = default;
+
+    url_dictionary(const url_dictionary&) = delete;
+    url_dictionary& operator=(const url_dictionary&) = delete;
+
+    /// @return the number of URLs in the dictionary
+    [[nodiscard]] size_type size() const noexcept {
+        return count_;
+    }
+
+    /// @return `true` if dictionary is empty
+    [[nodiscard]] bool empty() const noexcept {
+        return count_ == 0;
+    }
+
+    /// @return the number of URLs in one block
+    [[nodiscard]] size_type block_size() const noexcept {
+        return block_size_;
+    }
+
+    /// @return the number of bytes of the encoded data and block index (the
+    ///   memory-mapped file is not included)
+    [[nodiscard]] UPA_API std::size_t memory_size() const noexcept;
+
+    // Lookup
+
+    /// @brief Finds the first URL not less than @a href
+    ///
+    /// @param[in] href serialized URL
+    /// @return ordinal of the found URL, or size() if there is no such URL
+    [[nodiscard]] UPA_API size_type lower_bound(std::string_view href) const;
+
+    /// @brief Finds the URL
+    ///
+    /// @param[in] href serialized URL
+    /// @return ordinal of the URL, or npos if not found
+    [[nodiscard]] UPA_API size_type find(std::string_view href) const;
+
+    /// @brief Finds the URL
+    ///
+    /// @param[in] u URL
+    /// @return ordinal of the URL, or npos if not found
+    [[nodiscard]] size_type find(const url& u) const {
+        return find(u.href());
+    }
+
+    /// @param[in] href serialized URL
+    /// @return `true` if the dictionary contains the URL
+    [[nodiscard]] bool contains(std::string_view href) const {
+        return find(href) != npos;
+    }
+
+    /// @param[in] u URL
+    /// @return `true` if the dictionary contains the URL
+    [[nodiscard]] bool contains(const url& u) const {
+        return find(u.href()) != npos;
+    }
+
+    /// @brief Gets the serialized URL by its ordinal
+    ///
+    /// @param[in] ordinal zero-based index of the URL in the sorted order
+    /// @return serialized URL
+    /// @throws std::out_of_range if @a ordinal >= size()
+    [[nodiscard]] UPA_API std::string at(size_type ordinal) const;
+
+    /// @brief Gets the serialized URL by its ordinal
+    ///
+    /// @param[in] ordinal zero-based index of the URL in the sorted order, must
+    ///   be less than size()
+    /// @param[out] output string to write the URL to
+    UPA_API void get(size_type ordinal, std::string& output) const;
+
+    // File
+
+    /// @brief Saves the dictionary to a file
+    ///
+    /// The file uses the native byte order, so it can be loaded on the
+    /// platforms with the same byte order only.
+    ///
+    /// @param[in] path path of the file to write
+    /// @return `true` on success
+    UPA_API bool save(const std::filesystem::path& path) const;
+
+    /// @brief Loads the dictionary from a file saved by save()
+    ///
+    /// The file is memory-mapped and the dictionary refers to it. The data is
+    /// validated on load.
+    ///
+    /// @param[in] path path of the file to load
+    /// @return `true` on success; on failure the dictionary is empty
+    UPA_API bool load(const std::filesystem::path& path);
+
+    /// @return `true` if dictionary refers to the memory-mapped file
+    [[nodiscard]] bool is_mapped() const noexcept {
+        return file_.is_open();
+    }
+
+private:
+    UPA_API void build(std::vector<std::string_view>&& hrefs, size_type block_size);
+    void clear() noexcept;
+
+    [[nodiscard]] std::string_view block_first(size_type block) const noexcept;
+    [[nodiscard]] size_type search(std::string_view href, bool& found) const;
+
+    size_type count_ = 0;
+    size_type block_size_ = default_block_size;
+    detail::pod_array<char> data_;
+    detail::pod_array<std::uint64_t> block_offset_;
+    mapped_file file_;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_DICTIONARY_H
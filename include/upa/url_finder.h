@@ -0,0 +1,93 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_FINDER_H
+#define UPA_URL_FINDER_H
+
+#include "url.h"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+class public_suffix_list;
+
+/// @brief URL found in the text
+struct url_match {
+    /// The offset of the URL in the text
+    std::size_t offset = 0;
+    /// The length of the URL in the text
+    std::size_t length = 0;
+    /// The parsed URL
+    url value;
+};
+
+/// @brief Finds URLs in the free text (linkifier)
+///
+/// The text is scanned for the candidate URLs:
+/// * the `scheme://...` strings,
+/// * the `www.` prefixed strings (parsed with the `http://` prefix),
+/// * the bare domains, if Public Suffix List is set (parsed with the
+///   `http://` prefix); the domain must end with a listed public suffix and
+///   have a registrable domain, for example `example.com/path`.
+///
+/// The candidate ends before a whitespace, control character or one of
+/// `<>"` characters; then the trailing punctuation and unbalanced closing
+/// brackets are excluded. Only the candidates are parsed with the URL parser,
+/// and the ones which fail to parse are skipped. The `www.` and bare domain
+/// candidates with the authority (host and port) longer than 1024 bytes are
+/// skipped too.
+///
+/// The text is scanned in linear time, also if it has many candidates which
+/// fail to parse, or long runs of brackets.
+///
+/// The candidate markers (`:` and `.`) are searched with std::memchr, which
+/// is vectorized in the common C libraries.
+///
+/// @par Example
+/// @code
+/// const upa::url_finder finder;
+/// for (const auto& m : finder.find_all("See https://example.org/docs."))
+///     std::cout << m.offset << ' ' << m.length << ' ' << m.value.href() << '\n';
+/// @endcode
+class url_finder {
+public:
+    /// @brief Constructs the finder of URLs with a scheme and `www.` URLs
+    url_finder() noexcept = default;
+
+    /// @brief Constructs the finder, which also finds bare domains
+    ///
+    /// @param[in] psl pointer to the Public Suffix List used to validate bare
+    ///   domains; it must outlive the finder. If `nullptr`, bare domains are
+    ///   not searched.
+    explicit url_finder(const public_suffix_list* psl) noexcept
+        : psl_(psl)
+    {}
+
+    /// @brief Finds the next URL
+    ///
+    /// @param[in] text the text to search in
+    /// @param[in,out] pos the position to start searching from; on success it
+    ///   is set to the end of the found URL
+    /// @param[out] match the found URL
+    /// @return `true` if URL is found
+    UPA_API bool find_next(std::string_view text, std::size_t& pos, url_match& match) const;
+
+    /// @brief Finds all URLs
+    ///
+    /// @param[in] text the text to search in
+    /// @return found URLs in order of their offsets
+    [[nodiscard]] UPA_API std::vector<url_match> find_all(std::string_view text) const;
+
+private:
+    [[nodiscard]] bool is_bare_domain(std::string_view host) const;
+
+    const public_suffix_list* psl_ = nullptr;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_FINDER_H
@@ -13,6 +13,7 @@
 #include "url_ip.h"
 #include "url_percent_encode.h"
 #include "url_result.h"
+#include "url_stats.h"
 #include "url_utf.h"
 #include "util.h"
 #include <algorithm> // any_of
@@ -268,6 +269,10 @@ inline validation_errc host_parser::parse_host(const CharT* first, const CharT*
     const auto pes = std::find(ptr, last, '%');
     if (pes == last) {
         // Input is ASCII if ptr == last
+        if (ptr == last)
+            UPA_STATS_INC(idna_ascii);
+        else
+            UPA_STATS_INC(idna_non_ascii);
         if (!idna::domain_to_ascii(buff_ascii, first, last, false, ptr == last))
             return validation_errc::domain_to_ascii;
     } else {
@@ -320,6 +325,7 @@ inline validation_errc host_parser::parse_host(const CharT* first, const CharT*
                 buff_uc.push_back(url_utf::read_utf_char(it, last).value);
             }
         }
+        UPA_STATS_INC(idna_non_ascii);
         if (!idna::domain_to_ascii(buff_ascii, buff_uc.begin(), buff_uc.end()))
             return validation_errc::domain_to_ascii;
     }
@@ -361,6 +367,7 @@ inline validation_errc host_parser::parse_opaque_host(const CharT* first, const
 
     if (dest.need_save()) {
         std::string& str_host = dest.hostStart();
+        UPA_STATS_COMPONENT(pct_encoded_host);
 
         //TODO: UTF-8 percent encode it using the C0 control percent-encode set
         //detail::append_utf8_percent_encoded(first, last, detail::CHAR_C0_CTRL, str_host);
@@ -394,6 +401,8 @@ inline validation_errc host_parser::parse_ipv4(const CharT* first, const CharT*
     std::uint32_t ipv4;  // NOLINT(cppcoreguidelines-init-variables)
 
     const auto res = ipv4_parse(first, last, ipv4);
+    if (res == validation_errc::ok)
+        UPA_STATS_INC(ipv4_hosts);
     if (res == validation_errc::ok && dest.need_save()) {
         std::string& str_ipv4 = dest.hostStart();
         ipv4_serialize(ipv4, str_ipv4);
@@ -407,6 +416,8 @@ inline validation_errc host_parser::parse_ipv6(const CharT* first, const CharT*
     std::uint16_t ipv6addr[8];
 
     const auto res = ipv6_parse(first, last, ipv6addr);
+    if (res == validation_errc::ok)
+        UPA_STATS_INC(ipv6_hosts);
     if (res == validation_errc::ok && dest.need_save()) {
         std::string& str_ipv6 = dest.hostStart();
         str_ipv6.push_back('[');
@@ -0,0 +1,119 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_PARSE_CACHE_H
+#define UPA_URL_PARSE_CACHE_H
+
+#include "url.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace upa {
+
+/// @brief Bounded, thread-safe cache of parsed URLs
+///
+/// Memoizes the results of the URL parsing, keyed by the raw input string and
+/// the base URL. It is useful when the same URLs are parsed many times, for
+/// example when processing logs.
+///
+/// The cache holds at most capacity() entries; the least recently used entries
+/// are evicted when it is full. Entries are distributed over the shards, each
+/// protected by its own mutex, so concurrent threads rarely contend. The parsed
+/// URLs are shared as immutable objects, so they are parsed outside of locks
+/// and hits only copy a pointer under the lock.
+///
+/// @par Example
+/// @code
+/// upa::url_parse_cache cache;
+/// for (const auto& line : lines) {
+///     if (auto u = cache.get(line))
+///         ++host_count[std::string{ u->hostname() }];
+/// }
+/// @endcode
+class url_parse_cache {
+public:
+    /// @brief Cache usage counters
+    struct statistics {
+        std::uint64_t hits = 0;      ///< number of lookups served from the cache
+        std::uint64_t misses = 0;    ///< number of lookups which parsed the input
+        std::uint64_t evictions = 0; ///< number of entries removed to make room
+        std::size_t size = 0;        ///< current number of entries
+    };
+
+    /// The default maximum number of entries
+    static constexpr std::size_t default_capacity = 4096;
+
+    /// The default number of shards
+    static constexpr std::size_t default_shard_count = 16;
+
+    /// @brief Constructs an empty cache
+    ///
+    /// @param[in] capacity maximum number of entries
+    /// @param[in] shard_count number of independently locked shards
+    UPA_API explicit url_parse_cache(std::size_t capacity = default_capacity,
+        std::size_t shard_count = default_shard_count);
+
+    /// @brief Destructor
+    UPA_API ~url_parse_cache();
+
+    url_parse_cache(const url_parse_cache&) = delete;
+    url_parse_cache& operator=(const url_parse_cache&) = delete;
+
+    /// @brief Gets the parsed URL from the cache, or parses and caches it
+    ///
+    /// Failed parses are cached too.
+    ///
+    /// @param[in] str_url URL string to parse
+    /// @param[in] base pointer to base URL, may be `nullptr`
+    /// @return shared immutable URL, or `nullptr` if @a str_url can not be
+    ///   parsed
+    [[nodiscard]] std::shared_ptr<const url> get(std::string_view str_url, const url* base = nullptr) {
+        std::shared_ptr<const url> res;
+        find_or_parse(str_url, base, res);
+        return res;
+    }
+
+    /// @brief Gets the parsed URL from the cache, or parses and caches it, and
+    ///   copies it to @a u
+    ///
+    /// @param[in] str_url URL string to parse
+    /// @param[in] base pointer to base URL, may be `nullptr`
+    /// @param[out] u URL to copy the result to; it is unchanged on failure
+    /// @return error code (@a validation_errc::ok on success)
+    validation_errc parse(std::string_view str_url, const url* base, url& u) {
+        std::shared_ptr<const url> res;
+        const validation_errc err = find_or_parse(str_url, base, res);
+        if (res)
+            u = *res;
+        return err;
+    }
+
+    /// @return the maximum number of entries
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return shard_capacity_ * shard_count_;
+    }
+
+    /// @return the sum of counters of all shards
+    [[nodiscard]] UPA_API statistics stats() const;
+
+    /// @brief Removes all entries and resets counters
+    UPA_API void clear();
+
+private:
+    struct shard;
+
+    UPA_API validation_errc find_or_parse(std::string_view str_url, const url* base,
+        std::shared_ptr<const url>& res);
+
+    std::size_t shard_count_;
+    std::size_t shard_capacity_;
+    std::unique_ptr<shard[]> shards_;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_PARSE_CACHE_H
@@ -0,0 +1,318 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_PATH_SEGMENTS_H
+#define UPA_URL_PATH_SEGMENTS_H
+
+#include "url_percent_encode.h"
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace upa {
+
+class decoded_path_segments_view;
+
+/// @brief Lazy forward range of the URL's path segments
+///
+/// It is returned by the url::path_segments() and refers to the URL's
+/// serialized path, so it must not outlive the URL or be used after the URL
+/// is modified. Iteration does not allocate: the segments are found while
+/// iterating and returned as `std::string_view`s.
+///
+/// @par Example
+/// @code
+/// const upa::url url{ "https://example.org/api/users/42" };
+/// for (const auto segment : url.path_segments())
+///     std::cout << segment << '\n';
+/// @endcode
+class path_segments_view {
+public:
+    /// @brief Forward iterator over the path segments
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() noexcept = default;
+
+        [[nodiscard]] reference operator*() const noexcept { return segment_; }
+        [[nodiscard]] pointer operator->() const noexcept { return &segment_; }
+
+        iterator& operator++() noexcept {
+            pos_ = segment_.data() + segment_.length();
+            find_segment();
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        [[nodiscard]] friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+            return lhs.pos_ == rhs.pos_;
+        }
+        [[nodiscard]] friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+            return lhs.pos_ != rhs.pos_;
+        }
+
+    private:
+        friend class path_segments_view;
+
+        // pos points to the '/' before the segment, or to the path end
+        iterator(const char* pos, const char* last) noexcept
+            : pos_(pos), last_(last)
+        {
+            find_segment();
+        }
+
+        void find_segment() noexcept {
+            if (pos_ == last_) {
+                segment_ = {};
+                return;
+            }
+            const char* first = pos_ + 1; // skip '/'
+            const char* it = first;
+            while (it != last_ && *it != '/')
+                ++it;
+            segment_ = std::string_view(first, static_cast<std::size_t>(it - first));
+        }
+
+        const char* pos_ = nullptr;
+        const char* last_ = nullptr;
+        std::string_view segment_;
+    };
+
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+    using const_iterator = iterator;
+
+    /// @brief Constructs the empty range
+    path_segments_view() noexcept = default;
+
+    /// @brief Constructs the range of segments of the serialized path
+    ///
+    /// @param[in] path the serialized path: each segment is preceded by `/`
+    /// @param[in] count the number of path segments
+    path_segments_view(std::string_view path, std::size_t count) noexcept
+        : path_(path), count_(count)
+    {}
+
+    [[nodiscard]] iterator begin() const noexcept {
+        return { path_.data(), path_.data() + path_.length() };
+    }
+    [[nodiscard]] iterator end() const noexcept {
+        const char* last = path_.data() + path_.length();
+        return { last, last };
+    }
+
+    /// @return the number of path segments
+    [[nodiscard]] size_type size() const noexcept { return count_; }
+    /// @return `true` if there are no path segments
+    [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+
+    /// @return the first path segment; the range must not be empty
+    [[nodiscard]] std::string_view front() const noexcept {
+        return *begin();
+    }
+    /// @return the last path segment; the range must not be empty
+    [[nodiscard]] std::string_view back() const noexcept {
+        const auto pos = path_.rfind('/');
+        return path_.substr(pos + 1);
+    }
+
+    /// @brief Returns the path segment by index
+    ///
+    /// This function iterates from the first segment; use path_segments_index
+    /// for the constant time access.
+    ///
+    /// @param[in] ind the index of the segment, must be less than size()
+    /// @return the path segment
+    [[nodiscard]] std::string_view operator[](size_type ind) const noexcept {
+        auto it = begin();
+        for (; ind != 0; --ind)
+            ++it;
+        return *it;
+    }
+
+    /// @return the range of percent-decoded path segments
+    [[nodiscard]] decoded_path_segments_view decoded() const noexcept;
+
+    /// @return the serialized path
+    [[nodiscard]] std::string_view path() const noexcept { return path_; }
+
+private:
+    std::string_view path_;
+    std::size_t count_ = 0;
+};
+
+
+/// @brief Lazy forward range of the percent-decoded URL's path segments
+///
+/// The segments which do not contain `%` are returned as is. The others are
+/// decoded into the iterator's buffer, which is reused for every segment; the
+/// returned `std::string_view` is valid until the iterator is incremented or
+/// destroyed. Invalid code points are replaced with U+FFFD characters.
+///
+/// @par Example
+/// @code
+/// const upa::url url{ "https://example.org/files/my%20file.txt" };
+/// for (const auto segment : url.path_segments().decoded())
+///     std::cout << segment << '\n'; // "files", "my file.txt"
+/// @endcode
+class decoded_path_segments_view {
+public:
+    /// @brief Forward iterator over the percent-decoded path segments
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return decoded_ ? std::string_view{ buff_ } : *it_;
+        }
+
+        iterator& operator++() {
+            ++it_;
+            decode();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        [[nodiscard]] friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+            return lhs.it_ == rhs.it_;
+        }
+        [[nodiscard]] friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+            return lhs.it_ != rhs.it_;
+        }
+
+    private:
+        friend class decoded_path_segments_view;
+
+        iterator(path_segments_view::iterator it, path_segments_view::iterator end)
+            : it_(it), end_(end)
+        {
+            decode();
+        }
+
+        void decode() {
+            decoded_ = it_ != end_ && it_->find('%') != std::string_view::npos;
+            if (decoded_) {
+                buff_.clear();
+                detail::append_percent_decoded(*it_, buff_);
+            }
+        }
+
+        path_segments_view::iterator it_;
+        path_segments_view::iterator end_;
+        std::string buff_;
+        bool decoded_ = false;
+    };
+
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+    using const_iterator = iterator;
+
+    /// @brief Constructs the range of the percent-decoded @a segments
+    explicit decoded_path_segments_view(path_segments_view segments) noexcept
+        : segments_(segments)
+    {}
+
+    [[nodiscard]] iterator begin() const {
+        return { segments_.begin(), segments_.end() };
+    }
+    [[nodiscard]] iterator end() const {
+        return { segments_.end(), segments_.end() };
+    }
+
+    /// @return the number of path segments
+    [[nodiscard]] size_type size() const noexcept { return segments_.size(); }
+    /// @return `true` if there are no path segments
+    [[nodiscard]] bool empty() const noexcept { return segments_.empty(); }
+
+private:
+    path_segments_view segments_;
+};
+
+inline decoded_path_segments_view path_segments_view::decoded() const noexcept {
+    return decoded_path_segments_view{ *this };
+}
+
+
+/// @brief Path segments with the retained offsets for the index-based access
+///
+/// It keeps the segment offsets in a vector, which capacity is reused by
+/// the next assign() call. Like the path_segments_view, it refers to the
+/// URL's serialized path.
+///
+/// @par Example
+/// @code
+/// upa::path_segments_index segments;
+/// segments.assign(url.path_segments());
+/// if (segments.size() == 3 && segments[0] == "users")
+///     handle_user(segments[1], segments[2]);
+/// @endcode
+class path_segments_index {
+public:
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+
+    path_segments_index() = default;
+
+    /// @brief Constructs the index of the @a segments
+    explicit path_segments_index(path_segments_view segments) {
+        assign(segments);
+    }
+
+    /// @brief Replaces the indexed segments with @a segments
+    void assign(path_segments_view segments) {
+        path_ = segments.path();
+        seg_start_.clear();
+        seg_start_.reserve(segments.size() + 1);
+        for (std::size_t pos = 0; pos < path_.length(); ++pos) {
+            if (path_[pos] == '/')
+                seg_start_.push_back(pos + 1);
+        }
+        // the end of the last segment
+        seg_start_.push_back(path_.length() + 1);
+    }
+
+    /// @return the number of path segments
+    [[nodiscard]] size_type size() const noexcept {
+        return seg_start_.empty() ? 0 : seg_start_.size() - 1;
+    }
+    /// @return `true` if there are no path segments
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// @param[in] ind the index of the segment, must be less than size()
+    /// @return the path segment
+    [[nodiscard]] std::string_view operator[](size_type ind) const noexcept {
+        return path_.substr(seg_start_[ind], seg_start_[ind + 1] - seg_start_[ind] - 1);
+    }
+
+private:
+    std::string_view path_;
+    // the start offsets of the segments and the end of the path plus one
+    std::vector<std::size_t> seg_start_;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_PATH_SEGMENTS_H
@@ -12,6 +12,7 @@
 
 #include "config.h" // IWYU pragma: export
 #include "str_arg.h"
+#include "url_stats.h"
 #include "url_utf.h"
 #include "util.h"
 #include <array>
@@ -405,6 +406,7 @@ constexpr bool decode_hex_to_byte(const CharT*& first, const CharT* last, unsign
 // See: https://url.spec.whatwg.org/#percent-encode
 
 UPA_CONSTEXPR_20 void append_percent_encoded_byte(unsigned char uc, std::string& output) {
+    UPA_STATS_PCT_ENCODED();
     output.push_back('%');
     output.push_back(kHexCharLookup[uc >> 4]);
     output.push_back(kHexCharLookup[uc & 0xf]);
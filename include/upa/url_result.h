@@ -85,6 +85,8 @@ enum class validation_errc {
     file_url_invalid_unc,           ///< Invalid UNC path in file URL
     file_url_not_windows_path,      ///< Not a Windows path in file URL
     null_character,                 ///< Path contains null character
+    // url::from_record errors
+    invalid_record,                 ///< Invalid or unsupported binary URL record
 };
 
 /// @brief Check validation error code indicates success
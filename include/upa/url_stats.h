@@ -0,0 +1,200 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_STATS_H
+#define UPA_URL_STATS_H
+
+#include "config.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#ifdef UPA_ENABLE_STATS
+# include <atomic>
+# include <type_traits> // is_constant_evaluated
+#endif
+
+namespace upa {
+
+/// @brief URL parser statistics
+///
+/// The counters are collected only if the library and the code using it are
+/// compiled with the `UPA_ENABLE_STATS` macro defined (see the CMake option of
+/// the same name). Otherwise the instrumentation compiles to nothing and all
+/// counters are zero.
+///
+/// Each thread updates its own counters without synchronization; they are
+/// summed up on demand by url_stats::snapshot().
+///
+/// @par Example
+/// @code
+/// upa::url_stats::reset();
+/// // ... parse URLs ...
+/// std::cout << upa::url_stats::snapshot();
+/// @endcode
+struct url_stats {
+    std::uint64_t urls_parsed = 0;          ///< number of URL parser invocations (the setters are not included)
+    std::uint64_t bytes_parsed = 0;         ///< total length of the parsed inputs in code units
+    std::uint64_t whitespace_removals = 0;  ///< number of inputs with ASCII tab or newline removed
+    std::uint64_t idna_ascii = 0;           ///< number of IDNA invocations on ASCII input (ASCII domains without `xn--` labels bypass IDNA)
+    std::uint64_t idna_non_ascii = 0;       ///< number of IDNA invocations on non-ASCII or percent-encoded input
+    std::uint64_t pct_encoded_userinfo = 0; ///< number of percent-encoded bytes in username and password
+    std::uint64_t pct_encoded_host = 0;     ///< number of percent-encoded bytes in opaque host
+    std::uint64_t pct_encoded_path = 0;     ///< number of percent-encoded bytes in path
+    std::uint64_t pct_encoded_query = 0;    ///< number of percent-encoded bytes in query
+    std::uint64_t pct_encoded_fragment = 0; ///< number of percent-encoded bytes in fragment
+    std::uint64_t path_shortenings = 0;     ///< number of path's last segment removals (for "..")
+    std::uint64_t ipv4_hosts = 0;           ///< number of parsed IPv4 hosts
+    std::uint64_t ipv6_hosts = 0;           ///< number of parsed IPv6 hosts
+    std::uint64_t setter_calls = 0;         ///< number of URL setter invocations
+
+    /// `true` if the library is compiled with statistics
+#ifdef UPA_ENABLE_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /// @brief Sums up the counters of all threads
+    ///
+    /// The counters of the finished threads are included.
+    ///
+    /// @return counters accumulated since the start of the program or since
+    ///   the last reset() call
+    [[nodiscard]] UPA_API static url_stats snapshot();
+
+    /// @brief Resets the counters to zero
+    ///
+    /// The counters of the other threads are not modified, so the subsequent
+    /// snapshot() calls return differences from the values at the reset time.
+    UPA_API static void reset();
+};
+
+/// @brief Outputs all counters, one `name: value` per line
+///
+/// @param[in] os output stream
+/// @param[in] stats statistics to output
+/// @return reference to the output stream
+UPA_API std::ostream& operator<<(std::ostream& os, const url_stats& stats);
+
+
+namespace detail {
+
+// The per thread counters; the order must match the url_stats fields
+enum stats_id : std::size_t {
+    stats_urls_parsed,
+    stats_bytes_parsed,
+    stats_whitespace_removals,
+    stats_idna_ascii,
+    stats_idna_non_ascii,
+    stats_pct_encoded_userinfo,
+    stats_pct_encoded_host,
+    stats_pct_encoded_path,
+    stats_pct_encoded_query,
+    stats_pct_encoded_fragment,
+    stats_path_shortenings,
+    stats_ipv4_hosts,
+    stats_ipv6_hosts,
+    stats_setter_calls,
+    stats_count,
+    // the percent-encoded bytes outside of the URL parser go here
+    stats_pct_encoded_other = stats_count
+};
+
+static_assert(sizeof(url_stats) == stats_count * sizeof(std::uint64_t),
+    "stats_id must match the url_stats fields");
+
+#ifdef UPA_ENABLE_STATS
+
+class stats_counters {
+public:
+    UPA_API stats_counters();
+    UPA_API ~stats_counters();
+
+    stats_counters(const stats_counters&) = delete;
+    stats_counters& operator=(const stats_counters&) = delete;
+
+    // Only the owning thread modifies the counters, so the increment does
+    // not need an atomic read-modify-write operation
+    void add(stats_id id, std::uint64_t n) noexcept {
+        auto& value = values_[id];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void add_pct_encoded() noexcept {
+        add(pct_id_, 1);
+    }
+
+    [[nodiscard]] std::uint64_t get(stats_id id) const noexcept {
+        return values_[id].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] stats_id pct_id() const noexcept {
+        return pct_id_;
+    }
+
+    void set_pct_id(stats_id id) noexcept {
+        pct_id_ = id;
+    }
+
+private:
+    std::atomic<std::uint64_t> values_[stats_count + 1] = {};
+    // counter of the percent-encoded bytes in the current URL component
+    stats_id pct_id_ = stats_pct_encoded_other;
+};
+
+inline stats_counters& local_stats() noexcept {
+    static thread_local stats_counters counters;
+    return counters;
+}
+
+// Selects the counter of the percent-encoded bytes until the end of scope
+class stats_component_scope {
+public:
+    explicit stats_component_scope(stats_id id) noexcept
+        : prev_id_(local_stats().pct_id())
+    {
+        local_stats().set_pct_id(id);
+    }
+    ~stats_component_scope() {
+        local_stats().set_pct_id(prev_id_);
+    }
+
+    stats_component_scope(const stats_component_scope&) = delete;
+    stats_component_scope& operator=(const stats_component_scope&) = delete;
+
+private:
+    stats_id prev_id_;
+};
+
+#endif // UPA_ENABLE_STATS
+
+} // namespace detail
+} // namespace upa
+
+// Instrumentation macros
+
+// NOLINTBEGIN(*-macro-*)
+
+#ifdef UPA_ENABLE_STATS
+# define UPA_STATS_ADD(id, n) ::upa::detail::local_stats().add(::upa::detail::stats_##id, (n))
+# define UPA_STATS_INC(id) UPA_STATS_ADD(id, 1)
+# define UPA_STATS_COMPONENT(id) \
+    const ::upa::detail::stats_component_scope upa_stats_component_scope_{ ::upa::detail::stats_##id }
+# ifdef UPA_CPP_20
+#  define UPA_STATS_PCT_ENCODED() \
+    do { if (!std::is_constant_evaluated()) ::upa::detail::local_stats().add_pct_encoded(); } while (false)
+# else
+#  define UPA_STATS_PCT_ENCODED() ::upa::detail::local_stats().add_pct_encoded()
+# endif
+#else
+# define UPA_STATS_ADD(id, n) static_cast<void>(0)
+# define UPA_STATS_INC(id) static_cast<void>(0)
+# define UPA_STATS_COMPONENT(id) static_cast<void>(0)
+# define UPA_STATS_PCT_ENCODED() static_cast<void>(0)
+#endif
+
+// NOLINTEND(*-macro-*)
+
+#endif // UPA_URL_STATS_H
@@ -0,0 +1,105 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_STREAM_PARSER_H
+#define UPA_URL_STREAM_PARSER_H
+
+#include "url.h"
+#include <string>
+#include <string_view>
+
+namespace upa {
+
+/// @brief Parses the URL from input that arrives in chunks
+///
+/// Useful when the URL (for example, HTTP request-target) is received in
+/// pieces from the network. The result of url_stream_parser::finish is the
+/// same as the result of the one-shot url::parse of all the chunks
+/// concatenated.
+///
+/// The URL before the query or fragment (scheme, authority and path) is
+/// collected into a small buffer and is parsed as soon as the start of the
+/// query (`?`) or fragment (`#`) arrives, so an invalid URL is rejected
+/// before the rest of it is received. Then the query and fragment chunks are
+/// percent-encoded directly into the URL, without collecting them into
+/// an intermediate buffer. The incomplete UTF-8 sequence and the trailing C0
+/// controls and spaces at the end of a chunk are kept until the next chunk
+/// or url_stream_parser::finish.
+///
+/// @par Example
+/// @code
+/// const upa::url base{ "http://example.org" };
+/// upa::url_stream_parser parser{ &base };
+/// parser.push("/search?q=");
+/// parser.push("%E2%82%AC");
+/// upa::url url;
+/// if (upa::success(parser.finish(url)))
+///     std::cout << url.href() << '\n';
+/// @endcode
+class url_stream_parser {
+public:
+    /// @brief Constructs the parser
+    ///
+    /// @param[in] base pointer to the base URL, may be `nullptr`; it must
+    ///   outlive the parsing
+    explicit url_stream_parser(const url* base = nullptr) noexcept
+        : base_(base)
+    {}
+
+    /// @brief Resets the parser to parse a new URL
+    ///
+    /// @param[in] base pointer to the base URL, may be `nullptr`
+    UPA_API void reset(const url* base = nullptr);
+
+    /// @brief Pushes the next chunk of the input
+    ///
+    /// @param[in] chunk the next chunk of the input
+    /// @return `false` if the input is already known to be an invalid URL;
+    ///   then the remaining chunks can be ignored
+    UPA_API bool push(std::string_view chunk);
+
+    /// @brief Finishes parsing when all chunks are pushed
+    ///
+    /// On success the parsed URL is moved to @a output. After this call the
+    /// parser is reset and can be used to parse a new URL with the same base.
+    ///
+    /// @param[out] output the parsed URL
+    /// @return error code (@a validation_errc::ok on success)
+    UPA_API validation_errc finish(url& output);
+
+    /// @return `true` if the input is already known to be an invalid URL
+    [[nodiscard]] bool failed() const noexcept {
+        return state_ == state::failed;
+    }
+
+private:
+    enum class state {
+        prefix,     // collecting the URL before the query or fragment
+        query,      // streaming the query
+        fragment,   // streaming the fragment
+        failed
+    };
+
+    void start_tail(char delimiter);
+    void append_tail(const char* first, const char* last);
+    void encode_tail(const char* first, const char* last);
+    void complete_pending_utf8(const char*& first, const char* last);
+    void encode(const char* first, const char* last);
+
+    const url* base_ = nullptr;
+    state state_ = state::prefix;
+    validation_errc error_ = validation_errc::ok;
+    url url_;
+    // the URL before the query or fragment
+    std::string prefix_;
+    // incomplete UTF-8 sequence at the end of the last chunk
+    std::string pending_utf8_;
+    // C0 controls and spaces at the end of the last chunk
+    std::string pending_trim_;
+};
+
+} // namespace upa
+
+#endif // UPA_URL_STREAM_PARSER_H
@@ -0,0 +1,417 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef UPA_URL_TABLE_H
+#define UPA_URL_TABLE_H
+
+#include "mapped_file.h"
+#include "url.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace upa {
+
+/// @brief Columnar table of parsed URLs
+///
+/// Stores serialized URLs in one contiguous character arena, and the URL
+/// records (offsets of the URL parts and flags) in the separate arrays
+/// (columns) - one array per url::PartType. So the overhead per URL is about
+/// 56 bytes and there is no heap allocation per URL. It is suitable for the
+/// bulk analytics, where the single components (for example host or path)
+/// of many URLs are scanned.
+///
+/// The table can be saved to a file, and loaded from it using memory mapping
+/// (see save(), load()).
+///
+/// @par Example
+/// @code
+/// upa::url_table table;
+/// table.append_parse(inputs.begin(), inputs.end());
+/// for (auto host : table.get_column(upa::url::HOST))
+///     ++host_count[host];
+/// @endcode
+class url_table {
+    using offset_type = std::uint32_t;
+    static constexpr int kHrefColumn = url::PART_COUNT;
+    static constexpr std::size_t kMinRowsPerThread = 1024;
+public:
+    using size_type = std::size_t;
+
+    class column;
+
+    /// @brief Default constructor
+    ///
+    /// Constructs an empty table.
+    url_table() = default;
+
+    /// @brief Move constructor
+    url_table(url_table&&) noexcept = default;
+
+    /// @brief Move assignment
+    url_table& operator=(url_table&&) noexcept = default;
+
+    url_table(const url_table&) = delete;
+    url_table& operator=(const url_table&) = delete;
+
+    /// @return the number of URLs in the table
+    [[nodiscard]] size_type size() const noexcept {
+        return row_end_.size();
+    }
+
+    /// @return `true` if table is empty
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// @return the total length of the serialized URLs
+    [[nodiscard]] std::size_t chars_size() const noexcept {
+        return chars_.size();
+    }
+
+    /// @return the number of bytes of heap memory used by the table (the
+    ///   memory-mapped file is not included)
+    [[nodiscard]] UPA_API std::size_t memory_size() const noexcept;
+
+    /// @brief Removes all URLs from the table
+    UPA_API void clear() noexcept;
+
+    /// @brief Reserves storage
+    ///
+    /// @param[in] rows  the number of URLs
+    /// @param[in] chars the total length of the serialized URLs
+    UPA_API void reserve(size_type rows, std::size_t chars);
+
+    // Append
+
+    /// @brief Appends the URL to the table
+    ///
+    /// @param[in] u URL to append
+    /// @return `true` on success; `false` if URL is not valid or is too long (its
+    ///   length exceeds 4 GiB)
+    UPA_API bool push_back(const url& u);
+
+    /// @brief Parses given URL string against base URL and appends it to the table
+    ///
+    /// @param[in] str_url URL string to parse
+    /// @param[in] base    pointer to base URL, may be nullptr
+    /// @return error code (@a validation_errc::ok on success, @a validation_errc::overflow
+    ///   if URL is too long)
+    template <class StrT, enable_if_str_arg_t<StrT> = 0>
+    validation_errc append_parse(const StrT& str_url, const url* base = nullptr) {
+        url u;
+        const auto res = u.parse(str_url, base);
+        if (res != validation_errc::ok)
+            return res;
+        return push_back(u) ? validation_errc::ok : validation_errc::overflow;
+    }
+
+    /// @brief Parses URL strings in parallel and appends them to the table
+    ///
+    /// The input range is split into contiguous chunks, which are parsed in the
+    /// separate threads. The parsed URLs are appended in the input order. The
+    /// input strings that fail to parse are skipped.
+    ///
+    /// @param[in] first,last   random access iterators to the URL strings to parse
+    /// @param[in] base         pointer to base URL, may be nullptr
+    /// @param[in] thread_count the maximum number of threads to use; if 0, then the
+    ///   `std::thread::hardware_concurrency()` is used
+    /// @return the number of appended URLs
+    template <class RandomIt>
+    std::size_t append_parse(RandomIt first, RandomIt last, const url* base = nullptr,
+        unsigned thread_count = 0);
+
+    /// @brief Appends all URLs of the other table
+    ///
+    /// @param[in] other table to append
+    UPA_API void append(const url_table& other);
+
+    // Row access
+
+    /// @param[in] row zero-based URL index
+    /// @return serialized URL
+    [[nodiscard]] std::string_view href(size_type row) const noexcept {
+        const std::size_t b = row_start(row);
+        return { chars_.data() + b, static_cast<std::size_t>(row_end_[row] - b) };
+    }
+
+    /// @brief Gets URL's part (URL record member) as string
+    ///
+    /// Equivalent to the url::get_part_view() of the URL in the @a row.
+    ///
+    /// @param[in] row zero-based URL index
+    /// @param[in] t   URL's part
+    /// @return URL's part string; it is empty if part is empty or null
+    [[nodiscard]] std::string_view get_part_view(size_type row, url::PartType t) const noexcept {
+        return get_view(row, t);
+    }
+
+    /// @param[in] row zero-based URL index
+    /// @param[in] t   URL's part
+    /// @return `true` if URL's part @a t is null
+    [[nodiscard]] bool is_null(size_type row, url::PartType t) const noexcept {
+        return !(flags_[row] & (1u << t));
+    }
+
+    /// @param[in] row zero-based URL index
+    /// @return URL's host type; it is valid if host is not null
+    [[nodiscard]] HostType host_type(size_type row) const noexcept {
+        return static_cast<HostType>((flags_[row] & url::HOST_TYPE_MASK) >> url::HOST_TYPE_SHIFT);
+    }
+
+    /// @param[in] row zero-based URL index
+    /// @return `true` if URL's path is opaque
+    [[nodiscard]] bool has_opaque_path(size_type row) const noexcept {
+        return !!(flags_[row] & url::OPAQUE_PATH_FLAG);
+    }
+
+    /// @brief Creates the URL object from the @a row
+    ///
+    /// The URL parser is not used.
+    ///
+    /// @param[in] row zero-based URL index
+    /// @return URL
+    [[nodiscard]] UPA_API url get_url(size_type row) const;
+
+    // Columns
+
+    /// @brief Gets the column of URL's part
+    ///
+    /// @param[in] t URL's part
+    /// @return random access range of the URL's part strings (`std::string_view`)
+    [[nodiscard]] column get_column(url::PartType t) const noexcept UPA_LIFETIMEBOUND;
+
+    /// @brief Gets the column of serialized URLs
+    ///
+    /// @return random access range of the serialized URLs (`std::string_view`)
+    [[nodiscard]] column hrefs() const noexcept UPA_LIFETIMEBOUND;
+
+    // File
+
+    /// @brief Saves the table to a file
+    ///
+    /// The file uses the native byte order, so it can be loaded on the
+    /// platforms with the same byte order only.
+    ///
+    /// @param[in] path path of the file to write
+    /// @return `true` on success
+    UPA_API bool save(const std::filesystem::path& path) const;
+
+    /// @brief Loads the table from a file saved by save()
+    ///
+    /// The file is memory-mapped, the table columns refer to it, and only the
+    /// offsets columns are validated. The table is copied to the heap memory
+    /// before the first modification.
+    ///
+    /// @param[in] path path of the file to load
+    /// @return `true` on success; on failure the table is empty
+    UPA_API bool load(const std::filesystem::path& path);
+
+    /// @return `true` if table refers to the memory-mapped file
+    [[nodiscard]] bool is_mapped() const noexcept {
+        return file_.is_open();
+    }
+
+private:
+    [[nodiscard]] std::size_t row_start(size_type row) const noexcept {
+        return row == 0 ? 0 : static_cast<std::size_t>(row_end_[row - 1]);
+    }
+
+    [[nodiscard]] std::string_view get_view(size_type row, int col) const noexcept {
+        const std::size_t start = row_start(row);
+        if (col == kHrefColumn)
+            return { chars_.data() + start, static_cast<std::size_t>(row_end_[row] - start) };
+        // begin & end offsets; see url::get_part_view
+        const std::size_t b = col == url::SCHEME ? 0
+            : part_end_[col - 1][row] + detail::kPartStart[col];
+        const std::size_t e = part_end_[col][row];
+        return { chars_.data() + start + b, e > b ? e - b : 0 };
+    }
+
+    // make table's storage owned (not memory-mapped)
+    void detach();
+
+    detail::pod_array<char> chars_;
+    detail::pod_array<std::uint64_t> row_end_;
+    std::array<detail::pod_array<offset_type>, url::PART_COUNT> part_end_;
+    detail::pod_array<std::uint32_t> flags_;
+    mapped_file file_;
+};
+
+
+/// @brief Column of the url_table
+///
+/// The random access range of the `std::string_view` values of one URL part (or
+/// of the serialized URLs) of all rows of the table. The values are valid until
+/// the table is modified.
+class url_table::column {
+public:
+    /// @brief Column iterator
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        const_iterator() noexcept = default;
+
+        reference operator*() const noexcept { return table_->get_view(row_, col_); }
+        reference operator[](difference_type n) const noexcept {
+            return table_->get_view(row_ + n, col_);
+        }
+
+        const_iterator& operator++() noexcept { ++row_; return *this; }
+        const_iterator operator++(int) noexcept { auto tmp = *this; ++row_; return tmp; }
+        const_iterator& operator--() noexcept { --row_; return *this; }
+        const_iterator operator--(int) noexcept { auto tmp = *this; --row_; return tmp; }
+        const_iterator& operator+=(difference_type n) noexcept { row_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) noexcept { row_ -= n; return *this; }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.row_) - static_cast<difference_type>(rhs.row_);
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ == rhs.row_; }
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ != rhs.row_; }
+        friend bool operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ < rhs.row_; }
+        friend bool operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ > rhs.row_; }
+        friend bool operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ <= rhs.row_; }
+        friend bool operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs.row_ >= rhs.row_; }
+
+    private:
+        const_iterator(const url_table* table, size_type row, int col) noexcept
+            : table_(table), row_(row), col_(col) {}
+
+        const url_table* table_ = nullptr;
+        size_type row_ = 0;
+        int col_ = 0;
+
+        friend class column;
+    };
+    using iterator = const_iterator;
+    using value_type = std::string_view;
+    using size_type = url_table::size_type;
+
+    /// @return the number of values (table rows)
+    [[nodiscard]] size_type size() const noexcept { return table_->size(); }
+    /// @return `true` if column is empty
+    [[nodiscard]] bool empty() const noexcept { return table_->empty(); }
+    /// @return the value in the @a row
+    [[nodiscard]] std::string_view operator[](size_type row) const noexcept {
+        return table_->get_view(row, col_);
+    }
+
+    /// @return iterator to the first value
+    [[nodiscard]] const_iterator begin() const noexcept { return { table_, 0, col_ }; }
+    /// @return iterator after the last value
+    [[nodiscard]] const_iterator end() const noexcept { return { table_, table_->size(), col_ }; }
+
+private:
+    column(const url_table* table, int col) noexcept
+        : table_(table), col_(col) {}
+
+    const url_table* table_;
+    int col_;
+
+    friend class url_table;
+};
+
+inline url_table::column url_table::get_column(url::PartType t) const noexcept UPA_LIFETIMEBOUND {
+    return { this, t };
+}
+
+inline url_table::column url_table::hrefs() const noexcept UPA_LIFETIMEBOUND {
+    return { this, kHrefColumn };
+}
+
+template <class RandomIt>
+inline std::size_t url_table::append_parse(RandomIt first, RandomIt last, const url* base,
+    unsigned thread_count)
+{
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count = static_cast<unsigned>(std::min<std::size_t>(thread_count,
+        count / kMinRowsPerThread + 1));
+
+    const auto parse_chunk = [base](RandomIt it, RandomIt end, url_table& table) {
+        url u;
+        for (; it != end; ++it) {
+            if (u.parse(*it, base) == validation_errc::ok)
+                table.push_back(u);
+        }
+    };
+
+    const std::size_t old_size = size();
+    if (thread_count <= 1) {
+        parse_chunk(first, last, *this);
+        return size() - old_size;
+    }
+
+    // parse chunks in parallel
+    const std::size_t chunk_size = (count + thread_count - 1) / thread_count;
+    std::vector<url_table> tables(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    // joins the started threads, also if starting a thread throws
+    struct thread_joiner {
+        std::vector<std::thread>& threads;
+        ~thread_joiner() {
+            for (auto& thread : threads) {
+                if (thread.joinable())
+                    thread.join();
+            }
+        }
+    } joiner{ threads };
+    for (unsigned ind = 0; ind < thread_count; ++ind) {
+        const std::size_t b = std::min(ind * chunk_size, count);
+        const std::size_t e = std::min(b + chunk_size, count);
+        threads.emplace_back([&, ind, b, e]() {
+            try {
+                parse_chunk(first + b, first + e, tables[ind]);
+            } catch (...) {
+                errors[ind] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (const auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // append results in the input order
+    std::size_t rows = 0;
+    std::size_t chars = 0;
+    for (const auto& table : tables) {
+        rows += table.size();
+        chars += table.chars_size();
+    }
+    reserve(old_size + rows, chars_size() + chars);
+    for (const auto& table : tables)
+        append(table);
+    return size() - old_size;
+}
+
+} // namespace upa
+
+#endif // UPA_URL_TABLE_H
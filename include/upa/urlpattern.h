@@ -9,9 +9,13 @@
 #include "unicode_id.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <charconv>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -148,6 +152,10 @@ constexpr bool is_regex_engine_v =
 // https://urlpattern.spec.whatwg.org/#urlpattern-class
 // https://urlpattern.spec.whatwg.org/#dictdef-urlpatterninit
 
+namespace pattern {
+class init_canonicalizer;
+} // namespace pattern
+
 /// @brief URLPatternInit struct
 ///
 /// This struct represents the URLPatternInit dictionary as specified in
@@ -198,6 +206,43 @@ struct urlpattern_init {
         get_member(std::string_view name);
 };
 
+/// @brief Reusable scratch context for matching `upa::urlpattern_init` inputs
+///
+/// The `upa::urlpattern`'s `test` and `exec` functions which accept this context, canonicalize
+/// the input components into the context's buffers instead of new strings. When the context is
+/// reused, then its buffers have enough capacity, and testing the input usually does not
+/// allocate memory.
+///
+/// The context can not be used by multiple threads at the same time.
+class urlpattern_exec_context {
+public:
+    /// The number of the URL components
+    static constexpr std::size_t component_count = 8;
+
+    urlpattern_exec_context() = default;
+
+    /// @brief Canonical component of the last input
+    ///
+    /// @param[in] index component index: 0 - protocol, 1 - username, 2 - password, 3 - hostname,
+    ///   4 - port, 5 - pathname, 6 - search, 7 - hash
+    /// @return canonical component; it is valid until the next use of the context
+    [[nodiscard]] std::string_view component(std::size_t index) const noexcept {
+        assert(index < component_count);
+        return std::string_view{ buffer_ }.substr(start_[index], start_[index + 1] - start_[index]);
+    }
+
+private:
+    friend class pattern::init_canonicalizer;
+
+    // the canonical components one after another
+    std::string buffer_;
+    std::size_t start_[component_count + 1] = {}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    // the base URL
+    upa::url base_url_;
+    // the pathname resolved against the base URL
+    std::string pathname_;
+};
+
 namespace pattern {
 
 // 1.6. Constructor string parsing
@@ -389,6 +434,7 @@ inline std::string canonicalize_port(std::string_view port_value) {
     return canonicalize_port(port_value, std::nullopt);
 }
 inline std::string canonicalize_pathname(std::string_view value);
+inline void append_canonical_pathname(std::string_view value, std::string& output);
 inline std::string canonicalize_opaque_pathname(std::string_view value);
 inline std::string canonicalize_search(std::string_view value);
 inline std::string canonicalize_hash(std::string_view value);
@@ -400,6 +446,14 @@ enum class urlpattern_init_type { PATTERN, URL };
 
 inline urlpattern_init process_urlpattern_init(const urlpattern_init& init, urlpattern_init_type type, bool set_empty);
 
+// Processes the URLPatternInit of the "url" type into the context buffers; this
+// is the same as process_urlpattern_init(init, urlpattern_init_type::URL, true)
+class init_canonicalizer {
+public:
+    // returns `false` on failure
+    static bool process(const urlpattern_init& init, urlpattern_exec_context& ctx);
+};
+
 
 ///////////////////////////////////////////////////////////////////////
 
@@ -424,6 +478,9 @@ struct component {
     regex_engine regular_expression_;
     string_list group_name_list_;
     bool has_regexp_groups_ = false;
+    // the id of the pool of the interned component and its index in the pool
+    std::uint64_t pool_id_ = 0;
+    std::size_t pool_index_ = 0;
 };
 
 // 1.5. Internals
@@ -431,6 +488,12 @@ struct component {
 
 // ....
 
+// The unique id of the components pool
+inline std::uint64_t new_component_pool_id() noexcept {
+    static std::atomic<std::uint64_t> last_id{ 0 };
+    return ++last_id;
+}
+
 // https://urlpattern.spec.whatwg.org/#default-options
 // The default options is an options struct with delimiter code point set to the empty string and
 // prefix code point set to the empty string.
@@ -575,6 +638,120 @@ struct urlpattern_result_and_inputs : public urlpattern_result {
     urlpattern_inputs inputs;
 };
 
+/// @brief Pool of the compiled URL pattern components
+///
+/// The URL patterns constructed with the same pool share the identical components, i.e.
+/// components compiled from the same pattern string with the same options. In a large pattern
+/// set, such as a route table, most of the protocol, username, password, port, search and hash
+/// components are identical (`*` or `https`), so sharing them reduces memory use and
+/// construction time. In addition, `upa::urlpattern_component_cache` can be used to evaluate
+/// each shared component only once per input URL.
+///
+/// The pool is not thread-safe. The constructed URL patterns do not depend on the pool
+/// lifetime.
+///
+/// Example:
+/// @code
+/// upa::urlpattern_component_pool<upa::regex_engine_srell> pool;
+/// std::vector<urlpattern> routes;
+/// routes.emplace_back("https://example.com/books/:id", upa::urlpattern_options{}, pool);
+/// routes.emplace_back("https://example.com/authors/:id", upa::urlpattern_options{}, pool);
+/// @endcode
+///
+/// @tparam regex_engine Regular expression engine type
+template <class regex_engine>
+class urlpattern_component_pool {
+public:
+    using component_type = pattern::component<regex_engine>;
+    using component_ptr = std::shared_ptr<const component_type>;
+
+    urlpattern_component_pool() = default;
+    urlpattern_component_pool(const urlpattern_component_pool&) = delete;
+    urlpattern_component_pool& operator=(const urlpattern_component_pool&) = delete;
+    ~urlpattern_component_pool() = default;
+
+    /// @brief Gets the compiled component
+    ///
+    /// Compiles the component, if the pool does not contain the identical one.
+    /// Throws an `upa::urlpattern_error` exception if the @a input is invalid.
+    ///
+    /// @param[in] input pattern string
+    /// @param[in] encoding_cb encoding callback
+    /// @param[in] opt compile options
+    /// @return shared compiled component
+    [[nodiscard]] component_ptr get(std::string_view input, pattern::encoding_callback encoding_cb,
+        const pattern::options& opt);
+
+    /// @return the number of distinct components in the pool
+    [[nodiscard]] std::size_t size() const noexcept { return components_.size(); }
+
+    /// @brief Removes all components from the pool
+    ///
+    /// The components remain valid while they are used by URL patterns.
+    void clear() noexcept { components_.clear(); }
+
+private:
+    template <class> friend class urlpattern_component_cache;
+
+    std::uint64_t id_ = pattern::new_component_pool_id();
+    std::unordered_map<std::string, component_ptr> components_;
+    // the buffer for the lookup key
+    std::string key_;
+    // the index of the next component
+    std::size_t next_index_ = 0;
+};
+
+/// @brief Results of the shared components evaluated for one input URL
+///
+/// It is used to test the same URL against many URL patterns constructed with the
+/// same `upa::urlpattern_component_pool`: each shared component is evaluated only once.
+/// The reset() function must be called before testing the next URL.
+///
+/// Example:
+/// @code
+/// upa::urlpattern_component_cache<upa::regex_engine_srell> cache(pool);
+/// for (const auto& url : urls) {
+///     cache.reset();
+///     for (const auto& route : routes) {
+///         if (route.test(url, cache))
+///             ...
+///     }
+/// }
+/// @endcode
+///
+/// @tparam regex_engine Regular expression engine type
+template <class regex_engine>
+class urlpattern_component_cache {
+public:
+    /// @brief Constructs the cache for the components of the @a pool
+    /// @param[in] pool components pool
+    explicit urlpattern_component_cache(const urlpattern_component_pool<regex_engine>& pool) noexcept
+        : pool_id_(pool.id_)
+    {}
+
+    /// @brief Forgets the results of the previous input URL
+    void reset() noexcept {
+        if (++epoch_ == 0) {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+private:
+    template <class, typename> friend class urlpattern;
+
+    // The number of URL components
+    static constexpr std::size_t kSlotCount = 8;
+
+    bool test(const pattern::component<regex_engine>& comp, std::size_t slot, std::string_view input);
+
+    std::uint64_t pool_id_;
+    // The result of the slot of the component is valid, if its stamp equals epoch_
+    std::vector<std::uint32_t> stamps_;
+    std::vector<bool> results_;
+    std::uint32_t epoch_ = 1;
+};
+
 /// @brief URL pattern class template
 ///
 /// It implemebts URLPattern class as specified in WHATWG URL Pattern specification:
@@ -633,6 +810,32 @@ class urlpattern {
     /// @param[in] opt optional `upa::urlpattern_options` struct
     urlpattern(const urlpattern_init& init = {}, urlpattern_options opt = {});
 
+    /// @brief Copy constructor
+    ///
+    /// The compiled components are immutable, so they are shared, not copied.
+    urlpattern(const urlpattern&) = default;
+
+    /// @brief Move constructor
+    ///
+    /// The same as the copy constructor: the moved-from URL pattern keeps its
+    /// shared components and stays usable.
+    urlpattern(urlpattern&& other) noexcept
+        : urlpattern(static_cast<const urlpattern&>(other)) {}
+
+    /// @brief Copy assignment operator
+    urlpattern& operator=(const urlpattern&) = default;
+
+    /// @brief Move assignment operator
+    ///
+    /// The same as the copy assignment: the moved-from URL pattern keeps its
+    /// shared components and stays usable.
+    urlpattern& operator=(urlpattern&& other) noexcept {
+        return *this = static_cast<const urlpattern&>(other);
+    }
+
+    /// @brief Destructor
+    ~urlpattern() = default;
+
     /// @brief Constructs urlpattern object from URL pattern string and optional base URL string
     ///
     /// The @a input is a URL string containing pattern syntax for one or more components. If
@@ -670,6 +873,46 @@ class urlpattern {
     urlpattern(const T& input, urlpattern_options opt = {})
         : urlpattern{ make_urlpattern_init(input, std::nullopt), opt } {}
 
+    /// @brief Constructs urlpattern object from `upa::urlpattern_init` object sharing components
+    ///
+    /// The same as `urlpattern(const urlpattern_init&, urlpattern_options)`, but the compiled
+    /// components are taken from the @a pool, or compiled and added to it.
+    ///
+    /// @param[in] init `upa::urlpattern_init` object
+    /// @param[in] opt `upa::urlpattern_options` struct
+    /// @param[in,out] pool components pool
+    urlpattern(const urlpattern_init& init, urlpattern_options opt,
+        urlpattern_component_pool<regex_engine>& pool)
+        : urlpattern{ init, opt, std::addressof(pool) } {}
+
+    /// @brief Constructs urlpattern object from URL pattern string and base URL string
+    ///   sharing components
+    ///
+    /// The same as `urlpattern(const T&, TB&&, urlpattern_options)`, but the compiled
+    /// components are taken from the @a pool, or compiled and added to it.
+    ///
+    /// @param[in] input URL pattern string
+    /// @param[in] base_url optional base URL string
+    /// @param[in] opt `upa::urlpattern_options` struct
+    /// @param[in,out] pool components pool
+    template <class T, class TB, upa::enable_if_str_arg_t<T> = 0,
+        upa::enable_if_optional_str_arg_t<TB> = 0>
+    urlpattern(const T& input, TB&& base_url, urlpattern_options opt,
+        urlpattern_component_pool<regex_engine>& pool)
+        : urlpattern{ make_urlpattern_init(input, std::forward<TB>(base_url)), opt, std::addressof(pool) } {}
+
+    /// @brief Constructs urlpattern object from URL pattern string sharing components
+    ///
+    /// The same as `urlpattern(const T&, urlpattern_options)`, but the compiled
+    /// components are taken from the @a pool, or compiled and added to it.
+    ///
+    /// @param[in] input URL pattern string
+    /// @param[in] opt `upa::urlpattern_options` struct
+    /// @param[in,out] pool components pool
+    template <class T, upa::enable_if_str_arg_t<T> = 0>
+    urlpattern(const T& input, urlpattern_options opt, urlpattern_component_pool<regex_engine>& pool)
+        : urlpattern{ make_urlpattern_init(input, std::nullopt), opt, std::addressof(pool) } {}
+
     /// @brief Test whether URL pattern matches the input
     ///
     /// The @a input is an object containing strings representing each URL component; e.g.
@@ -699,6 +942,30 @@ class urlpattern {
     ///   `false` otherwise
     [[nodiscard]] bool test(const upa::url& url) const;
 
+    /// @brief Test whether URL pattern matches the URL, using the cached results of the
+    ///   shared components
+    ///
+    /// The results of the components shared by the @a cache's pool are taken from the
+    /// @a cache, or evaluated and stored in it.
+    ///
+    /// @param[in] url URL to test
+    /// @param[in,out] cache results of the shared components for the @a url
+    /// @return `true` if URL pattern matches the @a url on a component-by-component basis,
+    ///   `false` otherwise
+    [[nodiscard]] bool test(const upa::url& url, urlpattern_component_cache<regex_engine>& cache) const;
+
+    /// @brief Test whether URL pattern matches the input, using the scratch context
+    ///
+    /// The same as `test(const urlpattern_init&)`, but the input components are canonicalized
+    /// into the @a ctx buffers. When the @a ctx is reused, testing usually does not allocate
+    /// memory.
+    ///
+    /// @param[in] input `upa::urlpattern_init` object
+    /// @param[in,out] ctx scratch context
+    /// @return `true` if URL pattern matches the @a input on a component-by-component basis,
+    ///   `false` otherwise
+    [[nodiscard]] bool test(const urlpattern_init& input, urlpattern_exec_context& ctx) const;
+
     /// @brief Executes the URL pattern against the input
     ///
     /// The @a input is an object containing strings representing each URL component; e.g.
@@ -732,6 +999,19 @@ class urlpattern {
         std::enable_if_t<std::is_base_of_v<urlpattern_result, ResT>, int> = 0>
     [[nodiscard]] std::optional<ResT> exec(const urlpattern_init& input) const;
 
+    /// @brief Executes the URL pattern against the input, using the scratch context
+    ///
+    /// The same as `exec(const urlpattern_init&)`, but the input components are canonicalized
+    /// into the @a ctx buffers. Memory is allocated only for the match result.
+    ///
+    /// @tparam ResT Result type, must be derived from `upa::urlpattern_result`
+    /// @param[in] input `upa::urlpattern_init` object
+    /// @param[in,out] ctx scratch context
+    /// @return match results; `std::nullopt` if no match
+    template <class ResT = urlpattern_result,
+        std::enable_if_t<std::is_base_of_v<urlpattern_result, ResT>, int> = 0>
+    [[nodiscard]] std::optional<ResT> exec(const urlpattern_init& input, urlpattern_exec_context& ctx) const;
+
     /// @brief Executes the URL pattern against the input URL string
     ///
     /// If @a base_url_str is provided, then @a input URL string can be relative.
@@ -805,6 +1085,14 @@ class urlpattern {
 
 private:
     using regex_exec_result = typename regex_engine::result;
+    using component_ptr = std::shared_ptr<const pattern::component<regex_engine>>;
+
+    urlpattern(const urlpattern_init& init, urlpattern_options opt,
+        urlpattern_component_pool<regex_engine>* pool);
+
+    // the components of the URL pattern constructed without the pool are
+    // allocated in one block
+    using component_block = std::array<pattern::component<regex_engine>, 8>;
 
     bool match_for_test(
         std::string_view protocol, std::string_view username, std::string_view password,
@@ -827,14 +1115,15 @@ class urlpattern {
 
     // The URL pattern struct
     // https://urlpattern.spec.whatwg.org/#url-pattern
-    pattern::component<regex_engine> protocol_component_;
-    pattern::component<regex_engine> username_component_;
-    pattern::component<regex_engine> password_component_;
-    pattern::component<regex_engine> hostname_component_;
-    pattern::component<regex_engine> port_component_;
-    pattern::component<regex_engine> pathname_component_;
-    pattern::component<regex_engine> search_component_;
-    pattern::component<regex_engine> hash_component_;
+    // The components are immutable and may be shared with other URL patterns.
+    component_ptr protocol_component_;
+    component_ptr username_component_;
+    component_ptr password_component_;
+    component_ptr hostname_component_;
+    component_ptr port_component_;
+    component_ptr pathname_component_;
+    component_ptr search_component_;
+    component_ptr hash_component_;
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -882,7 +1171,14 @@ inline urlpattern_init urlpattern<regex_engine, E>::make_urlpattern_init(const T
 }
 
 template <class regex_engine, typename E>
-inline urlpattern<regex_engine, E>::urlpattern(const urlpattern_init& init, urlpattern_options opt) {
+inline urlpattern<regex_engine, E>::urlpattern(const urlpattern_init& init, urlpattern_options opt)
+    : urlpattern{ init, opt, nullptr }
+{}
+
+template <class regex_engine, typename E>
+inline urlpattern<regex_engine, E>::urlpattern(const urlpattern_init& init, urlpattern_options opt,
+    urlpattern_component_pool<regex_engine>* pool)
+{
     using namespace std::string_view_literals;
 
     // Let processedInit be the result of process a URLPatternInit given init, "pattern",
@@ -907,75 +1203,89 @@ inline urlpattern<regex_engine, E>::urlpattern(const urlpattern_init& init, urlp
     if (pattern::is_special_scheme_default_port(*processed_init.protocol, *processed_init.port))
         processed_init.port = ""sv;
 
-    // component constructor performs `compile a component`
-    protocol_component_ = pattern::component<regex_engine>(*processed_init.protocol,
+    // compile_component performs `compile a component`, or takes the compiled
+    // component from the pool
+    std::shared_ptr<component_block> block;
+    if (pool == nullptr)
+        block = std::make_shared<component_block>();
+    std::size_t block_ind = 0;
+    const auto compile_component = [&](std::string_view input, pattern::encoding_callback encoding_cb,
+        const pattern::options& compile_opt) {
+        if (pool != nullptr)
+            return pool->get(input, encoding_cb, compile_opt);
+        auto& comp = (*block)[block_ind++];
+        comp = pattern::component<regex_engine>(input, encoding_cb, compile_opt);
+        return component_ptr(block, &comp);
+    };
+
+    protocol_component_ = compile_component(*processed_init.protocol,
         pattern::canonicalize_protocol, pattern::default_options);
-    username_component_ = pattern::component<regex_engine>(*processed_init.username,
+    username_component_ = compile_component(*processed_init.username,
         pattern::canonicalize_username, pattern::default_options);
-    password_component_ = pattern::component<regex_engine>(*processed_init.password,
+    password_component_ = compile_component(*processed_init.password,
         pattern::canonicalize_password, pattern::default_options);
 
     if (pattern::hostname_pattern_is_ipv6_address(*processed_init.hostname))
-        hostname_component_ = pattern::component<regex_engine>(*processed_init.hostname,
+        hostname_component_ = compile_component(*processed_init.hostname,
             pattern::canonicalize_ipv6_hostname, pattern::hostname_options);
     else
-        hostname_component_ = pattern::component<regex_engine>(*processed_init.hostname,
+        hostname_component_ = compile_component(*processed_init.hostname,
             pattern::canonicalize_hostname, pattern::hostname_options);
 
-    port_component_ = pattern::component<regex_engine>(*processed_init.port,
+    port_component_ = compile_component(*processed_init.port,
         pattern::canonicalize_port, pattern::default_options);
 
     // Let compileOptions be a copy of the default options with
     // the ignore case property set to options["ignoreCase"].
     const pattern::options compile_opt{ ""sv, ""sv, opt.ignore_case };
-    if (pattern::protocol_component_matches_special_scheme(protocol_component_)) {
+    if (pattern::protocol_component_matches_special_scheme(*protocol_component_)) {
         // pathname options
         // https://urlpattern.spec.whatwg.org/#pathname-options
         const pattern::options path_compile_opt{ "/"sv, "/"sv, opt.ignore_case };
-        pathname_component_ = pattern::component<regex_engine>(*processed_init.pathname,
+        pathname_component_ = compile_component(*processed_init.pathname,
             pattern::canonicalize_pathname, path_compile_opt);
     } else {
-        pathname_component_ = pattern::component<regex_engine>(*processed_init.pathname,
+        pathname_component_ = compile_component(*processed_init.pathname,
             pattern::canonicalize_opaque_pathname, compile_opt);
     }
-    search_component_ = pattern::component<regex_engine>(*processed_init.search,
+    search_component_ = compile_component(*processed_init.search,
         pattern::canonicalize_search, compile_opt);
-    hash_component_ = pattern::component<regex_engine>(*processed_init.hash,
+    hash_component_ = compile_component(*processed_init.hash,
         pattern::canonicalize_hash, compile_opt);
 }
 
 // https://urlpattern.spec.whatwg.org/#dom-urlpattern-protocol
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_protocol() const noexcept {
-    return protocol_component_.pattern_string_;
+    return protocol_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_username() const noexcept {
-    return username_component_.pattern_string_;
+    return username_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_password() const noexcept {
-    return password_component_.pattern_string_;
+    return password_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_hostname() const noexcept {
-    return hostname_component_.pattern_string_;
+    return hostname_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_port() const noexcept {
-    return port_component_.pattern_string_;
+    return port_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_pathname() const noexcept {
-    return pathname_component_.pattern_string_;
+    return pathname_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_search() const noexcept {
-    return search_component_.pattern_string_;
+    return search_component_->pattern_string_;
 }
 template <class regex_engine, typename E>
 inline std::string_view urlpattern<regex_engine, E>::get_hash() const noexcept {
-    return hash_component_.pattern_string_;
+    return hash_component_->pattern_string_;
 }
 
 // https://urlpattern.spec.whatwg.org/#dom-urlpattern-test
@@ -1018,6 +1328,20 @@ inline bool urlpattern<regex_engine, E>::test(const upa::url& url) const {
         url.get_part_view(upa::url::FRAGMENT));
 }
 
+template <class regex_engine, typename E>
+inline bool urlpattern<regex_engine, E>::test(const urlpattern_init& input, urlpattern_exec_context& ctx) const {
+    try {
+        if (!pattern::init_canonicalizer::process(input, ctx))
+            return false;
+    }
+    catch (std::exception&) {
+        return false;
+    }
+    return match_for_test(
+        ctx.component(0), ctx.component(1), ctx.component(2), ctx.component(3),
+        ctx.component(4), ctx.component(5), ctx.component(6), ctx.component(7));
+}
+
 template <class regex_engine, typename E>
 inline bool urlpattern<regex_engine, E>::match_for_test(
     std::string_view protocol, std::string_view username, std::string_view password,
@@ -1025,14 +1349,14 @@ inline bool urlpattern<regex_engine, E>::match_for_test(
     std::string_view search, std::string_view hash) const
 {
     return
-        protocol_component_.regular_expression_.test(protocol) &&
-        username_component_.regular_expression_.test(username) &&
-        password_component_.regular_expression_.test(password) &&
-        hostname_component_.regular_expression_.test(hostname) &&
-        port_component_.regular_expression_.test(port) &&
-        pathname_component_.regular_expression_.test(pathname) &&
-        search_component_.regular_expression_.test(search) &&
-        hash_component_.regular_expression_.test(hash);
+        protocol_component_->regular_expression_.test(protocol) &&
+        username_component_->regular_expression_.test(username) &&
+        password_component_->regular_expression_.test(password) &&
+        hostname_component_->regular_expression_.test(hostname) &&
+        port_component_->regular_expression_.test(port) &&
+        pathname_component_->regular_expression_.test(pathname) &&
+        search_component_->regular_expression_.test(search) &&
+        hash_component_->regular_expression_.test(hash);
 }
 
 // https://urlpattern.spec.whatwg.org/#dom-urlpattern-exec
@@ -1061,6 +1385,30 @@ inline std::optional<ResT> urlpattern<regex_engine, E>::exec(const urlpattern_in
     return result;
 }
 
+template <class regex_engine, typename E>
+template <class ResT, std::enable_if_t<std::is_base_of_v<urlpattern_result, ResT>, int>>
+inline std::optional<ResT> urlpattern<regex_engine, E>::exec(const urlpattern_init& input,
+    urlpattern_exec_context& ctx) const
+{
+    try {
+        if (!pattern::init_canonicalizer::process(input, ctx))
+            return std::nullopt;
+    }
+    catch (std::exception&) {
+        return std::nullopt;
+    }
+
+    auto result = match<ResT>(
+        ctx.component(0), ctx.component(1), ctx.component(2), ctx.component(3),
+        ctx.component(4), ctx.component(5), ctx.component(6), ctx.component(7));
+    if constexpr (pattern::has_inputs_v<ResT>) {
+        // Append input to inputs
+        if (result)
+            result->inputs = decltype(ResT::inputs){ input };
+    }
+    return result;
+}
+
 template <class regex_engine, typename E>
 template <class ResT, class T, class TB,
     std::enable_if_t<std::is_base_of_v<urlpattern_result, ResT>, int>,
@@ -1149,47 +1497,47 @@ inline std::optional<ResT> urlpattern<regex_engine, E>::match(
     // Let protocolExecResult be RegExpBuiltinExec(urlpattern's protocol component's
     // regular expression, protocol).
     regex_exec_result protocol_exec_result;
-    if (!protocol_component_.regular_expression_.exec(protocol, protocol_exec_result))
+    if (!protocol_component_->regular_expression_.exec(protocol, protocol_exec_result))
         return std::nullopt;
 
     regex_exec_result username_exec_result;
-    if (!username_component_.regular_expression_.exec(username, username_exec_result))
+    if (!username_component_->regular_expression_.exec(username, username_exec_result))
         return std::nullopt;
 
     regex_exec_result password_exec_result;
-    if (!password_component_.regular_expression_.exec(password, password_exec_result))
+    if (!password_component_->regular_expression_.exec(password, password_exec_result))
         return std::nullopt;
 
     regex_exec_result hostname_exec_result;
-    if (!hostname_component_.regular_expression_.exec(hostname, hostname_exec_result))
+    if (!hostname_component_->regular_expression_.exec(hostname, hostname_exec_result))
         return std::nullopt;
 
     regex_exec_result port_exec_result;
-    if (!port_component_.regular_expression_.exec(port, port_exec_result))
+    if (!port_component_->regular_expression_.exec(port, port_exec_result))
         return std::nullopt;
 
     regex_exec_result pathname_exec_result;
-    if (!pathname_component_.regular_expression_.exec(pathname, pathname_exec_result))
+    if (!pathname_component_->regular_expression_.exec(pathname, pathname_exec_result))
         return std::nullopt;
 
     regex_exec_result search_exec_result;
-    if (!search_component_.regular_expression_.exec(search, search_exec_result))
+    if (!search_component_->regular_expression_.exec(search, search_exec_result))
         return std::nullopt;
 
     regex_exec_result hash_exec_result;
-    if (!hash_component_.regular_expression_.exec(hash, hash_exec_result))
+    if (!hash_component_->regular_expression_.exec(hash, hash_exec_result))
         return std::nullopt;
 
     // Let result be a new URLPatternResult.
     ResT result;
-    result.protocol = create_component_match_result(protocol_component_, protocol, protocol_exec_result);
-    result.username = create_component_match_result(username_component_, username, username_exec_result);
-    result.password = create_component_match_result(password_component_, password, password_exec_result);
-    result.hostname = create_component_match_result(hostname_component_, hostname, hostname_exec_result);
-    result.port = create_component_match_result(port_component_, port, port_exec_result);
-    result.pathname = create_component_match_result(pathname_component_, pathname, pathname_exec_result);
-    result.search = create_component_match_result(search_component_, search, search_exec_result);
-    result.hash = create_component_match_result(hash_component_, hash, hash_exec_result);
+    result.protocol = create_component_match_result(*protocol_component_, protocol, protocol_exec_result);
+    result.username = create_component_match_result(*username_component_, username, username_exec_result);
+    result.password = create_component_match_result(*password_component_, password, password_exec_result);
+    result.hostname = create_component_match_result(*hostname_component_, hostname, hostname_exec_result);
+    result.port = create_component_match_result(*port_component_, port, port_exec_result);
+    result.pathname = create_component_match_result(*pathname_component_, pathname, pathname_exec_result);
+    result.search = create_component_match_result(*search_component_, search, search_exec_result);
+    result.hash = create_component_match_result(*hash_component_, hash, hash_exec_result);
 
     return result;
 }
@@ -1199,14 +1547,82 @@ inline std::optional<ResT> urlpattern<regex_engine, E>::match(
 template <class regex_engine, typename E>
 bool urlpattern<regex_engine, E>::has_regexp_groups() const noexcept {
     return
-        protocol_component_.has_regexp_groups_ ||
-        username_component_.has_regexp_groups_ ||
-        password_component_.has_regexp_groups_ ||
-        hostname_component_.has_regexp_groups_ ||
-        port_component_.has_regexp_groups_ ||
-        pathname_component_.has_regexp_groups_ ||
-        search_component_.has_regexp_groups_ ||
-        hash_component_.has_regexp_groups_;
+        protocol_component_->has_regexp_groups_ ||
+        username_component_->has_regexp_groups_ ||
+        password_component_->has_regexp_groups_ ||
+        hostname_component_->has_regexp_groups_ ||
+        port_component_->has_regexp_groups_ ||
+        pathname_component_->has_regexp_groups_ ||
+        search_component_->has_regexp_groups_ ||
+        hash_component_->has_regexp_groups_;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Sharing of the compiled components
+
+template <class regex_engine>
+inline auto urlpattern_component_pool<regex_engine>::get(std::string_view input,
+    pattern::encoding_callback encoding_cb, const pattern::options& opt) -> component_ptr
+{
+    // The key consists of the encoding callback, options and input
+    char cb_bytes[sizeof(encoding_cb)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::memcpy(cb_bytes, &encoding_cb, sizeof(encoding_cb));
+    key_.assign(cb_bytes, sizeof(cb_bytes));
+    key_.push_back(opt.ignore_case ? '1' : '0');
+    key_.append(opt.delimiter_code_point);
+    key_.push_back('\0');
+    key_.append(opt.prefix_code_point);
+    key_.push_back('\0');
+    key_.append(input);
+
+    const auto it = components_.find(key_);
+    if (it != components_.end())
+        return it->second;
+
+    auto comp = std::make_shared<component_type>(input, encoding_cb, opt);
+    comp->pool_id_ = id_;
+    comp->pool_index_ = next_index_++;
+    return components_.emplace(key_, std::move(comp)).first->second;
+}
+
+template <class regex_engine>
+inline bool urlpattern_component_cache<regex_engine>::test(const pattern::component<regex_engine>& comp,
+    std::size_t slot, std::string_view input)
+{
+    // not shared component
+    if (comp.pool_id_ != pool_id_)
+        return comp.regular_expression_.test(input);
+
+    // The same component can be used for different URL components
+    const auto index = comp.pool_index_ * kSlotCount + slot;
+    if (index >= stamps_.size()) {
+        stamps_.resize(index + 1, 0);
+        results_.resize(index + 1);
+    } else if (stamps_[index] == epoch_) {
+        return results_[index];
+    }
+    const bool res = comp.regular_expression_.test(input);
+    stamps_[index] = epoch_;
+    results_[index] = res;
+    return res;
+}
+
+template <class regex_engine, typename E>
+inline bool urlpattern<regex_engine, E>::test(const upa::url& url,
+    urlpattern_component_cache<regex_engine>& cache) const
+{
+    if (!url.is_valid())
+        return false;
+
+    return
+        cache.test(*protocol_component_, 0, url.get_part_view(upa::url::SCHEME)) &&
+        cache.test(*username_component_, 1, url.get_part_view(upa::url::USERNAME)) &&
+        cache.test(*password_component_, 2, url.get_part_view(upa::url::PASSWORD)) &&
+        cache.test(*hostname_component_, 3, url.get_part_view(upa::url::HOST)) &&
+        cache.test(*port_component_, 4, url.get_part_view(upa::url::PORT)) &&
+        cache.test(*pathname_component_, 5, url.get_part_view(upa::url::PATH)) &&
+        cache.test(*search_component_, 6, url.get_part_view(upa::url::QUERY)) &&
+        cache.test(*hash_component_, 7, url.get_part_view(upa::url::FRAGMENT));
 }
 
 namespace pattern {
@@ -2420,6 +2836,14 @@ UPA_CONSTEXPR_20 void append_convert_modifier_to_string(std::string& result, par
 inline std::string canonicalize_protocol(std::string_view value) {
     if (value.empty()) return {};
 
+    // Fast path: if the value contains no ':', then the dummy URL is parsed
+    // successfully if and only if the value is a valid scheme
+    if (value.find(':') == std::string_view::npos) {
+        std::string result;
+        if (upa::success(upa::canonicalize_scheme(value, result)))
+            return result;
+    }
+
     // * Let parseResult (res_url) be the result of running the basic URL parser given
     //   value followed by "://dummy.invalid/".
     // HACK: To improve performance, we use "h" instead of "dummy.invalid".
@@ -2456,23 +2880,11 @@ inline std::string canonicalize_hostname(std::string_view value) {
     // * Let dummyURL be the result of creating a dummy URL.
     // * Let parseResult be the result of running the basic URL parser given value
     //   with dummyURL as url and hostname state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        urls.set_scheme("https");
-
-        const auto inp = upa::make_str_arg(value);
-        const auto parse_result = upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::hostname_state);
-
-        // TODO: Optimization possibility:
-        // Remove all ASCII tab or newline from input, find end of host  (:, /, ?, #) and then:
-        // const auto parse_result = upa::detail::url_parser::parse_host(urls, inp.begin(), inp.end());
-
-        if (!upa::success(parse_result))
-            throw urlpattern_error("canonicalize a hostname error");
-    }
-    return std::string{ dummy_url.get_part_view(upa::url::HOST) };
+    // The dummy URL is special, so the host is parsed as the special URL's host.
+    std::string result;
+    if (!upa::success(upa::canonicalize_host(value, result)))
+        throw urlpattern_error("canonicalize a hostname error");
+    return result;
 }
 
 // https://urlpattern.spec.whatwg.org/#canonicalize-an-ipv6-hostname
@@ -2496,39 +2908,35 @@ inline std::string canonicalize_port(std::string_view port_value, std::optional<
     // * If protocolValue was given, then set dummyURL’s scheme to protocolValue.
     // * Let parseResult be the result of running basic URL parser given portValue
     //   with dummyURL as url and port state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        if (protocol_value)
-            urls.set_scheme(*protocol_value);
-        else
-            urls.set_scheme("");
-        // Note, we set the URL record's scheme in order for the basic URL parser
-        // to recognize and normalize default port values.
-
-        // HACK: To improve performance, we use "h" instead of "dummy.invalid".
-        urls.hostStart().push_back('h');
-        urls.hostDone(upa::HostType::Domain);
-
-        const auto inp = upa::make_str_arg(port_value);
-        const auto parse_result = upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::port_state);
-        if (!upa::success(parse_result))
-            throw urlpattern_error("canonicalize a port error");
-    }
-    return std::string{ dummy_url.get_part_view(upa::url::PORT) };
+    // Note, the scheme is used to recognize and normalize default port values.
+    std::string result;
+    if (!upa::success(upa::canonicalize_port(port_value, result, protocol_value.value_or(""sv))))
+        throw urlpattern_error("canonicalize a port error");
+    return result;
 }
 
 // https://urlpattern.spec.whatwg.org/#canonicalize-a-pathname
 inline std::string canonicalize_pathname(std::string_view value) {
-    if (value.empty()) return {};
+    std::string result;
+    append_canonical_pathname(value, result);
+    return result;
+}
+
+// Appends the result of "canonicalize a pathname" to the output
+inline void append_canonical_pathname(std::string_view value, std::string& output) {
+    if (value.empty()) return;
 
     // Let leading slash be true if the first code point
     // in value is U+002F (/) and otherwise false
     const bool leading_slash = value[0] == '/';
     // Let modified value be "/-" if leading slash is false
     // and otherwise the empty string.
-    std::string modified_value{ leading_slash ? ""sv : "/-"sv };
+    // The modified value is built on the stack, to avoid allocation.
+    upa::simple_buffer<char> modified_value;
+    if (!leading_slash) {
+        modified_value.push_back('/');
+        modified_value.push_back('-');
+    }
     // Note
     // The URL parser will automatically prepend a leading slash to the canonicalized pathname.
     // This does not work here unfortunately. This algorithm is called for pieces of the pathname,
@@ -2542,37 +2950,26 @@ inline std::string canonicalize_pathname(std::string_view value) {
     // instead of paying the performance penalty of inserting and removing characters in this
     // algorithm.
 
-    modified_value.append(value);
+    modified_value.append(value.data(), value.data() + value.size());
 
     // * Let dummyURL be the result of creating a dummy URL.
     // * Empty dummyURL’s path.
     // * Run basic URL parser given modified value with dummyURL as url and
     //   path start state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        /*** This code is unnecessary ***
-        urls.set_scheme("https");
-        // HACK: To improve performance, we use "h" instead of "dummy.invalid".
-        urls.hostStart().push_back('h');
-        urls.hostDone(upa::HostType::Domain);
-        ***/
-
-        const auto inp = upa::make_str_arg(modified_value);
-        upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::path_start_state);
-    }
-    auto result = dummy_url.get_part_view(upa::url::PATH);
+    // Note, the path is canonicalized as the path of the URL with the empty
+    // scheme, i.e. the '\' is not the path segment separator.
+    const auto start = output.length();
+    upa::canonicalize_path(std::string_view{ modified_value.data(), modified_value.size() }, output, false);
     // If leading slash is false, then set result to the code point
     // substring from 2 to the end of the string within result.
     if (!leading_slash) {
         // The result length may be less than 2. For example, if the value is "path/..",
         // then the modified_value is "/-path/..", and the result is "/".
-        if (result.length() <= 2)
-            return {};
-        result.remove_prefix(2);
+        if (output.length() - start <= 2)
+            output.resize(start);
+        else
+            output.erase(start, 2);
     }
-    return std::string{ result };
 }
 
 // https://urlpattern.spec.whatwg.org/#canonicalize-an-opaque-pathname
@@ -2583,20 +2980,9 @@ inline std::string canonicalize_opaque_pathname(std::string_view value) {
     // * Set dummyURL’s path to the empty string.
     // * Let parseResult be the result of running URL parsing given value with
     //   dummyURL as url and opaque path state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        // Set dummyURL’s path to the empty string (so path becomes opaque,
-        // see: https://url.spec.whatwg.org/#url-opaque-path)
-        urls.set_has_opaque_path();
-
-        const auto inp = upa::make_str_arg(value);
-        const auto parse_result = upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::opaque_path_state);
-        if (!upa::success(parse_result))
-            throw urlpattern_error("canonicalize an opaque pathname error");
-    }
-    return std::string{ dummy_url.get_part_view(upa::url::PATH) };
+    std::string result;
+    upa::canonicalize_opaque_path(value, result);
+    return result;
 }
 
 // https://urlpattern.spec.whatwg.org/#canonicalize-a-search
@@ -2606,24 +2992,11 @@ inline std::string canonicalize_search(std::string_view value) {
     // * Let dummyURL be the result of creating a dummy URL.
     // * Set dummyURL’s query to the empty string.
     // * Run basic URL parser given value with dummyURL as url and query state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        // Setting the scheme to special ensures that the query will be percent
-        // encoded using the special-query percent-encode set.
-        urls.set_scheme("https");
-        // HACK: To improve performance, we use "h" instead of "dummy.invalid".
-        urls.hostStart().push_back('h');
-        urls.hostDone(upa::HostType::Domain);
-
-        // Set dummyURL's query to the empty string.
-        //TODO: urls.set_flag(upa::url::QUERY_FLAG);
-
-        const auto inp = upa::make_str_arg(value);
-        upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::query_state);
-    }
-    return std::string{ dummy_url.get_part_view(upa::url::QUERY) };
+    // The dummy URL is special, so the query is percent encoded using the
+    // special-query percent-encode set.
+    std::string result;
+    upa::canonicalize_query(value, result);
+    return result;
 }
 
 // https://urlpattern.spec.whatwg.org/#canonicalize-a-hash
@@ -2633,24 +3006,9 @@ inline std::string canonicalize_hash(std::string_view value) {
     // * Let dummyURL be the result of creating a dummy URL.
     // * Set dummyURL’s fragment to the empty string.
     // * Run basic URL parser given value with dummyURL as url and fragment state as state override.
-    upa::url dummy_url{};
-    {
-        upa::detail::url_serializer urls(dummy_url);
-        /*** This code is unnecessary ***
-        urls.set_scheme("https");
-        // HACK: To improve performance, we use "h" instead of "dummy.invalid".
-        urls.hostStart().push_back('h');
-        urls.hostDone(upa::HostType::Domain);
-        ***/
-
-        // Set dummyURL's fragment to the empty string.
-        //TODO: urls.set_flag(upa::url::FRAGMENT_FLAG);
-
-        const auto inp = upa::make_str_arg(value);
-        upa::detail::url_parser::url_parse(urls, inp.begin(), inp.end(), nullptr,
-            upa::detail::url_parser::fragment_state);
-    }
-    return std::string{ dummy_url.get_part_view(upa::url::FRAGMENT) };
+    std::string result;
+    upa::canonicalize_fragment(value, result);
+    return result;
 }
 
 
@@ -2873,6 +3231,140 @@ inline std::string process_hash_for_init(std::string_view value, urlpattern_init
     return canonicalize_hash(stripped_value);
 }
 
+// Processes the URLPatternInit of the "url" type into the context buffers
+
+inline bool init_canonicalizer::process(const urlpattern_init& init, urlpattern_exec_context& ctx) {
+    auto& buff = ctx.buffer_;
+    auto* start = ctx.start_;
+    buff.clear();
+
+    // Starts the next component in the buffer
+    std::size_t index = 0;
+    const auto next_component = [&]() {
+        start[index++] = buff.length();
+    };
+    const auto strip_prefix = [](std::string_view value, char prefix) {
+        return (!value.empty() && value.front() == prefix) ? value.substr(1) : value;
+    };
+
+    const upa::url* base_url = nullptr;
+    if (init.base_url) {
+        if (!upa::success(ctx.base_url_.parse(*init.base_url, nullptr)))
+            return false;
+        base_url = &ctx.base_url_;
+    }
+    // The base URL components are used if the init has no component and no
+    // components before it, see process_urlpattern_init
+    const bool use_base_authority = base_url && !init.protocol && !init.hostname;
+    const bool use_base_credentials = use_base_authority && !init.port && !init.username;
+    const bool use_base_pathname = use_base_authority && !init.port;
+    const bool use_base_search = use_base_pathname && !init.pathname;
+    const bool use_base_hash = use_base_search && !init.search;
+
+    // protocol
+    next_component();
+    if (init.protocol) {
+        // Let strippedValue be the given value with a single trailing U+003A (:) removed, if any.
+        std::string_view value = *init.protocol;
+        if (!value.empty() && value.back() == ':')
+            value.remove_suffix(1);
+        // See canonicalize_protocol
+        if (!value.empty() && (value.find(':') != std::string_view::npos ||
+            !upa::success(upa::canonicalize_scheme(value, buff))))
+            buff.append(canonicalize_protocol(value));
+    } else if (base_url) {
+        buff.append(base_url->get_part_view(upa::url::SCHEME));
+    }
+    const auto protocol_end = buff.length();
+
+    // username
+    next_component();
+    if (init.username) {
+        const std::string_view value = *init.username;
+        upa::detail::append_utf8_percent_encoded(value.data(), value.data() + value.size(),
+            upa::userinfo_no_encode_set, buff);
+    } else if (use_base_credentials) {
+        buff.append(base_url->get_part_view(upa::url::USERNAME));
+    }
+
+    // password
+    next_component();
+    if (init.password) {
+        const std::string_view value = *init.password;
+        upa::detail::append_utf8_percent_encoded(value.data(), value.data() + value.size(),
+            upa::userinfo_no_encode_set, buff);
+    } else if (use_base_credentials) {
+        buff.append(base_url->get_part_view(upa::url::PASSWORD));
+    }
+
+    // hostname
+    next_component();
+    if (init.hostname) {
+        if (!init.hostname->empty() && !upa::success(upa::canonicalize_host(*init.hostname, buff)))
+            return false;
+    } else if (use_base_authority) {
+        buff.append(base_url->get_part_view(upa::url::HOST));
+    }
+
+    // port
+    next_component();
+    if (init.port) {
+        // Note, the scheme info is taken before appending to the buffer
+        const auto* scheme_inf = upa::detail::get_scheme_info(
+            std::string_view{ buff }.substr(start[0], protocol_end - start[0]));
+        if (!init.port->empty() && !upa::success(upa::detail::url_parser::canonicalize_port(
+            init.port->data(), init.port->data() + init.port->size(), scheme_inf, buff)))
+            return false;
+    } else if (use_base_authority) {
+        buff.append(base_url->get_part_view(upa::url::PORT));
+    }
+
+    // pathname
+    next_component();
+    if (init.pathname) {
+        std::string_view pathname = *init.pathname;
+        if (base_url && !base_url->has_opaque_path() &&
+            !is_absolute_pathname(pathname, urlpattern_init_type::URL))
+        {
+            const auto base_url_path = base_url->get_part_view(upa::url::PATH);
+            const auto slash_index = base_url_path.rfind('/');
+            if (slash_index != std::string_view::npos) {
+                ctx.pathname_.assign(base_url_path.substr(0, slash_index + 1));
+                ctx.pathname_.append(pathname);
+                pathname = ctx.pathname_;
+            }
+        }
+        const auto protocol = std::string_view{ buff }.substr(start[0], protocol_end - start[0]);
+        // See process_pathname_for_init
+        if (protocol.empty() || is_special_scheme(protocol))
+            append_canonical_pathname(pathname, buff);
+        else
+            upa::canonicalize_opaque_path(pathname, buff);
+    } else if (use_base_pathname) {
+        buff.append(base_url->get_part_view(upa::url::PATH));
+    }
+
+    // search
+    next_component();
+    if (init.search) {
+        upa::canonicalize_query(strip_prefix(*init.search, '?'), buff);
+    } else if (use_base_search) {
+        buff.append(base_url->get_part_view(upa::url::QUERY));
+    }
+
+    // hash
+    next_component();
+    if (init.hash) {
+        upa::canonicalize_fragment(strip_prefix(*init.hash, '#'), buff);
+    } else if (use_base_hash) {
+        buff.append(base_url->get_part_view(upa::url::FRAGMENT));
+    }
+
+    // the end of the last component
+    next_component();
+    return true;
+}
+
 
 } // namespace pattern
 } // namespace upa
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #ifdef __cpp_lib_start_lifetime_as
 # include <memory>
@@ -182,6 +184,38 @@ UPA_CONSTEXPR_20 void append_ascii_lowercase(std::string& dest, const CharT* fir
     util::append_tr(dest, first, last, ascii_to_lower_char<CharT>);
 }
 
+// Variable-length integers
+// Unsigned LEB128 encoding: 7 bits per byte, least significant group first,
+// the high bit is set in all bytes except the last one. The encoding does not
+// depend on the platform's byte order.
+
+template <class CharContainer>
+inline void append_varint(CharContainer& dest, std::uint64_t value) {
+    while (value >= 0x80) {
+        dest.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    dest.push_back(static_cast<char>(value));
+}
+
+// Reads a variable-length integer starting at first, and on success advances
+// first past it. Returns false if the input is truncated or the value does
+// not fit in 64 bits.
+inline bool read_varint(const char*& first, const char* last, std::uint64_t& value) noexcept {
+    std::uint64_t res = 0;
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7) {
+        const auto byte = static_cast<unsigned char>(*first++);
+        if (shift == 63 && byte > 1)
+            return false;
+        res |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            value = res;
+            return true;
+        }
+    }
+    return false;
+}
+
 // Finders
 
 template <class InputIt>
@@ -205,6 +239,56 @@ constexpr bool has_xn_label(const CharT* first, const CharT* last) {
     return false;
 }
 
+// Word-at-a-time search
+//
+// Skips the 8-char words of the char string which do not contain the chars
+// of interest, and the caller finishes the search char by char from the
+// returned pointer. The word tests are exact for the existence of such bytes.
+// See: https://graphics.stanford.edu/~seander/bithacks.html#HasLessInWord
+
+namespace swar {
+
+inline constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+inline constexpr std::uint64_t kHighBits = 0x8080808080808080ull;
+
+// Returns non-zero if the word has a byte less than n (n <= 128)
+#if defined(__clang__)
+__attribute__((no_sanitize("unsigned-integer-overflow")))
+#endif
+constexpr std::uint64_t has_less(std::uint64_t x, unsigned n) noexcept {
+    return (x - kOnes * n) & ~x & kHighBits;
+}
+
+// Returns non-zero if the word has a byte greater than n (n <= 127)
+#if defined(__clang__)
+__attribute__((no_sanitize("unsigned-integer-overflow")))
+#endif
+constexpr std::uint64_t has_more(std::uint64_t x, unsigned n) noexcept {
+    return ((x + kOnes * (127 - n)) | x) & kHighBits;
+}
+
+// Returns non-zero if the word has a byte equal to c
+constexpr std::uint64_t has_byte(std::uint64_t x, unsigned char c) noexcept {
+    return has_less(x ^ (kOnes * c), 1);
+}
+
+// Returns the pointer to the first word for which may_contain(word) is true,
+// or to the last incomplete word. Does nothing for the wider than 8-bit chars.
+template <class CharT, class WordPred>
+inline const CharT* skip_words(const CharT* first, const CharT* last, WordPred may_contain) noexcept {
+    if constexpr (sizeof(CharT) == 1) {
+        while (last - first >= 8) {
+            std::uint64_t word; // NOLINT(cppcoreguidelines-init-variables)
+            std::memcpy(&word, first, sizeof(word));
+            if (may_contain(word))
+                break;
+            first += 8;
+        }
+    }
+    return first;
+}
+
+} // namespace swar
 
 } // namespace upa::util
 
@@ -0,0 +1,114 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/mapped_file.h"
+
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# ifndef NOMINMAX
+#  define NOMINMAX
+# endif
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+#include <limits>
+
+namespace upa {
+
+#ifdef _WIN32
+
+bool mapped_file::open(const std::filesystem::path& path) {
+    close();
+
+    HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file, &file_size) ||
+        static_cast<unsigned long long>(file_size.QuadPart) > std::numeric_limits<std::size_t>::max()) {
+        ::CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart == 0) {
+        ::CloseHandle(file);
+        is_open_ = true;
+        return true;
+    }
+
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr)
+        return false;
+
+    const void* ptr = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (ptr == nullptr)
+        return false;
+
+    data_ = static_cast<const char*>(ptr);
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    is_open_ = true;
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (data_ != nullptr)
+        ::UnmapViewOfFile(data_);
+    data_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+
+#else
+
+bool mapped_file::open(const std::filesystem::path& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size < 0 ||
+        static_cast<unsigned long long>(st.st_size) > std::numeric_limits<std::size_t>::max()) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        is_open_ = true;
+        return true;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const char*>(ptr);
+    size_ = size;
+    is_open_ = true;
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (data_ != nullptr)
+        ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+
+#endif
+
+} // namespace upa
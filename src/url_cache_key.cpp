@@ -0,0 +1,237 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_cache_key.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace upa {
+namespace {
+
+// The number of query parameters sorted without allocation
+constexpr std::size_t kMaxStackParams = 32;
+
+// The fingerprint seeds
+constexpr std::uint64_t kSeedLow = 0;
+constexpr std::uint64_t kSeedHigh = 0x9E3779B97F4A7C15ull;
+
+inline bool is_ascii_upper(char c) noexcept {
+    return c >= 'A' && c <= 'Z';
+}
+
+inline std::string_view param_name(std::string_view param) noexcept {
+    return param.substr(0, param.find('='));
+}
+
+// The name ending with '*' matches all names with that prefix
+bool match_name(const std::vector<std::string>& names, std::string_view name) noexcept {
+    return std::any_of(names.begin(), names.end(), [&](const std::string& pattern) {
+        if (!pattern.empty() && pattern.back() == '*') {
+            const auto prefix_len = pattern.length() - 1;
+            return name.length() >= prefix_len && name.compare(0, prefix_len, pattern, 0, prefix_len) == 0;
+        }
+        return name == pattern;
+    });
+}
+
+// Stable sort of the query parameters by their names; the insertion sort is
+// used for the small number of parameters, as std::stable_sort allocates
+template <class It>
+void sort_params(It first, It last) {
+    const auto less = [](std::string_view lhs, std::string_view rhs) noexcept {
+        return param_name(lhs) < param_name(rhs);
+    };
+    if (last - first > static_cast<std::ptrdiff_t>(kMaxStackParams)) {
+        std::stable_sort(first, last, less);
+        return;
+    }
+    for (auto it = first; it != last; ++it) {
+        const auto param = *it;
+        auto pos = it;
+        for (; pos != first && less(param, *(pos - 1)); --pos)
+            *pos = *(pos - 1);
+        *pos = param;
+    }
+}
+
+// Key sinks
+
+class string_sink {
+public:
+    explicit string_sink(std::string& output) noexcept
+        : output_(output)
+    {}
+
+    void operator()(std::string_view str) {
+        output_.append(str);
+    }
+
+private:
+    std::string& output_; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+};
+
+// Hashes the key in fixed-size blocks, so the hash value depends only on the
+// key bytes and not on how they are passed to the sink
+template <std::size_t lanes>
+class hash_sink {
+public:
+    explicit hash_sink(const std::array<std::uint64_t, lanes>& seeds) noexcept
+        : hash_(seeds)
+    {}
+
+    void operator()(std::string_view str) noexcept {
+        while (!str.empty()) {
+            const auto count = std::min(str.length(), kBlockSize - len_);
+            std::memcpy(block_ + len_, str.data(), count);
+            len_ += count;
+            str.remove_prefix(count);
+            if (len_ == kBlockSize)
+                hash_block();
+        }
+    }
+
+    [[nodiscard]] std::array<std::uint64_t, lanes> value() noexcept {
+        hash_block();
+        return hash_;
+    }
+
+private:
+    void hash_block() noexcept {
+        for (auto& h : hash_)
+            h = hash_bytes(block_, len_, h);
+        len_ = 0;
+    }
+
+    static constexpr std::size_t kBlockSize = 256;
+
+    std::array<std::uint64_t, lanes> hash_;
+    char block_[kBlockSize]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::size_t len_ = 0;
+};
+
+} // namespace
+
+
+cache_key_builder::cache_key_builder(cache_key_options options)
+    : options_(std::move(options))
+{}
+
+bool cache_key_builder::append_key(const url& u, std::string& output) const {
+    string_sink sink{ output };
+    return build(u, sink);
+}
+
+std::uint64_t cache_key_builder::fingerprint(const url& u) const {
+    hash_sink<1> sink{ { kSeedLow } };
+    build(u, sink);
+    return sink.value()[0];
+}
+
+cache_key_fingerprint cache_key_builder::fingerprint128(const url& u) const {
+    hash_sink<2> sink{ { kSeedLow, kSeedHigh } };
+    build(u, sink);
+    const auto value = sink.value();
+    return { value[0], value[1] };
+}
+
+// Passes the key to the sink in pieces
+template <class Sink>
+bool cache_key_builder::build(const url& u, Sink& sink) const {
+    if (!u.is_valid())
+        return false;
+
+    const auto href = u.get_href();
+    const auto path = u.get_part_view(url::PATH);
+    const auto path_end = static_cast<std::size_t>(path.data() + path.length() - href.data());
+
+    // scheme, credentials, host, port and path
+    const auto host = u.get_part_view(url::HOST);
+    if (options_.lowercase_host && !u.is_special_scheme() &&
+        std::any_of(host.begin(), host.end(), is_ascii_upper)) {
+        const auto host_pos = static_cast<std::size_t>(host.data() - href.data());
+        sink(href.substr(0, host_pos));
+        char lower[64]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        for (std::size_t pos = 0; pos < host.length(); pos += sizeof(lower)) {
+            const auto chunk = host.substr(pos, sizeof(lower));
+            std::transform(chunk.begin(), chunk.end(), lower, [](char c) {
+                return is_ascii_upper(c) ? static_cast<char>(c | 0x20) : c;
+            });
+            sink(std::string_view{ lower, chunk.length() });
+        }
+        const auto host_end = host_pos + host.length();
+        sink(href.substr(host_end, path_end - host_end));
+    } else {
+        sink(href.substr(0, path_end));
+    }
+
+    // query: the empty parameters are skipped
+    if (!u.is_null(url::QUERY)) {
+        const bool filter = !options_.ignored_params.empty() || !options_.kept_params.empty();
+        const auto query = u.get_part_view(url::QUERY);
+
+        std::array<std::string_view, kMaxStackParams> stack_params;
+        std::vector<std::string_view> heap_params;
+        std::size_t count = 0;
+        const auto add_param = [&](std::string_view param) {
+            if (count < kMaxStackParams) {
+                stack_params[count] = param;
+            } else {
+                if (count == kMaxStackParams)
+                    heap_params.assign(stack_params.begin(), stack_params.end());
+                heap_params.push_back(param);
+            }
+            ++count;
+        };
+        const auto emit_param = [&](std::string_view param) {
+            sink(count == 0 ? std::string_view{ "?", 1 } : std::string_view{ "&", 1 });
+            sink(param);
+            ++count;
+        };
+
+        std::size_t pos = 0;
+        while (pos <= query.length()) {
+            auto end = query.find('&', pos);
+            if (end == std::string_view::npos)
+                end = query.length();
+            const auto param = query.substr(pos, end - pos);
+            pos = end + 1;
+            if (param.empty() || (filter && !is_kept_param(param_name(param))))
+                continue;
+            if (options_.sort_query)
+                add_param(param);
+            else
+                emit_param(param);
+        }
+
+        if (options_.sort_query) {
+            const bool on_stack = count <= kMaxStackParams;
+            auto* first = on_stack ? stack_params.data() : heap_params.data();
+            auto* last = first + count;
+            sort_params(first, last);
+            count = 0;
+            for (auto it = first; it != last; ++it)
+                emit_param(*it);
+        }
+    }
+
+    // fragment
+    if (options_.keep_fragment) {
+        const auto fragment = u.get_part_view(url::FRAGMENT);
+        if (!fragment.empty()) {
+            sink(std::string_view{ "#", 1 });
+            sink(fragment);
+        }
+    }
+    return true;
+}
+
+bool cache_key_builder::is_kept_param(std::string_view name) const noexcept {
+    if (!options_.kept_params.empty() && !match_name(options_.kept_params, name))
+        return false;
+    return !match_name(options_.ignored_params, name);
+}
+
+} // namespace upa
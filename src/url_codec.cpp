@@ -0,0 +1,473 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_codec.h"
+#include "upa/public_suffix_list.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+// Encoded URL (integers are varints, see util::append_varint):
+//   flags
+//   scheme: string, if the scheme is not special (kSchemeMask bits are 0)
+//   username, password: strings, if kCredentials flag is set
+//   host: dictionary string (if split_hosts_ - two dictionary strings:
+//     subdomain part and registrable domain), if kHost flag is set
+//   port: integer, if kPort flag is set
+//   path: string, if kLiteralPath flag is set; otherwise the number of
+//     segments, and each segment as a dictionary string
+//   query: the number of '&' separated parts, and each part as a key
+//     dictionary string, followed by value length + 1 and value bytes (or 0
+//     if there is no '='), if kQuery flag is set
+//   fragment: string, if kFragment flag is set
+//
+// String is encoded as length and bytes. Dictionary string is encoded as
+// entry index if it is in the dictionary, or as dictionary size + length,
+// followed by bytes.
+
+namespace upa {
+namespace {
+
+constexpr unsigned kSchemeMask = 0x07;
+constexpr unsigned kHost = 0x08;
+constexpr unsigned kPort = 0x10;
+constexpr unsigned kQuery = 0x20;
+constexpr unsigned kFragment = 0x40;
+constexpr unsigned kCredentials = 0x80;
+constexpr unsigned kLiteralPath = 0x100;
+constexpr unsigned kPathPrefix = 0x200;
+constexpr unsigned kAllFlags = 0x3FF;
+
+// Special schemes; code is index + 1
+constexpr std::string_view kSchemes[] = {
+    "http", "https", "ws", "wss", "ftp", "file"
+};
+constexpr unsigned kSchemeCount = sizeof(kSchemes) / sizeof(kSchemes[0]);
+
+constexpr std::uint8_t kSplitHosts = 0x01;
+
+inline void append_string(std::string& output, std::string_view str) {
+    util::append_varint(output, str.length());
+    output.append(str);
+}
+
+inline bool read_size(const char*& first, const char* last, std::uint64_t& value) noexcept {
+    return util::read_varint(first, last, value) &&
+        value <= static_cast<std::uint64_t>(last - first);
+}
+
+inline bool read_string(const char*& first, const char* last, std::string& output) {
+    std::uint64_t len = 0;
+    if (!read_size(first, last, len))
+        return false;
+    output.append(first, static_cast<std::size_t>(len));
+    first += len;
+    return true;
+}
+
+inline bool read_string(const char*& first, const char* last, std::string_view& str) noexcept {
+    std::uint64_t len = 0;
+    if (!read_size(first, last, len))
+        return false;
+    str = { first, static_cast<std::size_t>(len) };
+    first += len;
+    return true;
+}
+
+template <class Fn>
+inline void for_each_part(std::string_view str, char sep, Fn fn) {
+    for (;;) {
+        const auto pos = str.find(sep);
+        if (pos == std::string_view::npos)
+            break;
+        fn(str.substr(0, pos));
+        str.remove_prefix(pos + 1);
+    }
+    fn(str);
+}
+
+using counter = std::unordered_map<std::string_view, std::size_t>;
+
+// Selects the most frequent strings
+std::vector<std::string> select_entries(const counter& counts, std::size_t max_count,
+    std::size_t min_frequency)
+{
+    std::vector<std::pair<std::string_view, std::size_t>> items;
+    for (const auto& item : counts) {
+        if (item.second >= min_frequency && !item.first.empty())
+            items.emplace_back(item);
+    }
+    // the most frequent strings get the smallest indexes
+    std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    if (items.size() > max_count)
+        items.resize(max_count);
+
+    std::vector<std::string> entries;
+    entries.reserve(items.size());
+    for (const auto& item : items)
+        entries.emplace_back(item.first);
+    return entries;
+}
+
+} // namespace
+
+// Dictionary
+
+void url_codec::dictionary::build_index() {
+    slots.clear();
+    if (entries.empty())
+        return;
+    std::size_t slot_count = 16;
+    while (slot_count < entries.size() * 2)
+        slot_count *= 2;
+    slots.resize(slot_count);
+    const std::size_t mask = slot_count - 1;
+    for (std::size_t ind = 0; ind < entries.size(); ++ind) {
+        auto slot = static_cast<std::size_t>(hash_bytes(entries[ind])) & mask;
+        while (slots[slot] != 0) {
+            // keep the first of duplicate entries
+            if (entries[slots[slot] - 1] == entries[ind])
+                break;
+            slot = (slot + 1) & mask;
+        }
+        if (slots[slot] == 0)
+            slots[slot] = static_cast<std::uint32_t>(ind + 1);
+    }
+}
+
+std::size_t url_codec::dictionary::find(std::string_view str) const noexcept {
+    if (slots.empty())
+        return entries.size();
+    const std::size_t mask = slots.size() - 1;
+    auto slot = static_cast<std::size_t>(hash_bytes(str)) & mask;
+    while (slots[slot] != 0) {
+        const std::size_t ind = slots[slot] - 1;
+        if (entries[ind] == str)
+            return ind;
+        slot = (slot + 1) & mask;
+    }
+    return entries.size();
+}
+
+void url_codec::dictionary::encode(std::string_view str, std::string& output) const {
+    const std::size_t ind = find(str);
+    if (ind < entries.size()) {
+        util::append_varint(output, ind);
+    } else {
+        util::append_varint(output, entries.size() + str.length());
+        output.append(str);
+    }
+}
+
+bool url_codec::dictionary::decode(const char*& first, const char* last, std::string& output) const {
+    std::uint64_t value = 0;
+    if (!util::read_varint(first, last, value))
+        return false;
+    if (value < entries.size()) {
+        output.append(entries[static_cast<std::size_t>(value)]);
+        return true;
+    }
+    value -= entries.size();
+    if (value > static_cast<std::uint64_t>(last - first))
+        return false;
+    output.append(first, static_cast<std::size_t>(value));
+    first += value;
+    return true;
+}
+
+// Learning
+
+std::size_t url_codec::split_host(const url& u, std::string_view host) const {
+    if (psl_ != nullptr) {
+        const auto domain = psl_->get_suffix_view(u, public_suffix_list::option::registrable_domain);
+        if (!domain.empty())
+            return static_cast<std::size_t>(domain.data() - host.data());
+    }
+    return 0;
+}
+
+void url_codec::learn(const std::vector<const url*>& urls, const url_codec_options& options) {
+    psl_ = options.psl;
+    split_hosts_ = options.psl != nullptr;
+
+    counter host_counts;
+    counter segment_counts;
+    counter key_counts;
+    for (const url* pu : urls) {
+        const url& u = *pu;
+        if (!u.is_null(url::HOST)) {
+            const auto host = u.get_part_view(url::HOST);
+            const std::size_t pos = split_host(u, host);
+            if (pos != 0)
+                ++host_counts[host.substr(0, pos)];
+            ++host_counts[host.substr(pos)];
+        }
+        const auto path = u.get_part_view(url::PATH);
+        if (!u.has_opaque_path() && !path.empty()) {
+            for_each_part(path.substr(1), '/', [&](std::string_view segment) {
+                ++segment_counts[segment];
+            });
+        }
+        if (!u.is_null(url::QUERY)) {
+            for_each_part(u.get_part_view(url::QUERY), '&', [&](std::string_view part) {
+                ++key_counts[part.substr(0, part.find('='))];
+            });
+        }
+    }
+
+    hosts_.entries = select_entries(host_counts, options.max_hosts, options.min_frequency);
+    segments_.entries = select_entries(segment_counts, options.max_path_segments, options.min_frequency);
+    query_keys_.entries = select_entries(key_counts, options.max_query_keys, options.min_frequency);
+    hosts_.build_index();
+    segments_.build_index();
+    query_keys_.build_index();
+}
+
+// Encoding and decoding
+
+bool url_codec::encode(const url& u, std::string& output) const {
+    if (!u.is_valid())
+        return false;
+
+    const std::string_view href = u.href();
+    const std::string_view scheme = u.get_part_view(url::SCHEME);
+    const std::string_view username = u.get_part_view(url::USERNAME);
+    const std::string_view password = u.get_part_view(url::PASSWORD);
+    const std::string_view path = u.get_part_view(url::PATH);
+
+    unsigned flags = 0;
+    if (u.is_special_scheme()) {
+        for (unsigned ind = 0; ind < kSchemeCount; ++ind) {
+            if (kSchemes[ind] == scheme) {
+                flags = ind + 1;
+                break;
+            }
+        }
+    }
+    if (!u.is_null(url::HOST)) {
+        flags |= kHost;
+        if (!username.empty() || !password.empty())
+            flags |= kCredentials;
+    } else if (!u.has_opaque_path() &&
+        path.data() != href.data() + scheme.length() + 1) {
+        // "/." is serialized before path, see url_serializer
+        flags |= kPathPrefix;
+    }
+    if (!u.is_null(url::PORT))
+        flags |= kPort;
+    if (u.has_opaque_path() || (!path.empty() && path[0] != '/'))
+        flags |= kLiteralPath;
+    if (!u.is_null(url::QUERY))
+        flags |= kQuery;
+    if (!u.is_null(url::FRAGMENT))
+        flags |= kFragment;
+
+    util::append_varint(output, flags);
+    if ((flags & kSchemeMask) == 0)
+        append_string(output, scheme);
+    if (flags & kCredentials) {
+        append_string(output, username);
+        append_string(output, password);
+    }
+    if (flags & kHost) {
+        const auto host = u.get_part_view(url::HOST);
+        if (split_hosts_) {
+            const std::size_t pos = split_host(u, host);
+            hosts_.encode(host.substr(0, pos), output);
+            hosts_.encode(host.substr(pos), output);
+        } else {
+            hosts_.encode(host, output);
+        }
+    }
+    if (flags & kPort)
+        util::append_varint(output, static_cast<unsigned>(u.port_int()));
+    if (flags & kLiteralPath) {
+        append_string(output, path);
+    } else {
+        util::append_varint(output, static_cast<std::size_t>(std::count(path.begin(), path.end(), '/')));
+        if (!path.empty()) {
+            for_each_part(path.substr(1), '/', [&](std::string_view segment) {
+                segments_.encode(segment, output);
+            });
+        }
+    }
+    if (flags & kQuery) {
+        const auto query = u.get_part_view(url::QUERY);
+        util::append_varint(output, static_cast<std::size_t>(std::count(query.begin(), query.end(), '&')) + 1);
+        for_each_part(query, '&', [&](std::string_view part) {
+            const auto pos = part.find('=');
+            query_keys_.encode(part.substr(0, pos), output);
+            if (pos == std::string_view::npos) {
+                output.push_back(0);
+            } else {
+                const auto value = part.substr(pos + 1);
+                util::append_varint(output, value.length() + 1);
+                output.append(value);
+            }
+        });
+    }
+    if (flags & kFragment)
+        append_string(output, u.get_part_view(url::FRAGMENT));
+    return true;
+}
+
+bool url_codec::decode(const char*& first, const char* last, std::string& href) const {
+    const char* ptr = first;
+    href.clear();
+
+    std::uint64_t flags = 0;
+    if (!util::read_varint(ptr, last, flags) ||
+        (flags & ~static_cast<std::uint64_t>(kAllFlags)) != 0 ||
+        (flags & kSchemeMask) > kSchemeCount)
+        return false;
+
+    // scheme
+    if (flags & kSchemeMask) {
+        href.append(kSchemes[(flags & kSchemeMask) - 1]);
+    } else {
+        if (!read_string(ptr, last, href))
+            return false;
+    }
+    href.push_back(':');
+
+    // authority
+    if (flags & kHost) {
+        href.append("//", 2);
+        if (flags & kCredentials) {
+            std::string_view password;
+            if (!read_string(ptr, last, href) || !read_string(ptr, last, password))
+                return false;
+            if (!password.empty()) {
+                href.push_back(':');
+                href.append(password);
+            }
+            href.push_back('@');
+        }
+        if (split_hosts_ && !hosts_.decode(ptr, last, href))
+            return false;
+        if (!hosts_.decode(ptr, last, href))
+            return false;
+    }
+    if (flags & kPort) {
+        std::uint64_t port = 0;
+        if (!util::read_varint(ptr, last, port) || port > 0xFFFF)
+            return false;
+        href.push_back(':');
+        util::unsigned_to_str(static_cast<unsigned>(port), href, 10u);
+    }
+
+    // path
+    if (flags & kPathPrefix)
+        href.append("/.", 2);
+    if (flags & kLiteralPath) {
+        if (!read_string(ptr, last, href))
+            return false;
+    } else {
+        std::uint64_t count = 0;
+        if (!read_size(ptr, last, count))
+            return false;
+        for (; count != 0; --count) {
+            href.push_back('/');
+            if (!segments_.decode(ptr, last, href))
+                return false;
+        }
+    }
+
+    // query
+    if (flags & kQuery) {
+        std::uint64_t count = 0;
+        if (!read_size(ptr, last, count) || count == 0)
+            return false;
+        href.push_back('?');
+        for (std::uint64_t ind = 0; ind < count; ++ind) {
+            if (ind != 0)
+                href.push_back('&');
+            std::uint64_t value_len = 0;
+            if (!query_keys_.decode(ptr, last, href) ||
+                !util::read_varint(ptr, last, value_len) ||
+                value_len > static_cast<std::uint64_t>(last - ptr) + 1)
+                return false;
+            if (value_len != 0) {
+                href.push_back('=');
+                href.append(ptr, static_cast<std::size_t>(value_len - 1));
+                ptr += value_len - 1;
+            }
+        }
+    }
+
+    // fragment
+    if (flags & kFragment) {
+        href.push_back('#');
+        if (!read_string(ptr, last, href))
+            return false;
+    }
+
+    first = ptr;
+    return true;
+}
+
+bool url_codec::decode(const char*& first, const char* last, url& u) const {
+    const char* ptr = first;
+    std::string href;
+    if (!decode(ptr, last, href) || !upa::success(u.parse(href)))
+        return false;
+    first = ptr;
+    return true;
+}
+
+// Dictionaries
+//   version: 1 byte
+//   flags: 1 byte (kSplitHosts)
+//   hosts, path segments, query keys dictionaries: the number of entries,
+//     and each entry as length and bytes
+
+void url_codec::serialize(std::string& output) const {
+    output.push_back(static_cast<char>(kVersion));
+    output.push_back(static_cast<char>(split_hosts_ ? kSplitHosts : 0));
+    for (const auto* dict : { &hosts_, &segments_, &query_keys_ }) {
+        util::append_varint(output, dict->entries.size());
+        for (const auto& entry : dict->entries)
+            append_string(output, entry);
+    }
+}
+
+bool url_codec::load(std::string_view data) {
+    const char* ptr = data.data();
+    const char* last = ptr + data.size();
+    if (data.size() < 2 ||
+        static_cast<std::uint8_t>(ptr[0]) != kVersion ||
+        (static_cast<std::uint8_t>(ptr[1]) & ~kSplitHosts) != 0)
+        return false;
+    const bool split_hosts = static_cast<std::uint8_t>(ptr[1]) == kSplitHosts;
+    ptr += 2;
+
+    dictionary dicts[3];
+    for (auto& dict : dicts) {
+        std::uint64_t count = 0;
+        // each entry takes at least one byte
+        if (!read_size(ptr, last, count) || count > UINT32_MAX)
+            return false;
+        dict.entries.reserve(static_cast<std::size_t>(count));
+        for (; count != 0; --count) {
+            std::string_view entry;
+            if (!read_string(ptr, last, entry))
+                return false;
+            dict.entries.emplace_back(entry);
+        }
+    }
+    if (ptr != last)
+        return false;
+
+    for (auto& dict : dicts)
+        dict.build_index();
+    hosts_ = std::move(dicts[0]);
+    segments_ = std::move(dicts[1]);
+    query_keys_ = std::move(dicts[2]);
+    split_hosts_ = split_hosts;
+    return true;
+}
+
+} // namespace upa
@@ -0,0 +1,449 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_data.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace upa {
+namespace {
+
+// Char classification
+// See: https://mimesniff.spec.whatwg.org/#http-token-code-point
+
+constexpr bool is_http_whitespace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+constexpr bool is_ascii_whitespace(char c) noexcept {
+    return is_http_whitespace(c) || c == '\f';
+}
+
+constexpr bool is_http_token_char(char c) noexcept {
+    switch (c) {
+    case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+    case '+': case '-': case '.': case '^': case '_': case '`': case '|': case '~':
+        return true;
+    default:
+        return detail::is_ascii_digit(c) || detail::is_ascii_alpha(c);
+    }
+}
+
+constexpr bool is_http_quoted_string_token_char(char c) noexcept {
+    const auto uc = static_cast<unsigned char>(c);
+    return uc == 0x09 || (uc >= 0x20 && uc != 0x7F);
+}
+
+bool is_http_token(std::string_view str) noexcept {
+    for (const char c : str) {
+        if (!is_http_token_char(c))
+            return false;
+    }
+    return true;
+}
+
+bool is_http_quoted_string_token(std::string_view str) noexcept {
+    for (const char c : str) {
+        if (!is_http_quoted_string_token_char(c))
+            return false;
+    }
+    return true;
+}
+
+std::string_view trim_trailing_http_whitespace(std::string_view str) noexcept {
+    while (!str.empty() && is_http_whitespace(str.back()))
+        str.remove_suffix(1);
+    return str;
+}
+
+bool ascii_iequal(std::string_view lhs, std::string_view rhs) noexcept {
+    if (lhs.length() != rhs.length())
+        return false;
+    for (std::size_t ind = 0; ind < lhs.length(); ++ind) {
+        if (util::ascii_to_lower_char(lhs[ind]) != util::ascii_to_lower_char(rhs[ind]))
+            return false;
+    }
+    return true;
+}
+
+// Collects an HTTP quoted string with the extract-value flag set, starting at
+// the '"' character
+// See: https://fetch.spec.whatwg.org/#collect-an-http-quoted-string
+std::string collect_http_quoted_string(const char*& pointer, const char* last) {
+    std::string value;
+    ++pointer; // skip '"'
+    while (true) {
+        const auto* start = pointer;
+        while (pointer != last && *pointer != '"' && *pointer != '\\')
+            ++pointer;
+        value.append(start, pointer);
+        if (pointer == last)
+            break;
+        const char quote_or_backslash = *pointer++;
+        if (quote_or_backslash == '\\') {
+            if (pointer == last) {
+                value.push_back('\\');
+                break;
+            }
+            value.push_back(*pointer++);
+        } else {
+            break;
+        }
+    }
+    return value;
+}
+
+// Decoding tables
+//
+// The values of kBase64Table: 0 ... 63 - the base64 alphabet characters,
+// kWhitespace - ASCII whitespace, kPadding - '=', kPercent - '%', and
+// kInvalid - other characters. Any value >= 64 stops the fast path.
+
+constexpr std::uint8_t kWhitespace = 0x40;
+constexpr std::uint8_t kPadding = 0x41;
+constexpr std::uint8_t kPercent = 0x42;
+constexpr std::uint8_t kInvalid = 0xFF;
+
+constexpr std::array<std::uint8_t, 256> make_base64_table() {
+    std::array<std::uint8_t, 256> table{};
+    for (auto& value : table)
+        value = kInvalid;
+    std::uint8_t value = 0;
+    for (char c = 'A'; c <= 'Z'; ++c)
+        table[static_cast<unsigned char>(c)] = value++;
+    for (char c = 'a'; c <= 'z'; ++c)
+        table[static_cast<unsigned char>(c)] = value++;
+    for (char c = '0'; c <= '9'; ++c)
+        table[static_cast<unsigned char>(c)] = value++;
+    table['+'] = value++;
+    table['/'] = value;
+    for (const char c : { ' ', '\t', '\n', '\f', '\r' })
+        table[static_cast<unsigned char>(c)] = kWhitespace;
+    table['='] = kPadding;
+    table['%'] = kPercent;
+    return table;
+}
+
+constexpr auto kBase64Table = make_base64_table();
+
+// The values of kHexTable: 0 ... 15 - the hex digits, 0xFF - other characters
+
+constexpr std::array<std::uint8_t, 256> make_hex_table() {
+    std::array<std::uint8_t, 256> table{};
+    for (std::size_t ind = 0; ind < table.size(); ++ind) {
+        const auto c = static_cast<char>(ind);
+        table[ind] = detail::is_hex_char(c)
+            ? detail::hex_char_to_num(static_cast<unsigned char>(c))
+            : 0xFF;
+    }
+    return table;
+}
+
+constexpr auto kHexTable = make_hex_table();
+
+// Percent-decodes the input into the output buffer, which must be at least
+// the size of the input. Returns the size of the decoded bytes.
+// See: https://url.spec.whatwg.org/#percent-decode
+std::size_t percent_decode_bytes(std::string_view input, char* output) noexcept {
+    const auto* pointer = reinterpret_cast<const unsigned char*>(input.data());
+    const auto* last = pointer + input.length();
+    char* out = output;
+    while (pointer != last) {
+        const auto uc = *pointer++;
+        if (uc == '%' && last - pointer >= 2) {
+            const unsigned hi = kHexTable[pointer[0]];
+            const unsigned lo = kHexTable[pointer[1]];
+            if ((hi | lo) < 16) {
+                *out++ = static_cast<char>((hi << 4) | lo);
+                pointer += 2;
+                continue;
+            }
+        }
+        *out++ = static_cast<char>(uc);
+    }
+    return static_cast<std::size_t>(out - output);
+}
+
+// Percent-decodes and forgiving-base64 decodes the input into the output
+// buffer in a single pass. The output buffer must be at least
+// input.length() / 4 * 3 + 2 bytes. Returns the size of the decoded bytes,
+// or std::nullopt on failure.
+// See: https://infra.spec.whatwg.org/#forgiving-base64-decode
+std::optional<std::size_t> base64_decode_bytes(std::string_view input, char* output) noexcept {
+    const auto* pointer = reinterpret_cast<const unsigned char*>(input.data());
+    const auto* last = pointer + input.length();
+    char* out = output;
+
+    // The bits of the incomplete group of four sextets
+    std::uint32_t acc = 0;
+    unsigned count = 0;
+    unsigned padding = 0;
+
+    while (true) {
+        // Fast path: the complete groups of eight base64 alphabet characters
+        if (count == 0 && padding == 0) {
+            while (last - pointer >= 8) {
+                const std::uint32_t s0 = kBase64Table[pointer[0]];
+                const std::uint32_t s1 = kBase64Table[pointer[1]];
+                const std::uint32_t s2 = kBase64Table[pointer[2]];
+                const std::uint32_t s3 = kBase64Table[pointer[3]];
+                const std::uint32_t s4 = kBase64Table[pointer[4]];
+                const std::uint32_t s5 = kBase64Table[pointer[5]];
+                const std::uint32_t s6 = kBase64Table[pointer[6]];
+                const std::uint32_t s7 = kBase64Table[pointer[7]];
+                if ((s0 | s1 | s2 | s3 | s4 | s5 | s6 | s7) >= 64)
+                    break;
+                const std::uint32_t v0 = (s0 << 18) | (s1 << 12) | (s2 << 6) | s3;
+                const std::uint32_t v1 = (s4 << 18) | (s5 << 12) | (s6 << 6) | s7;
+                out[0] = static_cast<char>(v0 >> 16);
+                out[1] = static_cast<char>(v0 >> 8);
+                out[2] = static_cast<char>(v0);
+                out[3] = static_cast<char>(v1 >> 16);
+                out[4] = static_cast<char>(v1 >> 8);
+                out[5] = static_cast<char>(v1);
+                out += 6;
+                pointer += 8;
+            }
+        }
+        if (pointer == last)
+            break;
+
+        // Slow path: one character
+        std::uint8_t value = kBase64Table[*pointer++];
+        if (value == kPercent) {
+            // '%' is not in the base64 alphabet, so it must be percent-encoded byte
+            if (last - pointer < 2)
+                return std::nullopt;
+            const unsigned hi = kHexTable[pointer[0]];
+            const unsigned lo = kHexTable[pointer[1]];
+            if ((hi | lo) >= 16)
+                return std::nullopt;
+            pointer += 2;
+            value = kBase64Table[(hi << 4) | lo];
+            if (value == kPercent)
+                return std::nullopt;
+        }
+        if (value < 64) {
+            // the alphabet character after '=' is invalid
+            if (padding != 0)
+                return std::nullopt;
+            acc = (acc << 6) | value;
+            if (++count == 4) {
+                out[0] = static_cast<char>(acc >> 16);
+                out[1] = static_cast<char>(acc >> 8);
+                out[2] = static_cast<char>(acc);
+                out += 3;
+                acc = 0;
+                count = 0;
+            }
+        } else if (value == kPadding) {
+            if (++padding > 2)
+                return std::nullopt;
+        } else if (value != kWhitespace) {
+            return std::nullopt;
+        }
+    }
+
+    // The padding is removed only if the code point length is divisible by 4
+    if (padding != 0 && (count + padding) % 4 != 0)
+        return std::nullopt;
+    switch (count) {
+    case 1:
+        return std::nullopt;
+    case 2:
+        // 12 bits: discard the last 4 bits
+        *out++ = static_cast<char>(acc >> 4);
+        break;
+    case 3:
+        // 18 bits: discard the last 2 bits
+        *out++ = static_cast<char>(acc >> 10);
+        *out++ = static_cast<char>(acc >> 2);
+        break;
+    default:
+        break;
+    }
+    return static_cast<std::size_t>(out - output);
+}
+
+} // namespace
+
+// MIME type
+
+std::string mime_type::serialize() const {
+    std::string res = essence();
+    for (const auto& [name, value] : parameters) {
+        res += ';';
+        res += name;
+        res += '=';
+        if (value.empty() || !is_http_token(value)) {
+            res += '"';
+            for (const char c : value) {
+                if (c == '"' || c == '\\')
+                    res += '\\';
+                res += c;
+            }
+            res += '"';
+        } else {
+            res += value;
+        }
+    }
+    return res;
+}
+
+std::optional<mime_type> parse_mime_type(std::string_view input) {
+    // 1. Remove any leading and trailing HTTP whitespace from input
+    while (!input.empty() && is_http_whitespace(input.front()))
+        input.remove_prefix(1);
+    input = trim_trailing_http_whitespace(input);
+
+    const char* pointer = input.data();
+    const char* last = pointer + input.length();
+
+    // 3. - 6. type
+    const auto* start = pointer;
+    while (pointer != last && *pointer != '/')
+        ++pointer;
+    const std::string_view type(start, static_cast<std::size_t>(pointer - start));
+    if (type.empty() || !is_http_token(type) || pointer == last)
+        return std::nullopt;
+    ++pointer; // skip '/'
+
+    // 7. - 9. subtype
+    start = pointer;
+    while (pointer != last && *pointer != ';')
+        ++pointer;
+    const auto subtype = trim_trailing_http_whitespace(
+        std::string_view(start, static_cast<std::size_t>(pointer - start)));
+    if (subtype.empty() || !is_http_token(subtype))
+        return std::nullopt;
+
+    // 10.
+    mime_type res;
+    util::append_ascii_lowercase(res.type, type.data(), type.data() + type.length());
+    util::append_ascii_lowercase(res.subtype, subtype.data(), subtype.data() + subtype.length());
+
+    // 11. parameters
+    while (pointer != last) {
+        ++pointer; // skip ';'
+        while (pointer != last && is_http_whitespace(*pointer))
+            ++pointer;
+
+        start = pointer;
+        while (pointer != last && *pointer != ';' && *pointer != '=')
+            ++pointer;
+        const std::string_view name(start, static_cast<std::size_t>(pointer - start));
+        if (pointer != last) {
+            if (*pointer == ';')
+                continue;
+            ++pointer; // skip '='
+        }
+        if (pointer == last)
+            break;
+
+        std::string value;
+        if (*pointer == '"') {
+            value = collect_http_quoted_string(pointer, last);
+            while (pointer != last && *pointer != ';')
+                ++pointer;
+        } else {
+            start = pointer;
+            while (pointer != last && *pointer != ';')
+                ++pointer;
+            const auto str_value = trim_trailing_http_whitespace(
+                std::string_view(start, static_cast<std::size_t>(pointer - start)));
+            if (str_value.empty())
+                continue;
+            value = str_value;
+        }
+
+        if (!name.empty() && is_http_token(name) && is_http_quoted_string_token(value)) {
+            std::string lower_name;
+            util::append_ascii_lowercase(lower_name, name.data(), name.data() + name.length());
+            if (res.parameter(lower_name) == nullptr)
+                res.parameters.emplace_back(std::move(lower_name), std::move(value));
+        }
+    }
+    return res;
+}
+
+// data: URL processor
+
+bool data_url::parse(const url& u) {
+    // reset the result of the previous call, so that the failed parse
+    // leaves no view of the previous URL
+    mime_ = {};
+    encoded_body_ = {};
+    base64_ = false;
+
+    if (!u.is_valid() || u.get_part_view(url::SCHEME) != "data")
+        return false;
+
+    // 2. - 3. The URL serialized with the exclude fragment flag set, without
+    // the leading "data:"
+    auto input = u.get_href();
+    if (!u.is_null(url::FRAGMENT))
+        input = input.substr(0, u.get_part_pos(url::FRAGMENT, true).first);
+    input.remove_prefix(5);
+
+    // 5. - 9.
+    const auto comma = input.find(',');
+    if (comma == std::string_view::npos)
+        return false;
+    auto str_mime = input.substr(0, comma);
+    encoded_body_ = input.substr(comma + 1);
+
+    // 6. Strip leading and trailing ASCII whitespace from mimeType
+    while (!str_mime.empty() && is_ascii_whitespace(str_mime.front()))
+        str_mime.remove_prefix(1);
+    while (!str_mime.empty() && is_ascii_whitespace(str_mime.back()))
+        str_mime.remove_suffix(1);
+
+    // 11. If mimeType ends with ";", followed by zero or more U+0020 SPACE,
+    // followed by an ASCII case-insensitive match for "base64"
+    if (str_mime.length() >= 7 && ascii_iequal(str_mime.substr(str_mime.length() - 6), "base64")) {
+        auto rest = str_mime.substr(0, str_mime.length() - 6);
+        while (!rest.empty() && rest.back() == ' ')
+            rest.remove_suffix(1);
+        if (!rest.empty() && rest.back() == ';') {
+            rest.remove_suffix(1);
+            str_mime = rest;
+            base64_ = true;
+        }
+    }
+
+    // 12. - 14.
+    std::optional<mime_type> res;
+    if (!str_mime.empty() && str_mime.front() == ';') {
+        std::string str{ "text/plain" };
+        str += str_mime;
+        res = parse_mime_type(str);
+    } else {
+        res = parse_mime_type(str_mime);
+    }
+    if (res) {
+        mime_ = std::move(*res);
+    } else {
+        mime_.type = "text";
+        mime_.subtype = "plain";
+        mime_.parameters.assign({ { "charset", "US-ASCII" } });
+    }
+    return true;
+}
+
+std::optional<std::size_t> data_url::decode_body(char* output) const {
+    if (base64_)
+        return base64_decode_bytes(encoded_body_, output);
+    return percent_decode_bytes(encoded_body_, output);
+}
+
+bool data_url::append_body(std::string& output) const {
+    const auto old_size = output.size();
+    output.resize(old_size + max_body_size());
+    const auto size = decode_body(output.data() + old_size);
+    output.resize(size ? old_size + *size : old_size);
+    return size.has_value();
+}
+
+} // namespace upa
@@ -0,0 +1,307 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_dictionary.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Encoding of the block (integers are varints, see util::append_varint):
+//   first URL: length, bytes
+//   other URLs: shared prefix length, suffix length, suffix bytes
+// The shared prefix length is the length of the longest common prefix of the
+// URL and the previous one. As URLs are sorted and unique, the first suffix
+// byte is greater than the byte of the previous URL at the same position (if
+// any).
+
+namespace upa {
+namespace {
+
+// File format (native byte order):
+//   file_header
+//   block offsets: std::uint64_t[block_count]
+//   encoded blocks: char[data_size]
+
+struct file_header {
+    char magic[8];
+    std::uint32_t byte_order;
+    std::uint32_t reserved;
+    std::uint64_t block_size;
+    std::uint64_t count;
+    std::uint64_t block_count;
+    std::uint64_t data_size;
+};
+
+constexpr char kMagic[8] = { 'U', 'P', 'A', 'U', 'R', 'L', 'D', '1' };
+constexpr std::uint32_t kByteOrder = 0x01020304;
+
+std::size_t common_prefix_length(std::string_view a, std::string_view b) noexcept {
+    const std::size_t len = std::min(a.length(), b.length());
+    std::size_t ind = 0;
+    while (ind < len && a[ind] == b[ind])
+        ++ind;
+    return ind;
+}
+
+// Unchecked varint reading of the validated data
+inline std::size_t read_size(const char*& ptr) noexcept {
+    std::uint64_t value = 0;
+    util::read_varint(ptr, ptr + 10, value);
+    return static_cast<std::size_t>(value);
+}
+
+template <typename T>
+bool write_array(std::ofstream& file, const T* data, std::size_t size) {
+    return !!file.write(reinterpret_cast<const char*>(data),
+        static_cast<std::streamsize>(size * sizeof(T)));
+}
+
+} // namespace
+
+void url_dictionary::build(std::vector<std::string_view>&& hrefs, size_type block_size) {
+    clear();
+    block_size_ = std::max<size_type>(block_size, 1);
+
+    std::sort(hrefs.begin(), hrefs.end());
+    hrefs.erase(std::unique(hrefs.begin(), hrefs.end()), hrefs.end());
+    count_ = hrefs.size();
+
+    auto& block_offset = block_offset_.vec();
+    block_offset.reserve((count_ + block_size_ - 1) / block_size_);
+    auto& data = data_.vec();
+    std::string_view prev;
+    for (size_type ind = 0; ind < count_; ++ind) {
+        const std::string_view href = hrefs[ind];
+        if (ind % block_size_ == 0) {
+            block_offset.push_back(data.size());
+            util::append_varint(data, href.length());
+            data.insert(data.end(), href.begin(), href.end());
+        } else {
+            const std::size_t shared = common_prefix_length(prev, href);
+            util::append_varint(data, shared);
+            util::append_varint(data, href.length() - shared);
+            data.insert(data.end(), href.begin() + shared, href.end());
+        }
+        prev = href;
+    }
+    data.shrink_to_fit();
+}
+
+void url_dictionary::clear() noexcept {
+    count_ = 0;
+    block_size_ = default_block_size;
+    data_.clear();
+    block_offset_.clear();
+    file_.close();
+}
+
+std::size_t url_dictionary::memory_size() const noexcept {
+    return data_.capacity_bytes() + block_offset_.capacity_bytes();
+}
+
+std::string_view url_dictionary::block_first(size_type block) const noexcept {
+    const char* ptr = data_.data() + block_offset_[block];
+    const std::size_t len = read_size(ptr);
+    return { ptr, len };
+}
+
+url_dictionary::size_type url_dictionary::search(std::string_view href, bool& found) const {
+    found = false;
+
+    // find the last block whose first URL is not greater than href
+    size_type lo = 0;
+    size_type hi = block_offset_.size();
+    while (lo < hi) {
+        const size_type mid = lo + (hi - lo) / 2;
+        if (block_first(mid) <= href)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return 0;
+    const size_type block = lo - 1;
+    size_type ordinal = block * block_size_;
+
+    const char* ptr = data_.data() + block_offset_[block];
+    const char* end = block + 1 < block_offset_.size()
+        ? data_.data() + block_offset_[block + 1]
+        : data_.data() + data_.size();
+
+    // the first URL of the block
+    const std::size_t first_len = read_size(ptr);
+    std::size_t match = common_prefix_length({ ptr, first_len }, href);
+    if (match == first_len && match == href.length()) {
+        found = true;
+        return ordinal;
+    }
+    ptr += first_len;
+
+    // Here the previous URL is less than href, and match is the length of
+    // their common prefix. The URLs are compared with href without decoding.
+    while (ptr != end) {
+        ++ordinal;
+        const std::size_t shared = read_size(ptr);
+        const std::size_t suffix_len = read_size(ptr);
+        const char* suffix = ptr;
+        ptr += suffix_len;
+
+        if (shared < match)
+            return ordinal; // URL > href
+        if (shared > match)
+            continue; // URL < href
+        // compare the suffix with the rest of href
+        const std::string_view href_rest = href.substr(match);
+        const std::size_t len = common_prefix_length({ suffix, suffix_len }, href_rest);
+        if (len == suffix_len) {
+            if (len == href_rest.length()) {
+                found = true;
+                return ordinal;
+            }
+            // URL is a prefix of href
+        } else if (len == href_rest.length() ||
+            static_cast<unsigned char>(suffix[len]) > static_cast<unsigned char>(href_rest[len])) {
+            return ordinal; // URL > href
+        }
+        match += len;
+    }
+    return std::min(ordinal + 1, count_);
+}
+
+url_dictionary::size_type url_dictionary::lower_bound(std::string_view href) const {
+    bool found = false;
+    return search(href, found);
+}
+
+url_dictionary::size_type url_dictionary::find(std::string_view href) const {
+    bool found = false;
+    const size_type ordinal = search(href, found);
+    return found ? ordinal : npos;
+}
+
+void url_dictionary::get(size_type ordinal, std::string& output) const {
+    const size_type block = ordinal / block_size_;
+    const char* ptr = data_.data() + block_offset_[block];
+
+    const std::size_t first_len = read_size(ptr);
+    output.assign(ptr, first_len);
+    ptr += first_len;
+    for (size_type ind = ordinal % block_size_; ind > 0; --ind) {
+        const std::size_t shared = read_size(ptr);
+        const std::size_t suffix_len = read_size(ptr);
+        output.resize(shared);
+        output.append(ptr, suffix_len);
+        ptr += suffix_len;
+    }
+}
+
+std::string url_dictionary::at(size_type ordinal) const {
+    if (ordinal >= count_)
+        throw std::out_of_range("url_dictionary::at: ordinal out of range");
+    std::string output;
+    get(ordinal, output);
+    return output;
+}
+
+bool url_dictionary::save(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        return false;
+
+    file_header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byte_order = kByteOrder;
+    header.block_size = block_size_;
+    header.count = count_;
+    header.block_count = block_offset_.size();
+    header.data_size = data_.size();
+
+    const bool ok = write_array(file, &header, 1) &&
+        write_array(file, block_offset_.data(), block_offset_.size()) &&
+        write_array(file, data_.data(), data_.size());
+    file.close();
+    return ok && !file.fail();
+}
+
+bool url_dictionary::load(const std::filesystem::path& path) {
+    clear();
+
+    mapped_file file;
+    if (!file.open(path) || file.size() < sizeof(file_header))
+        return false;
+
+    file_header header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.byte_order != kByteOrder ||
+        header.block_size == 0 ||
+        header.block_count != header.count / header.block_size +
+            (header.count % header.block_size != 0 ? 1 : 0))
+        return false;
+
+    // check file size
+    const std::uint64_t max_block_count = (file.size() - sizeof(file_header)) / sizeof(std::uint64_t);
+    if (header.block_count > max_block_count ||
+        header.data_size != file.size() - sizeof(file_header) - header.block_count * sizeof(std::uint64_t))
+        return false;
+
+    // mapping is page aligned, so arrays are properly aligned
+    const auto* block_offset = reinterpret_cast<const std::uint64_t*>(file.data() + sizeof(file_header));
+    const char* data = file.data() + sizeof(file_header) + header.block_count * sizeof(std::uint64_t);
+    const auto block_count = static_cast<std::size_t>(header.block_count);
+    const auto block_size = static_cast<std::size_t>(header.block_size);
+    const auto count = static_cast<std::size_t>(header.count);
+
+    // validate blocks: sizes and order of URLs
+    std::string prev;
+    for (std::size_t block = 0; block < block_count; ++block) {
+        if (block == 0 && block_offset[0] != 0)
+            return false;
+        const std::uint64_t block_end = block + 1 < block_count
+            ? block_offset[block + 1] : header.data_size;
+        if (block_offset[block] >= block_end || block_end > header.data_size)
+            return false;
+        const char* ptr = data + block_offset[block];
+        const char* end = data + block_end;
+        const std::size_t entries = std::min(block_size, count - block * block_size);
+        for (std::size_t ind = 0; ind < entries; ++ind) {
+            std::uint64_t shared = 0;
+            std::uint64_t suffix_len = 0;
+            if (ind != 0 && !util::read_varint(ptr, end, shared))
+                return false;
+            if (!util::read_varint(ptr, end, suffix_len) ||
+                suffix_len > static_cast<std::uint64_t>(end - ptr))
+                return false;
+            const std::string_view suffix{ ptr, static_cast<std::size_t>(suffix_len) };
+            ptr += suffix_len;
+            if (ind == 0) {
+                // the first URL of block must be greater than the previous one
+                if (block != 0 && !(prev < suffix))
+                    return false;
+                prev.assign(suffix);
+                continue;
+            }
+            // shared must be the longest common prefix length, and URL must
+            // be greater than the previous one
+            if (shared > prev.length() || suffix.empty() ||
+                (shared < prev.length() &&
+                    static_cast<unsigned char>(suffix[0]) <= static_cast<unsigned char>(prev[shared])))
+                return false;
+            prev.resize(static_cast<std::size_t>(shared));
+            prev.append(suffix);
+        }
+        if (ptr != end)
+            return false;
+    }
+
+    count_ = count;
+    block_size_ = block_size;
+    block_offset_.set_external(block_offset, block_count);
+    data_.set_external(data, static_cast<std::size_t>(header.data_size));
+    file_ = std::move(file);
+    return true;
+}
+
+} // namespace upa
@@ -0,0 +1,291 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_finder.h"
+#include "upa/public_suffix_list.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+namespace upa {
+namespace {
+
+constexpr std::size_t npos = std::string_view::npos;
+
+// The maximum authority length of the `www.` and bare domain candidates
+constexpr std::size_t kMaxAuthorityLength = 1024;
+
+inline bool is_ascii_alpha(unsigned char c) noexcept {
+    return (c | 0x20) >= 'a' && (c | 0x20) <= 'z';
+}
+
+inline bool is_ascii_alnum(unsigned char c) noexcept {
+    return is_ascii_alpha(c) || (c >= '0' && c <= '9');
+}
+
+inline bool is_scheme_char(unsigned char c) noexcept {
+    return is_ascii_alnum(c) || c == '+' || c == '-' || c == '.';
+}
+
+// Domain characters; non-ASCII bytes are allowed for the internationalized
+// domain names
+inline bool is_host_char(unsigned char c) noexcept {
+    return is_ascii_alnum(c) || c == '-' || c == '.' || c >= 0x80;
+}
+
+inline bool is_terminator(unsigned char c) noexcept {
+    return c <= 0x20 || c == 0x7F || c == '<' || c == '>' || c == '"';
+}
+
+// Position of the next c in the text starting from pos, or npos
+inline std::size_t find_char(std::string_view text, char c, std::size_t pos) noexcept {
+    if (pos >= text.size())
+        return npos;
+    const void* ptr = std::memchr(text.data() + pos, c, text.size() - pos);
+    return ptr ? static_cast<std::size_t>(static_cast<const char*>(ptr) - text.data()) : npos;
+}
+
+// Trailing punctuation, which is excluded from the candidate URL
+inline bool is_trailing_punct(char c) noexcept {
+    switch (c) {
+    case '.': case ',': case ':': case ';': case '!': case '?': case '\'': case '*':
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Index of the bracket kind: 0 - (), 1 - [], 2 - {}; or -1
+inline int opening_kind(char c) noexcept {
+    return c == '(' ? 0 : c == '[' ? 1 : c == '{' ? 2 : -1;
+}
+
+inline int closing_kind(char c) noexcept {
+    return c == ')' ? 0 : c == ']' ? 1 : c == '}' ? 2 : -1;
+}
+
+// Finds the ends of the candidate URLs. The end is before the terminator;
+// the trailing punctuation and unbalanced closing brackets are excluded.
+//
+// The successive candidates, which end at the same terminator, reuse the
+// scan of the text span: the terminator is found once, the bracket balances
+// are updated as the candidate start moves forward, and the closing brackets
+// of the trailing run are found once. So the text is scanned in linear time.
+class span_scanner {
+public:
+    explicit span_scanner(std::string_view text) noexcept
+        : text_(text)
+    {}
+
+    std::size_t candidate_end(std::size_t start) {
+        if (start < from_ || start >= term_) {
+            scan_span(start);
+        } else {
+            for (; from_ < start; ++from_)
+                add_bracket(text_[from_], -1);
+        }
+
+        // The candidate ends before the trailing run of the punctuation and
+        // closing brackets, or after the first closing bracket (from the end)
+        // which is balanced, i.e. after -balance unbalanced ones
+        std::size_t end = std::max(run_, start);
+        for (int kind = 0; kind < 3; ++kind) {
+            const auto& closing = closing_[kind];
+            const std::size_t unbalanced = balance_[kind] < 0
+                ? static_cast<std::size_t>(-balance_[kind]) : 0;
+            if (unbalanced < closing.size())
+                end = std::max(end, closing[unbalanced] + 1);
+        }
+        return end;
+    }
+
+    // Returns the position of the first '/', '?', '#' or terminator at or
+    // after pos, i.e. the end of the authority, which starts at pos
+    std::size_t authority_end(std::size_t pos) noexcept {
+        if (pos < auth_from_ || pos > auth_end_) {
+            auth_end_ = pos;
+            while (auth_end_ < text_.size() && !is_authority_end(static_cast<unsigned char>(text_[auth_end_])))
+                ++auth_end_;
+        }
+        auth_from_ = pos;
+        return auth_end_;
+    }
+
+private:
+    static bool is_authority_end(unsigned char c) noexcept {
+        return c == '/' || c == '?' || c == '#' || is_terminator(c);
+    }
+
+    void scan_span(std::size_t start) {
+        from_ = start;
+        term_ = start;
+        std::fill(std::begin(balance_), std::end(balance_), 0);
+        while (term_ < text_.size() && !is_terminator(static_cast<unsigned char>(text_[term_])))
+            add_bracket(text_[term_++], 1);
+
+        for (auto& closing : closing_)
+            closing.clear();
+        run_ = term_;
+        while (run_ > start) {
+            const char c = text_[run_ - 1];
+            const int kind = closing_kind(c);
+            if (kind >= 0)
+                closing_[kind].push_back(run_ - 1);
+            else if (!is_trailing_punct(c))
+                break;
+            --run_;
+        }
+    }
+
+    void add_bracket(char c, std::ptrdiff_t delta) noexcept {
+        int kind = opening_kind(c);
+        if (kind >= 0) {
+            balance_[kind] += delta;
+        } else {
+            kind = closing_kind(c);
+            if (kind >= 0)
+                balance_[kind] -= delta;
+        }
+    }
+
+    std::string_view text_;
+    // the span [from_, term_) ends before the terminator or at the text end
+    std::size_t from_ = 0;
+    std::size_t term_ = 0;
+    // opening minus closing brackets in the span, by kind
+    std::ptrdiff_t balance_[3] = {};
+    // the trailing run [run_, term_) of the punctuation and closing brackets,
+    // and the positions of its closing brackets from the end, by kind
+    std::size_t run_ = 0;
+    std::vector<std::size_t> closing_[3];
+    // the authority end found from the position auth_from_
+    std::size_t auth_from_ = 1;
+    std::size_t auth_end_ = 0;
+};
+
+inline bool starts_with_www(std::string_view str) noexcept {
+    return str.length() > 4 &&
+        (str[0] | 0x20) == 'w' && (str[1] | 0x20) == 'w' && (str[2] | 0x20) == 'w' &&
+        str[3] == '.';
+}
+
+} // namespace
+
+bool url_finder::is_bare_domain(std::string_view host) const {
+    while (!host.empty() && host.back() == '.')
+        host.remove_suffix(1);
+    if (host.empty() || host.front() == '.' || host.front() == '-' ||
+        host.find("..") != npos)
+        return false;
+
+    const auto res = psl_->get_suffix_info(host, public_suffix_list::option::registrable_domain);
+    return res && res.is_rules_match();
+}
+
+bool url_finder::find_next(std::string_view text, std::size_t& pos, url_match& match) const {
+    // candidates start at or after the resume position
+    const std::size_t resume = pos;
+    std::size_t colon = find_char(text, ':', pos);
+    std::size_t dot = find_char(text, '.', pos);
+    span_scanner scanner(text);
+    std::string buff;
+
+    const auto parse = [&](std::size_t start, std::size_t end, bool add_scheme) {
+        const std::string_view candidate = text.substr(start, end - start);
+        if (add_scheme) {
+            buff.assign("http://");
+            buff.append(candidate);
+            return match.value.parse(buff, nullptr) == validation_errc::ok;
+        }
+        return match.value.parse(candidate, nullptr) == validation_errc::ok;
+    };
+    // The URL parsing can fail only in the scheme and authority. So if the
+    // candidate continues after the authority, the part up to the authority
+    // end is parsed first: then the failed candidates take time proportional
+    // to the authority length, not to the rest of the text.
+    const auto try_parse = [&](std::size_t start, std::size_t auth_end, std::size_t end,
+        bool add_scheme) {
+        if (auth_end < end && !parse(start, auth_end, add_scheme))
+            return false;
+        if (!parse(start, end, add_scheme))
+            return false;
+        match.offset = start;
+        match.length = end - start;
+        pos = end;
+        return true;
+    };
+
+    while (colon != npos || dot != npos) {
+        if (colon < dot) {
+            // scheme://
+            const std::size_t ind = colon;
+            colon = find_char(text, ':', ind + 1);
+            if (ind + 2 >= text.size() || text[ind + 1] != '/' || text[ind + 2] != '/')
+                continue;
+            std::size_t start = ind;
+            while (start > resume && is_scheme_char(static_cast<unsigned char>(text[start - 1])))
+                --start;
+            // scheme must start with an ASCII alpha
+            while (start < ind && !is_ascii_alpha(static_cast<unsigned char>(text[start])))
+                ++start;
+            if (start == ind)
+                continue;
+            const std::size_t end = scanner.candidate_end(start);
+            if (end <= ind + 3)
+                continue;
+            // special URLs ignore the slashes before the authority
+            std::size_t auth = ind + 3;
+            while (auth < end && (text[auth] == '/' || text[auth] == '\\'))
+                ++auth;
+            if (try_parse(start, std::min(scanner.authority_end(auth), end), end, false))
+                return true;
+        } else {
+            // www. or bare domain
+            const std::size_t ind = dot;
+            std::size_t start = ind;
+            while (start > resume && is_host_char(static_cast<unsigned char>(text[start - 1])))
+                --start;
+            std::size_t token_end = ind;
+            while (token_end < text.size() && is_host_char(static_cast<unsigned char>(text[token_end])))
+                ++token_end;
+            // the other dots of this token are not candidates
+            dot = find_char(text, '.', token_end);
+
+            // the token must start at a word boundary; skip e-mail addresses
+            // and the parts of paths
+            if (start > 0) {
+                const char prev = text[start - 1];
+                if (prev == '@' || prev == '/' || prev == '\\' || prev == ':' ||
+                    is_host_char(static_cast<unsigned char>(prev)))
+                    continue;
+            }
+
+            const bool www = starts_with_www(text.substr(start, token_end - start));
+            if (!www && (psl_ == nullptr || !is_bare_domain(text.substr(start, token_end - start))))
+                continue;
+            const std::size_t end = scanner.candidate_end(start);
+            if (end <= (www ? start + 4 : start))
+                continue;
+            // the authorities of these candidates may overlap, so their length
+            // is limited
+            const std::size_t auth_end = std::min(scanner.authority_end(start), end);
+            if (auth_end - start <= kMaxAuthorityLength && try_parse(start, auth_end, end, true))
+                return true;
+        }
+    }
+    pos = text.size();
+    return false;
+}
+
+std::vector<url_match> url_finder::find_all(std::string_view text) const {
+    std::vector<url_match> matches;
+    std::size_t pos = 0;
+    url_match match;
+    while (find_next(text, pos, match))
+        matches.push_back(std::move(match));
+    return matches;
+}
+
+} // namespace upa
@@ -0,0 +1,121 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_parse_cache.h"
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace upa {
+
+struct url_parse_cache::shard {
+    struct entry {
+        std::uint64_t key;
+        std::string input;
+        std::string base_href;
+        bool has_base;
+        std::shared_ptr<const url> value; // nullptr if parsing failed
+        validation_errc err;
+    };
+
+    // Removes the entry
+    void erase(std::list<entry>::iterator it) {
+        index.erase(it->key);
+        lru.erase(it);
+    }
+
+    mutable std::mutex mutex;
+    std::list<entry> lru; // most recently used first
+    std::unordered_map<std::uint64_t, std::list<entry>::iterator> index;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+};
+
+url_parse_cache::url_parse_cache(std::size_t capacity, std::size_t shard_count)
+    : shard_count_(std::max<std::size_t>(shard_count, 1))
+    , shard_capacity_(std::max<std::size_t>((capacity + shard_count_ - 1) / shard_count_, 1))
+    , shards_(new shard[shard_count_])
+{}
+
+url_parse_cache::~url_parse_cache() = default;
+
+validation_errc url_parse_cache::find_or_parse(std::string_view str_url, const url* base,
+    std::shared_ptr<const url>& res)
+{
+    // the key: the hash of input seeded with the hash of base URL
+    const std::string_view base_href = base ? base->href() : std::string_view{};
+    const std::uint64_t key = hash_bytes(str_url, base ? base->hash_value() : 0);
+    shard& sh = shards_[static_cast<std::size_t>(key >> 32) % shard_count_];
+
+    const auto matches = [&](const shard::entry& e) {
+        return e.input == str_url && e.base_href == base_href &&
+            e.has_base == (base != nullptr);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        const auto it = sh.index.find(key);
+        if (it != sh.index.end() && matches(*it->second)) {
+            sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+            ++sh.hits;
+            res = it->second->value;
+            return it->second->err;
+        }
+        ++sh.misses;
+    }
+
+    // parse outside of the lock
+    auto u = std::make_shared<url>();
+    const validation_errc err = u->parse(str_url, base);
+    if (err == validation_errc::ok) {
+        u->cache_hash();
+        res = std::move(u);
+    }
+
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    const auto it = sh.index.find(key);
+    if (it != sh.index.end()) {
+        // parsed by another thread, or the key collision
+        sh.erase(it->second);
+    } else if (sh.lru.size() >= shard_capacity_) {
+        sh.erase(std::prev(sh.lru.end()));
+        ++sh.evictions;
+    }
+    sh.lru.push_front({ key, std::string{ str_url }, std::string{ base_href },
+        base != nullptr, res, err });
+    sh.index.emplace(key, sh.lru.begin());
+    return err;
+}
+
+url_parse_cache::statistics url_parse_cache::stats() const {
+    statistics res;
+    for (std::size_t ind = 0; ind < shard_count_; ++ind) {
+        const shard& sh = shards_[ind];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        res.hits += sh.hits;
+        res.misses += sh.misses;
+        res.evictions += sh.evictions;
+        res.size += sh.lru.size();
+    }
+    return res;
+}
+
+void url_parse_cache::clear() {
+    for (std::size_t ind = 0; ind < shard_count_; ++ind) {
+        shard& sh = shards_[ind];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        sh.index.clear();
+        sh.lru.clear();
+        sh.hits = 0;
+        sh.misses = 0;
+        sh.evictions = 0;
+    }
+}
+
+} // namespace upa
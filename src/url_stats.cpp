@@ -0,0 +1,128 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_stats.h"
+#include <ostream>
+#ifdef UPA_ENABLE_STATS
+# include <algorithm>
+# include <mutex>
+# include <vector>
+#endif
+
+namespace upa {
+namespace {
+
+struct stats_field {
+    std::uint64_t url_stats::* member;
+    const char* name;
+};
+
+// In the detail::stats_id order
+constexpr stats_field kStatsFields[detail::stats_count] = {
+    { &url_stats::urls_parsed, "urls_parsed" },
+    { &url_stats::bytes_parsed, "bytes_parsed" },
+    { &url_stats::whitespace_removals, "whitespace_removals" },
+    { &url_stats::idna_ascii, "idna_ascii" },
+    { &url_stats::idna_non_ascii, "idna_non_ascii" },
+    { &url_stats::pct_encoded_userinfo, "pct_encoded_userinfo" },
+    { &url_stats::pct_encoded_host, "pct_encoded_host" },
+    { &url_stats::pct_encoded_path, "pct_encoded_path" },
+    { &url_stats::pct_encoded_query, "pct_encoded_query" },
+    { &url_stats::pct_encoded_fragment, "pct_encoded_fragment" },
+    { &url_stats::path_shortenings, "path_shortenings" },
+    { &url_stats::ipv4_hosts, "ipv4_hosts" },
+    { &url_stats::ipv6_hosts, "ipv6_hosts" },
+    { &url_stats::setter_calls, "setter_calls" },
+};
+
+#ifdef UPA_ENABLE_STATS
+
+// Counters of all threads
+struct stats_registry {
+    std::mutex mutex;
+    std::vector<const detail::stats_counters*> threads;
+    // sums of the finished threads' counters
+    std::uint64_t finished[detail::stats_count] = {};
+    // sums at the last reset
+    std::uint64_t baseline[detail::stats_count] = {};
+
+    // Must be called with the mutex locked
+    void sum(std::uint64_t (&values)[detail::stats_count]) const {
+        for (std::size_t ind = 0; ind < detail::stats_count; ++ind) {
+            const auto id = static_cast<detail::stats_id>(ind);
+            values[ind] = finished[ind];
+            for (const auto* counters : threads)
+                values[ind] += counters->get(id);
+        }
+    }
+};
+
+stats_registry& registry() {
+    static stats_registry reg;
+    return reg;
+}
+
+#endif // UPA_ENABLE_STATS
+
+} // namespace
+
+#ifdef UPA_ENABLE_STATS
+
+namespace detail {
+
+stats_counters::stats_counters() {
+    auto& reg = registry();
+    const std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.push_back(this);
+}
+
+stats_counters::~stats_counters() {
+    auto& reg = registry();
+    const std::lock_guard<std::mutex> lock(reg.mutex);
+    for (std::size_t ind = 0; ind < stats_count; ++ind)
+        reg.finished[ind] += get(static_cast<stats_id>(ind));
+    reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), this));
+}
+
+} // namespace detail
+
+url_stats url_stats::snapshot() {
+    std::uint64_t values[detail::stats_count];
+    auto& reg = registry();
+    {
+        const std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.sum(values);
+        for (std::size_t ind = 0; ind < detail::stats_count; ++ind)
+            values[ind] -= reg.baseline[ind];
+    }
+
+    url_stats stats;
+    for (std::size_t ind = 0; ind < detail::stats_count; ++ind)
+        stats.*kStatsFields[ind].member = values[ind];
+    return stats;
+}
+
+void url_stats::reset() {
+    auto& reg = registry();
+    const std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.sum(reg.baseline);
+}
+
+#else
+
+url_stats url_stats::snapshot() {
+    return {};
+}
+
+void url_stats::reset() {}
+
+#endif // UPA_ENABLE_STATS
+
+std::ostream& operator<<(std::ostream& os, const url_stats& stats) {
+    for (const auto& field : kStatsFields)
+        os << field.name << ": " << stats.*field.member << '\n';
+    return os;
+}
+
+} // namespace upa
@@ -0,0 +1,238 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_stream_parser.h"
+#include <algorithm>
+#include <utility>
+
+namespace upa {
+namespace {
+
+inline bool is_trim_byte(char c) noexcept {
+    // C0 control or space
+    return static_cast<unsigned char>(c) <= 0x20;
+}
+
+inline bool is_continuation_byte(char c) noexcept {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// The length of the UTF-8 sequence started with the lead byte `c`, or 1 if `c`
+// is not a valid lead byte
+inline std::size_t utf8_sequence_length(char c) noexcept {
+    const auto uc = static_cast<unsigned char>(c);
+    if (uc >= 0xC2 && uc <= 0xDF) return 2;
+    if (uc >= 0xE0 && uc <= 0xEF) return 3;
+    if (uc >= 0xF0 && uc <= 0xF4) return 4;
+    return 1;
+}
+
+// The start of the incomplete UTF-8 sequence at the end of (first, last), or
+// `last` if there is none
+inline const char* find_incomplete_utf8(const char* first, const char* last) noexcept {
+    const auto max_len = std::min<std::ptrdiff_t>(last - first, 3);
+    for (std::ptrdiff_t len = 1; len <= max_len; ++len) {
+        const char c = *(last - len);
+        if (!is_continuation_byte(c)) {
+            return static_cast<std::ptrdiff_t>(utf8_sequence_length(c)) > len
+                ? last - len : last;
+        }
+    }
+    return last;
+}
+
+// UTF-8 percent-encodes bytes (first, last) which are not in `cpset`, and
+// appends to `output`; as in the query and fragment states of url_parser
+inline void append_encoded(const char* first, const char* last, const code_point_set& cpset,
+    std::string& output)
+{
+    auto pointer = first;
+    while (pointer != last) {
+        const auto uc = static_cast<unsigned char>(*pointer);
+        if (uc >= 0x80) {
+            // invalid utf-8 sequences will be replaced with kUnicodeReplacementCharacter
+            detail::append_utf8_percent_encoded_char(pointer, last, output);
+        } else {
+            if (detail::is_char_in_set(uc, cpset))
+                output.push_back(static_cast<char>(uc));
+            else
+                detail::append_percent_encoded_byte(uc, output);
+            ++pointer;
+        }
+    }
+}
+
+} // namespace
+
+
+void url_stream_parser::reset(const url* base) {
+    base_ = base;
+    state_ = state::prefix;
+    error_ = validation_errc::ok;
+    url_.clear();
+    prefix_.clear();
+    pending_utf8_.clear();
+    pending_trim_.clear();
+}
+
+bool url_stream_parser::push(std::string_view chunk) {
+    const char* first = chunk.data();
+    const char* last = first + chunk.length();
+
+    if (state_ == state::prefix) {
+        // the query or fragment starts at the first '?' or '#'
+        const auto pos = chunk.find_first_of("?#");
+        if (pos == std::string_view::npos) {
+            prefix_.append(chunk);
+            return true;
+        }
+        prefix_.append(first, pos);
+        start_tail(chunk[pos]);
+        first += pos + 1;
+    }
+    if (state_ == state::failed)
+        return false;
+
+    append_tail(first, last);
+    return true;
+}
+
+validation_errc url_stream_parser::finish(url& output) {
+    validation_errc res = error_;
+    switch (state_) {
+    case state::prefix:
+        res = url_.parse(prefix_, base_);
+        break;
+    case state::query:
+    case state::fragment:
+        // the incomplete UTF-8 sequence is invalid; the trailing C0 controls
+        // and spaces are removed
+        if (!pending_utf8_.empty())
+            encode(pending_utf8_.data(), pending_utf8_.data() + pending_utf8_.length());
+        url_.parse_search_params();
+        break;
+    case state::failed:
+        break;
+    }
+    if (res == validation_errc::ok)
+        output = std::move(url_);
+
+    reset(base_);
+    return res;
+}
+
+// Parses the URL before the query or fragment, and starts the query or
+// fragment
+void url_stream_parser::start_tail(char delimiter) {
+    // the URL with the empty query or fragment
+    prefix_.push_back(delimiter);
+    error_ = url_.parse(prefix_, base_);
+    prefix_.clear();
+
+    if (error_ != validation_errc::ok)
+        state_ = state::failed;
+    else
+        state_ = delimiter == '?' ? state::query : state::fragment;
+}
+
+void url_stream_parser::append_tail(const char* first, const char* last) {
+    UPA_STATS_ADD(bytes_parsed, static_cast<std::uint64_t>(last - first));
+
+    // remove all ASCII tab or newline
+    simple_buffer<char> buff_no_ws;
+    detail::do_remove_whitespace(first, last, buff_no_ws);
+
+    while (state_ == state::query) {
+        const auto* end_of_query = std::find(first, last, '#');
+        encode_tail(first, end_of_query);
+        if (end_of_query == last)
+            return;
+
+        // the bytes kept at the end of the query are not the trailing ones
+        encode(pending_utf8_.data(), pending_utf8_.data() + pending_utf8_.length());
+        encode(pending_trim_.data(), pending_trim_.data() + pending_trim_.length());
+        pending_utf8_.clear();
+        pending_trim_.clear();
+
+        // start the fragment
+        url_.clear_hash_value();
+        url_.norm_url_.push_back('#');
+        url_.part_end_[url::FRAGMENT] = url_.norm_url_.length();
+        url_.set_flag(url::FRAGMENT_FLAG);
+        state_ = state::fragment;
+        first = end_of_query + 1;
+    }
+    encode_tail(first, last);
+}
+
+// Encodes the bytes, but keeps the incomplete UTF-8 sequence and the C0
+// controls and spaces at the end, as they can be completed or removed later
+void url_stream_parser::encode_tail(const char* first, const char* last) {
+    if (!pending_utf8_.empty()) {
+        complete_pending_utf8(first, last);
+        if (!pending_utf8_.empty())
+            return;
+    }
+    if (first == last)
+        return;
+
+    const auto* end_of_text = last;
+    while (end_of_text != first && is_trim_byte(*(end_of_text - 1)))
+        --end_of_text;
+    if (end_of_text == first) {
+        pending_trim_.append(first, last);
+        return;
+    }
+
+    // the kept C0 controls and spaces are followed by other bytes
+    encode(pending_trim_.data(), pending_trim_.data() + pending_trim_.length());
+    pending_trim_.clear();
+
+    if (end_of_text == last) {
+        const auto* incomplete = find_incomplete_utf8(first, last);
+        pending_utf8_.assign(incomplete, last);
+        last = incomplete;
+    } else {
+        pending_trim_.assign(end_of_text, last);
+        last = end_of_text;
+    }
+    encode(first, last);
+}
+
+// Completes the UTF-8 sequence kept from the previous chunk with the
+// continuation bytes from the (first, last), and encodes it if it is
+// complete or can not be completed
+void url_stream_parser::complete_pending_utf8(const char*& first, const char* last) {
+    std::size_t need = utf8_sequence_length(pending_utf8_.front()) - pending_utf8_.length();
+    while (need != 0 && first != last && is_continuation_byte(*first)) {
+        pending_utf8_.push_back(*first++);
+        --need;
+    }
+    if (need == 0 || first != last) {
+        encode(pending_utf8_.data(), pending_utf8_.data() + pending_utf8_.length());
+        pending_utf8_.clear();
+    }
+}
+
+// Percent-encodes bytes and appends to the query or fragment
+void url_stream_parser::encode(const char* first, const char* last) {
+    if (first == last)
+        return;
+
+    url_.clear_hash_value();
+    std::string& output = url_.norm_url_;
+    if (state_ == state::query) {
+        UPA_STATS_COMPONENT(pct_encoded_query);
+        append_encoded(first, last, url_.is_special_scheme()
+            ? special_query_no_encode_set
+            : query_no_encode_set, output);
+        url_.part_end_[url::QUERY] = output.length();
+    } else {
+        UPA_STATS_COMPONENT(pct_encoded_fragment);
+        append_encoded(first, last, fragment_no_encode_set, output);
+        url_.part_end_[url::FRAGMENT] = output.length();
+    }
+}
+
+} // namespace upa
@@ -0,0 +1,213 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url_table.h"
+#include <cstring>
+#include <fstream>
+
+namespace upa {
+namespace {
+
+// File format (native byte order):
+//   file_header
+//   row end offsets: std::uint64_t[row_count]
+//   flags: std::uint32_t[row_count]
+//   part end offsets: std::uint32_t[row_count] for each url::PartType
+//   serialized URLs: char[char_count]
+
+struct file_header {
+    char magic[8];
+    std::uint32_t byte_order;
+    std::uint32_t part_count;
+    std::uint64_t row_count;
+    std::uint64_t char_count;
+};
+
+constexpr char kMagic[8] = { 'U', 'P', 'A', 'U', 'R', 'L', 'T', '1' };
+constexpr std::uint32_t kByteOrder = 0x01020304;
+
+template <typename T>
+bool write_array(std::ofstream& file, const T* data, std::size_t size) {
+    return !!file.write(reinterpret_cast<const char*>(data),
+        static_cast<std::streamsize>(size * sizeof(T)));
+}
+
+} // namespace
+
+std::size_t url_table::memory_size() const noexcept {
+    std::size_t size = chars_.capacity_bytes() + row_end_.capacity_bytes() +
+        flags_.capacity_bytes();
+    for (const auto& col : part_end_)
+        size += col.capacity_bytes();
+    return size;
+}
+
+void url_table::clear() noexcept {
+    chars_.clear();
+    row_end_.clear();
+    for (auto& col : part_end_)
+        col.clear();
+    flags_.clear();
+    file_.close();
+}
+
+void url_table::reserve(size_type rows, std::size_t chars) {
+    detach();
+    chars_.vec().reserve(chars);
+    row_end_.vec().reserve(rows);
+    for (auto& col : part_end_)
+        col.vec().reserve(rows);
+    flags_.vec().reserve(rows);
+}
+
+void url_table::detach() {
+    if (file_.is_open()) {
+        chars_.vec();
+        row_end_.vec();
+        for (auto& col : part_end_)
+            col.vec();
+        flags_.vec();
+        file_.close();
+    }
+}
+
+bool url_table::push_back(const url& u) {
+    if (!u.is_valid() || u.norm_url_.length() > std::numeric_limits<offset_type>::max())
+        return false;
+    detach();
+    auto& chars = chars_.vec();
+    chars.insert(chars.end(), u.norm_url_.begin(), u.norm_url_.end());
+    row_end_.vec().push_back(chars.size());
+    for (std::size_t ind = 0; ind < url::PART_COUNT; ++ind)
+        part_end_[ind].vec().push_back(static_cast<offset_type>(u.part_end_[ind]));
+    flags_.vec().push_back(u.flags_ & ~url::HASH_VALUE_FLAG);
+    return true;
+}
+
+void url_table::append(const url_table& other) {
+    if (other.empty())
+        return;
+    detach();
+    const std::size_t chars_offset = chars_.size();
+    auto& chars = chars_.vec();
+    chars.insert(chars.end(), other.chars_.data(), other.chars_.data() + other.chars_.size());
+    auto& row_end = row_end_.vec();
+    for (size_type row = 0; row < other.size(); ++row)
+        row_end.push_back(other.row_end_[row] + chars_offset);
+    for (std::size_t ind = 0; ind < url::PART_COUNT; ++ind) {
+        const auto& src = other.part_end_[ind];
+        part_end_[ind].vec().insert(part_end_[ind].vec().end(), src.data(), src.data() + src.size());
+    }
+    auto& flags = flags_.vec();
+    flags.insert(flags.end(), other.flags_.data(), other.flags_.data() + other.flags_.size());
+}
+
+url url_table::get_url(size_type row) const {
+    url u;
+    u.norm_url_.assign(href(row));
+    for (std::size_t ind = 0; ind < url::PART_COUNT; ++ind)
+        u.part_end_[ind] = part_end_[ind][row];
+    u.flags_ = flags_[row];
+    if (!u.has_opaque_path()) {
+        // each path segment starts with '/'
+        const auto path = u.get_part_view(url::PATH);
+        u.path_segment_count_ = static_cast<std::size_t>(
+            std::count(path.begin(), path.end(), '/'));
+    }
+    u.scheme_inf_ = detail::get_scheme_info(u.get_part_view(url::SCHEME));
+    return u;
+}
+
+bool url_table::save(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        return false;
+
+    file_header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byte_order = kByteOrder;
+    header.part_count = url::PART_COUNT;
+    header.row_count = size();
+    header.char_count = chars_.size();
+
+    bool ok = write_array(file, &header, 1) &&
+        write_array(file, row_end_.data(), row_end_.size()) &&
+        write_array(file, flags_.data(), flags_.size());
+    for (const auto& col : part_end_)
+        ok = ok && write_array(file, col.data(), col.size());
+    ok = ok && write_array(file, chars_.data(), chars_.size());
+    file.close();
+    return ok && !file.fail();
+}
+
+bool url_table::load(const std::filesystem::path& path) {
+    clear();
+
+    mapped_file file;
+    if (!file.open(path) || file.size() < sizeof(file_header))
+        return false;
+
+    file_header header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.byte_order != kByteOrder ||
+        header.part_count != url::PART_COUNT)
+        return false;
+
+    // check file size
+    const std::uint64_t rows = header.row_count;
+    const std::uint64_t max_rows = (file.size() - sizeof(file_header)) /
+        (sizeof(std::uint64_t) + sizeof(std::uint32_t) * (1 + url::PART_COUNT));
+    if (rows > max_rows)
+        return false;
+    const std::size_t offsets_size = static_cast<std::size_t>(rows) *
+        (sizeof(std::uint64_t) + sizeof(std::uint32_t) * (1 + url::PART_COUNT));
+    if (header.char_count != file.size() - sizeof(file_header) - offsets_size)
+        return false;
+
+    // mapping is page aligned, so arrays are properly aligned
+    const char* ptr = file.data() + sizeof(file_header);
+    const auto* row_end = reinterpret_cast<const std::uint64_t*>(ptr);
+    ptr += rows * sizeof(std::uint64_t);
+    const auto* flags = reinterpret_cast<const std::uint32_t*>(ptr);
+    ptr += rows * sizeof(std::uint32_t);
+    std::array<const offset_type*, url::PART_COUNT> part_end{};
+    for (auto& col : part_end) {
+        col = reinterpret_cast<const offset_type*>(ptr);
+        ptr += rows * sizeof(offset_type);
+    }
+
+    // validate rows with the same checks as url::load_record
+    const char* chars = ptr;
+    std::uint64_t start = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (row_end[row] < start || row_end[row] > header.char_count)
+            return false;
+        const std::string_view str{ chars + start, static_cast<std::size_t>(row_end[row] - start) };
+        // the part end offsets after the last non-zero one are zero
+        std::array<std::size_t, url::PART_COUNT> row_part_end{};
+        std::size_t part_count = 0;
+        for (std::size_t ind = 0; ind < url::PART_COUNT; ++ind) {
+            row_part_end[ind] = part_end[ind][row];
+            if (row_part_end[ind] != 0)
+                part_count = ind + 1;
+        }
+        if (!url::is_valid_record(str, row_part_end, part_count, flags[row]))
+            return false;
+        start = row_end[row];
+    }
+    if (start != header.char_count)
+        return false;
+
+    const auto row_count = static_cast<std::size_t>(rows);
+    chars_.set_external(ptr, static_cast<std::size_t>(header.char_count));
+    row_end_.set_external(row_end, row_count);
+    flags_.set_external(flags, row_count);
+    for (std::size_t ind = 0; ind < url::PART_COUNT; ++ind)
+        part_end_[ind].set_external(part_end[ind], row_count);
+    file_ = std::move(file);
+    return true;
+}
+
+} // namespace upa
@@ -0,0 +1,219 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Adversarial input shapes for the algorithmic complexity checks
+//
+// Every shape makes an input of about n bytes, which stresses one part of
+// the library (mostly the parts exercised by the fuzz-url and fuzz-urlpattern
+// targets), and runs the operation on it. The running time and allocated
+// bytes of the operations of kShapes must grow linearly (or nearly so) with
+// n; see test-adversarial.cpp and bench-adversarial.cpp. The shapes of
+// kSuperlinearShapes have known superlinear costs.
+
+#ifndef UPA_ADVERSARIAL_INPUTS_H
+#define UPA_ADVERSARIAL_INPUTS_H
+
+#include "upa/public_suffix_list.h"
+#include "upa/url.h"
+#include "upa/url_finder.h"
+#include "upa/urlpattern.h"
+#ifdef UPA_TEST_WITH_STD_REGEX
+# include "upa/regex_engine_std.h"
+#else
+# include "upa/regex_engine_srell.h"
+#endif
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace adversarial {
+
+#ifdef UPA_TEST_WITH_STD_REGEX
+using urlpattern = upa::urlpattern<upa::regex_engine_std>;
+#else
+using urlpattern = upa::urlpattern<upa::regex_engine_srell>;
+#endif
+
+struct shape {
+    const char* name;
+    // makes the input of about n bytes
+    std::string (*make_input)(std::size_t n);
+    // runs the operation; the result is used to prevent optimizing away
+    std::size_t (*run)(const std::string& input);
+};
+
+inline std::string repeat(std::string_view str, std::size_t count) {
+    std::string res;
+    res.reserve(str.length() * count);
+    for (std::size_t ind = 0; ind < count; ++ind)
+        res.append(str);
+    return res;
+}
+
+// Label of distinct CJK ideographs: the worst case of the punycode encoder
+inline std::string cjk_label(std::size_t count) {
+    std::string res;
+    for (std::size_t ind = 0; ind < count; ++ind) {
+        const auto cp = static_cast<unsigned>(0x4E00 + ind % 0x5000);
+        res.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        res.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        res.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    return res;
+}
+
+inline std::size_t parse_url(const std::string& input) {
+    upa::url url;
+    if (upa::success(url.parse(input)))
+        return url.href().length();
+    return 0;
+}
+
+inline const upa::public_suffix_list& test_psl() {
+    static const upa::public_suffix_list psl = [] {
+        upa::public_suffix_list res;
+        upa::public_suffix_list::push_context ctx;
+        for (const char* line : { "com", "uk", "co.uk", "*.ck", "!www.ck" })
+            res.push_line(ctx, line);
+        res.finalize(ctx);
+        return res;
+    }();
+    return psl;
+}
+
+inline std::size_t find_urls(const std::string& input) {
+    const upa::url_finder finder{ &test_psl() };
+    return finder.find_all(input).size();
+}
+
+inline std::size_t match_urlpattern(const std::string& pathname_pattern, const std::string& input) {
+    upa::urlpattern_init init;
+    init.pathname = pathname_pattern;
+    const urlpattern urlp{ init };
+    return urlp.test(input) ? 1 : 0;
+}
+
+inline const shape kShapes[] = {
+    // url_setter::shorten_path
+    { "path: a/../ segments",
+        [](std::size_t n) { return "http://h/" + repeat("a/", n / 5) + repeat("../", n / 5); },
+        parse_url },
+    { "path: ../ segments at root",
+        [](std::size_t n) { return "http://h/" + repeat("../", n / 3); },
+        parse_url },
+    { "path: %2e%2E/ segments",
+        [](std::size_t n) { return "file:///" + repeat("a/%2e%2E/", n / 10); },
+        parse_url },
+    // percent encoding and decoding
+    { "percent: runs of %",
+        [](std::size_t n) {
+            const std::string run(n / 3, '%');
+            return "http://h/" + run + '?' + run + '#' + run;
+        },
+        [](const std::string& input) {
+            return parse_url(input) + upa::percent_decode(input).length();
+        } },
+    { "percent: runs of %%2",
+        [](std::size_t n) { return "non-spec:/" + repeat("%%2", n / 3); },
+        [](const std::string& input) {
+            return parse_url(input) + upa::percent_decode(input).length();
+        } },
+    // IPv6 parser
+    { "IPv6: :: compressions",
+        [](std::size_t n) { return "http://[" + repeat("::", n / 2) + ']'; },
+        parse_url },
+    { "IPv6: pieces",
+        [](std::size_t n) { return "http://[" + repeat("1:", n / 2) + ":]"; },
+        parse_url },
+    // public_suffix_list label splitter
+    { "PSL: empty labels",
+        [](std::size_t n) { return "a" + std::string(n, '.') + "com"; },
+        [](const std::string& input) {
+            const auto res = test_psl().get_suffix_info(input,
+                upa::public_suffix_list::option::registrable_domain);
+            return res.first_label_pos;
+        } },
+    { "PSL: many labels",
+        [](std::size_t n) { return repeat("a.", n / 2) + "co.uk"; },
+        [](const std::string& input) {
+            const auto res = test_psl().get_suffix_info(input,
+                upa::public_suffix_list::option::registrable_domain);
+            return res.first_label_pos;
+        } },
+    // IDNA: punycode decoder and encoder (labels of bounded length)
+    { "IDNA: many non-ASCII labels",
+        [](std::size_t n) { return "http://" + repeat(cjk_label(60) + '.', n / 181) + "com/"; },
+        parse_url },
+    // url_finder candidate scanning
+    { "url_finder: unparsable scheme:// candidates",
+        [](std::size_t n) { return repeat("a://[", n / 5); },
+        find_urls },
+    { "url_finder: trailing closing brackets",
+        [](std::size_t n) { return "http://a" + std::string(n, ')'); },
+        find_urls },
+    { "url_finder: unbalanced brackets",
+        [](std::size_t n) { return repeat("a://(", n / 6) + std::string(n / 6, ')'); },
+        find_urls },
+    { "url_finder: unparsable www. candidates",
+        [](std::size_t n) { return repeat("www.a[", n / 6); },
+        find_urls },
+    // url_search_params
+    { "search params: runs of &",
+        [](std::size_t n) { return std::string(n, '&'); },
+        [](const std::string& input) {
+            upa::url_search_params params{ input };
+            params.sort();
+            return params.to_string().length();
+        } },
+    { "search params: many pairs",
+        [](std::size_t n) { return repeat("b=1&a=2&", n / 8); },
+        [](const std::string& input) {
+            upa::url_search_params params{ input };
+            params.sort();
+            return params.to_string().length();
+        } },
+    // urlpattern constructor and regular expression matching
+    { "urlpattern: long pattern",
+        [](std::size_t n) { return "/" + repeat("a/", n / 2) + ":id"; },
+        [](const std::string& input) {
+            return match_urlpattern(input, "http://h/");
+        } },
+    { "urlpattern: long input",
+        [](std::size_t n) { return "http://h/" + std::string(n / 2, 'a') + '/' + repeat("b-", n / 4); },
+        [](const std::string& input) {
+            return match_urlpattern("/:first/*", input);
+        } },
+};
+
+// Shapes with known superlinear costs. These are only benchmarked, with
+// small inputs:
+// * the punycode encoder and decoder are quadratic in the label length, as
+//   in the reference implementation of RFC 3492; labels are not limited in
+//   length by the URL Standard;
+// * the backtracking regular expression engines take polynomial time to
+//   reject an input for the patterns with several wildcards.
+inline const shape kSuperlinearShapes[] = {
+    { "IDNA: long xn-- label",
+        [](std::size_t n) { return "http://xn--" + repeat("9z", n / 2) + ".com/"; },
+        parse_url },
+    { "IDNA: long non-ASCII label",
+        [](std::size_t n) { return "http://" + cjk_label(n / 3) + ".com/"; },
+        parse_url },
+    { "urlpattern: wildcards backtracking",
+        [](std::size_t n) { return "http://h/" + repeat("a-", n / 2); },
+        [](const std::string& input) {
+            return match_urlpattern("/*-*-*/end", input);
+        } },
+    { "urlpattern: named groups backtracking",
+        [](std::size_t n) { return "http://h/" + repeat("a-", n / 2); },
+        [](const std::string& input) {
+            return match_urlpattern("/:a-:b-:c/end", input);
+        } },
+};
+
+} // namespace adversarial
+
+#endif // UPA_ADVERSARIAL_INPUTS_H
@@ -0,0 +1,93 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "adversarial-inputs.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// Benchmark the operation on growing inputs and fit the complexity
+//
+// The inputs grow from min_n to max_n bytes, doubling each time. The fitted
+// complexity of linear operations must be O(n).
+
+template <class MakeInput, class Run>
+void benchmark_shape(const std::string& name, MakeInput&& make_input, Run&& run,
+    std::size_t min_n, std::size_t max_n, std::uint64_t min_iters)
+{
+    ankerl::nanobench::Bench bench;
+    bench.title(name).unit("run").minEpochIterations(min_iters);
+
+    std::string input;
+    for (std::size_t n = min_n; n <= max_n; n *= 2) {
+        input = make_input(n);
+        bench.complexityN(input.size()).run(name + " (" + std::to_string(input.size()) + " bytes)", [&] {
+            ankerl::nanobench::doNotOptimizeAway(run(input));
+        });
+    }
+    bench_alloc::report(name.c_str(), input.size(), "byte", [&] {
+        ankerl::nanobench::doNotOptimizeAway(run(input));
+    });
+    std::cout << bench.complexityBigO() << '\n';
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc > 1 && argv[1][0] == '-') {
+        std::cerr << "Usage: bench-adversarial [<min iterations>] [<seed file>...]\n"
+            "Seed files (for example, fuzzer inputs) are repeated to make URLs\n"
+            "of growing length.\n";
+        return 1;
+    }
+
+    const std::uint64_t min_iters = argc > 1
+        ? get_positive_or_default(argv[1], min_iters_def)
+        : min_iters_def;
+
+    for (const auto& shp : adversarial::kShapes)
+        benchmark_shape(shp.name, shp.make_input, shp.run, 1024, 32768, min_iters);
+
+    for (const auto& shp : adversarial::kSuperlinearShapes)
+        benchmark_shape(shp.name, shp.make_input, shp.run, 32, 256, min_iters);
+
+    // Seed files
+    for (int ind = 2; ind < argc; ++ind) {
+        std::ifstream finp(argv[ind], std::ios::in | std::ios::binary);
+        if (!finp.is_open()) {
+            std::cerr << "Failed to open " << argv[ind] << '\n';
+            return 2;
+        }
+        const std::string seed{ std::istreambuf_iterator<char>(finp), std::istreambuf_iterator<char>() };
+        if (seed.empty())
+            continue;
+
+        benchmark_shape(std::string{ "seed: " } + argv[ind],
+            [&](std::size_t n) { return adversarial::repeat(seed, n / seed.length() + 1); },
+            adversarial::parse_url, 1024, 32768, min_iters);
+    }
+
+    return 0;
+}
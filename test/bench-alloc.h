@@ -0,0 +1,129 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Memory allocation tracking for the benchmarks
+//
+// If the UPA_BENCH_ALLOC macro is defined (see the UPA_BENCH_ALLOC CMake
+// option), this header replaces the global operator new and operator delete
+// to count the allocations of each thread, and bench_alloc::report() prints
+// the allocation counts and bytes of the benchmarked operation. Otherwise
+// report() does nothing, so the timings are not affected.
+//
+// The header defines the replacement functions, so it must be included in
+// exactly one translation unit of the benchmark executable.
+
+#ifndef UPA_BENCH_ALLOC_H
+#define UPA_BENCH_ALLOC_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace bench_alloc {
+
+struct counters {
+    std::uint64_t allocs = 0;
+    std::uint64_t bytes = 0;
+};
+
+#ifdef UPA_BENCH_ALLOC
+
+inline constexpr bool enabled = true;
+
+// The counters of the current thread
+inline thread_local counters thread_counters;
+
+#else
+
+inline constexpr bool enabled = false;
+
+#endif
+
+// Runs `op` once and prints the allocations and allocated bytes per unit,
+// where `batch` is the number of units processed by `op`
+template <class Op>
+inline void report(const char* name, std::uint64_t batch, const char* unit, Op&& op) {
+#ifdef UPA_BENCH_ALLOC
+    const counters before = thread_counters;
+    op();
+    const counters after = thread_counters;
+
+    const double div = batch ? static_cast<double>(batch) : 1.0;
+    std::cout << "| " << static_cast<double>(after.allocs - before.allocs) / div << " allocs/" << unit
+        << " | " << static_cast<double>(after.bytes - before.bytes) / div << " B/" << unit
+        << " | " << name << '\n';
+#else
+    static_cast<void>(name);
+    static_cast<void>(batch);
+    static_cast<void>(unit);
+    static_cast<void>(op);
+#endif
+}
+
+} // namespace bench_alloc
+
+#ifdef UPA_BENCH_ALLOC
+
+// Replaceable global allocation functions
+// https://en.cppreference.com/w/cpp/memory/new/operator_new
+
+// NOLINTBEGIN(*-no-malloc,*-owning-memory)
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+# pragma GCC diagnostic push
+// the replacement operator delete frees memory allocated by the replacement
+// operator new with std::malloc
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++bench_alloc::thread_counters.allocs;
+    bench_alloc::thread_counters.bytes += size;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+# pragma GCC diagnostic pop
+#endif
+// NOLINTEND(*-no-malloc,*-owning-memory)
+
+#endif // UPA_BENCH_ALLOC
+
+#endif // UPA_BENCH_ALLOC_H
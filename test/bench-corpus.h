@@ -0,0 +1,376 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Deterministic generator of realistic URL corpora for the benchmarks
+//
+// The corpus is described by a named profile (see bench_corpus::kProfiles),
+// which sets the distributions of host label counts and lengths, the shares
+// of IDN, IPv4 and IPv6 hosts, path depth, query parameter counts, escape
+// density, and the share of relative references. The same profile, seed and
+// sample count always produce the same corpus on every platform: the
+// generator uses its own PRNG instead of the <random> distributions, whose
+// results are implementation specific.
+
+#ifndef UPA_BENCH_CORPUS_H
+#define UPA_BENCH_CORPUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench_corpus {
+
+/// Corpus profile
+struct profile {
+    const char* name;
+    const char* description;
+    // hosts
+    std::size_t host_pool_size;  // 0 - every host is new; otherwise hosts are reused
+    unsigned min_labels;         // label count, including the TLD
+    unsigned max_labels;
+    unsigned min_label_length;
+    unsigned max_label_length;
+    double idn_share;
+    double ipv4_share;
+    double ipv6_share;
+    double port_share;
+    double https_share;
+    // path
+    unsigned min_path_depth;
+    unsigned max_path_depth;
+    double file_extension_share;
+    // query and fragment
+    double query_share;
+    unsigned max_query_params;
+    double fragment_share;
+    // share of the characters which are percent-encoded or need encoding
+    double escape_density;
+    // share of the relative references (parsed against a base URL)
+    double relative_share;
+};
+
+inline constexpr profile kProfiles[] = {
+    { "crawler", "links extracted from web pages: many hosts, relative links",
+        0, 2, 4, 3, 14, 0.05, 0.01, 0.002, 0.01, 0.8,
+        0, 6, 0.3,
+        0.3, 4, 0.1,
+        0.02,
+        0.4 },
+    { "cdn-log", "CDN access log: few hosts, deep paths to static files",
+        24, 3, 5, 3, 10, 0.0, 0.05, 0.02, 0.02, 0.6,
+        2, 6, 0.95,
+        0.4, 3, 0.0,
+        0.01,
+        0.0 },
+    { "api-gateway", "REST API requests: service hosts, IDs in paths, many parameters",
+        12, 3, 4, 3, 12, 0.0, 0.1, 0.01, 0.15, 0.9,
+        2, 5, 0.0,
+        0.6, 6, 0.0,
+        0.05,
+        0.2 },
+};
+
+/// @return profile with the given name, or nullptr if not found
+inline const profile* find_profile(std::string_view name) {
+    for (const auto& prof : kProfiles) {
+        if (name == prof.name)
+            return &prof;
+    }
+    return nullptr;
+}
+
+/// Pseudo-random number generator (SplitMix64)
+class prng {
+public:
+    explicit prng(std::uint64_t seed) noexcept : state_(seed) {}
+
+    std::uint64_t next() noexcept {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform integer in [0, n)
+    std::size_t below(std::size_t n) noexcept {
+        return n ? static_cast<std::size_t>(next() % n) : 0;
+    }
+
+    // Uniform integer in [lo, hi]
+    unsigned range(unsigned lo, unsigned hi) noexcept {
+        return lo + static_cast<unsigned>(below(hi - lo + 1));
+    }
+
+    // Integer in [lo, hi], biased towards lo
+    unsigned range_low(unsigned lo, unsigned hi) noexcept {
+        return lo + static_cast<unsigned>(below(below(hi - lo + 1) + 1));
+    }
+
+    // true with the probability p
+    bool chance(double p) noexcept {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53 < p;
+    }
+
+    template <class T, std::size_t N>
+    const T& pick(const T (&items)[N]) noexcept {
+        return items[below(N)];
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+/// URL corpus generator
+class generator {
+public:
+    /// A sample: URL string and optional base URL string
+    using sample = std::pair<std::string, std::string>;
+
+    generator(const profile& prof, std::uint64_t seed)
+        : prof_(prof)
+        , rnd_(seed)
+    {
+        for (std::size_t ind = 0; ind < prof_.host_pool_size; ++ind)
+            host_pool_.push_back(new_host());
+    }
+
+    /// Generates the next sample; the base is empty for absolute URLs
+    sample next() {
+        sample smp;
+        if (rnd_.chance(prof_.relative_share)) {
+            append_relative(smp.first);
+            append_absolute(smp.second, false);
+        } else {
+            append_absolute(smp.first, true);
+        }
+        return smp;
+    }
+
+    /// Generates `count` samples
+    std::vector<sample> generate(std::size_t count) {
+        std::vector<sample> samples;
+        samples.reserve(count);
+        for (std::size_t ind = 0; ind < count; ++ind)
+            samples.push_back(next());
+        return samples;
+    }
+
+private:
+    static constexpr const char* kTlds[] = {
+        "com", "com", "com", "org", "net", "io", "de", "lt", "co.uk", "jp", "info", "dev"
+    };
+    static constexpr const char* kIdnLabels[] = {
+        "\xC5\xBE" "algiris",           // žalgiris
+        "m\xC3\xBCnchen",               // münchen
+        "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xBC\xD0\xB5\xD1\x80", // пример
+        "\xE4\xBE\x8B\xE3\x81\x88",     // 例え
+        "caf\xC3\xA9",                  // café
+        "\xCE\xB4\xCE\xBF\xCE\xBA\xCE\xB9\xCE\xBC\xCE\xAE", // δοκιμή
+    };
+    static constexpr const char* kWords[] = {
+        "index", "news", "article", "products", "category", "images", "static", "assets",
+        "blog", "2024", "2025", "en", "docs", "search", "user", "about", "media", "video",
+        "api", "v1", "v2", "users", "orders", "items", "files", "download", "js", "css"
+    };
+    static constexpr const char* kExtensions[] = {
+        ".html", ".php", ".js", ".css", ".png", ".jpg", ".webp", ".svg", ".woff2", ".json", ".mp4"
+    };
+    static constexpr const char* kQueryKeys[] = {
+        "id", "q", "page", "sort", "limit", "offset", "lang", "v", "utm_source", "utm_medium",
+        "utm_campaign", "ref", "session", "filter", "fields", "w", "h", "format", "token"
+    };
+    static constexpr const char* kEscapes[] = {
+        "%20", "%2F", "%3A", "%C4%85", "%E2%82%AC", " ", "\"", "<", "{", "|",
+        "\xC4\x85", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"
+    };
+
+    void append_chars(std::string& out, std::size_t len, const char* alphabet, std::size_t alphabet_len) {
+        for (std::size_t ind = 0; ind < len; ++ind)
+            out.push_back(alphabet[rnd_.below(alphabet_len)]);
+    }
+
+    void append_alnum(std::string& out, std::size_t len) {
+        static constexpr char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+        append_chars(out, len, alphabet, sizeof(alphabet) - 1);
+    }
+
+    // Appends text, which can contain escapes and characters to encode
+    void append_text(std::string& out, std::string_view text) {
+        for (const char c : text) {
+            if (rnd_.chance(prof_.escape_density))
+                out.append(rnd_.pick(kEscapes));
+            out.push_back(c);
+        }
+    }
+
+    std::string new_label() {
+        std::string label;
+        const unsigned len = rnd_.range_low(prof_.min_label_length, prof_.max_label_length);
+        append_alnum(label, len);
+        if (len >= 5 && rnd_.chance(0.2))
+            label[len / 2] = '-';
+        return label;
+    }
+
+    std::string new_host() {
+        std::string host = new_hostname();
+        if (rnd_.chance(prof_.port_share)) {
+            host.push_back(':');
+            host.append(std::to_string(rnd_.range(1024, 65535)));
+        }
+        return host;
+    }
+
+    std::string new_hostname() {
+        std::string host;
+        if (rnd_.chance(prof_.ipv4_share)) {
+            for (int ind = 0; ind < 4; ++ind) {
+                if (ind) host.push_back('.');
+                host.append(std::to_string(rnd_.below(256)));
+            }
+            return host;
+        }
+        if (rnd_.chance(prof_.ipv6_share)) {
+            static constexpr char hex[] = "0123456789abcdef";
+            host.append("[2001:db8");
+            const unsigned pieces = rnd_.range(1, 6);
+            if (pieces < 6)
+                host.push_back(':'); // compressed zeros
+            for (unsigned ind = 0; ind < pieces; ++ind) {
+                host.push_back(':');
+                append_chars(host, rnd_.range(1, 4), hex, 16);
+            }
+            host.push_back(']');
+            return host;
+        }
+
+        const char* tld = rnd_.pick(kTlds);
+        const unsigned labels = rnd_.range_low(prof_.min_labels, prof_.max_labels);
+        const bool idn = rnd_.chance(prof_.idn_share);
+        const unsigned idn_label = static_cast<unsigned>(rnd_.below(labels - 1));
+        for (unsigned ind = 0; ind + 1 < labels; ++ind) {
+            if (idn && ind == idn_label)
+                host.append(rnd_.pick(kIdnLabels));
+            else if (ind == 0 && labels > 2 && rnd_.chance(0.5))
+                host.append("www");
+            else
+                host.append(new_label());
+            host.push_back('.');
+        }
+        host.append(tld);
+        return host;
+    }
+
+    void append_host(std::string& out) {
+        if (host_pool_.empty()) {
+            out.append(new_host());
+        } else {
+            // the first hosts of the pool are the most popular
+            const std::size_t ind = rnd_.below(rnd_.below(host_pool_.size()) + 1);
+            out.append(host_pool_[ind]);
+        }
+    }
+
+    void append_segment(std::string& out) {
+        switch (rnd_.below(4)) {
+        case 0:
+            // numeric ID
+            out.append(std::to_string(rnd_.next() % 1000000));
+            break;
+        case 1: {
+            // hash
+            static constexpr char hex[] = "0123456789abcdef";
+            append_chars(out, rnd_.range(8, 32), hex, 16);
+            break;
+        }
+        default:
+            append_text(out, rnd_.pick(kWords));
+            break;
+        }
+    }
+
+    void append_path(std::string& out, unsigned depth) {
+        for (unsigned ind = 0; ind < depth; ++ind) {
+            out.push_back('/');
+            append_segment(out);
+        }
+        if (rnd_.chance(prof_.file_extension_share)) {
+            out.push_back('/');
+            append_text(out, rnd_.pick(kWords));
+            out.append(rnd_.pick(kExtensions));
+        } else if (depth == 0) {
+            out.push_back('/');
+        }
+    }
+
+    void append_query_and_fragment(std::string& out) {
+        if (rnd_.chance(prof_.query_share)) {
+            const unsigned count = rnd_.range_low(1, prof_.max_query_params);
+            for (unsigned ind = 0; ind < count; ++ind) {
+                out.push_back(ind ? '&' : '?');
+                out.append(rnd_.pick(kQueryKeys));
+                out.push_back('=');
+                std::string value;
+                append_alnum(value, rnd_.range_low(1, 16));
+                append_text(out, value);
+            }
+        }
+        if (rnd_.chance(prof_.fragment_share)) {
+            out.push_back('#');
+            append_text(out, rnd_.pick(kWords));
+        }
+    }
+
+    void append_absolute(std::string& out, bool query) {
+        out.append(rnd_.chance(prof_.https_share) ? "https://" : "http://");
+        append_host(out);
+        append_path(out, rnd_.range_low(prof_.min_path_depth, prof_.max_path_depth));
+        if (query)
+            append_query_and_fragment(out);
+    }
+
+    void append_relative(std::string& out) {
+        switch (rnd_.below(6)) {
+        case 0:
+            // scheme-relative
+            out.append("//");
+            append_host(out);
+            append_path(out, rnd_.range_low(prof_.min_path_depth, prof_.max_path_depth));
+            break;
+        case 1:
+        case 2:
+            // path-absolute
+            append_path(out, rnd_.range(1, prof_.max_path_depth + 1));
+            break;
+        case 3:
+            // path-relative
+            append_segment(out);
+            append_path(out, rnd_.range_low(0, 2));
+            break;
+        case 4:
+            // dot segments
+            out.append(rnd_.chance(0.5) ? "../" : "./");
+            append_segment(out);
+            break;
+        default:
+            // query only
+            out.append("?page=");
+            out.append(std::to_string(rnd_.range(1, 100)));
+            return;
+        }
+        append_query_and_fragment(out);
+    }
+
+    const profile& prof_;
+    prng rnd_;
+    std::vector<std::string> host_pool_;
+};
+
+} // namespace bench_corpus
+
+#endif // UPA_BENCH_CORPUS_H
@@ -0,0 +1,130 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "bench-alloc.h"
+#include "bench-corpus.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// File path to URL conversion benchmark
+//
+// The POSIX paths are listed in the directory walk order from the synthetic
+// tree: directories of 2 to 8 levels, names with spaces, non-ASCII characters
+// and characters which must be percent-encoded.
+
+std::vector<std::string> make_tree_paths(std::size_t count, std::uint64_t seed) {
+    static const char* const kNames[] = {
+        "src", "include", "docs", "test", "build", "node_modules", "Photos 2024",
+        "My Documents", "r\xC3\xA9sum\xC3\xA9", "\xD0\xB0\xD1\x80\xD1\x85\xD0\xB8\xD0\xB2",
+        "\xE5\x86\x99\xE7\x9C\x9F", "50% off", "a#b", "what?", "[draft]", "x.y.z"
+    };
+    static const char* const kExtensions[] = {
+        ".txt", ".cpp", ".h", ".jpg", ".json", ".tar.gz", ""
+    };
+    const std::size_t kNamesCount = std::size(kNames);
+    const std::size_t kExtCount = std::size(kExtensions);
+
+    bench_corpus::prng rng{ seed };
+    std::vector<std::string> paths;
+    while (paths.size() < count) {
+        // a directory of random depth
+        const unsigned depth = rng.range(2, 8);
+        std::string dir{ "/home/user" };
+        for (unsigned level = 0; level < depth; ++level) {
+            dir += '/';
+            dir += kNames[rng.below(kNamesCount)];
+        }
+        // files of the directory
+        const unsigned files = rng.range_low(1, 40);
+        for (unsigned ind = 0; ind < files && paths.size() < count; ++ind) {
+            std::string path = dir;
+            path += "/file-";
+            path += std::to_string(ind);
+            path += kExtensions[rng.below(kExtCount)];
+            paths.push_back(std::move(path));
+        }
+    }
+    return paths;
+}
+
+int benchmark_paths(std::size_t count, std::uint64_t min_iters) {
+    const auto paths = make_tree_paths(count, 1);
+    std::vector<upa::url> urls;
+    urls.reserve(paths.size());
+    upa::urls_from_file_paths(paths.begin(), paths.end(), std::back_inserter(urls),
+        upa::file_path_format::posix);
+
+    ankerl::nanobench::Bench bench;
+    bench.title("File paths").unit("path").batch(paths.size()).minEpochIterations(min_iters);
+
+    const auto run = [&](const char* name, auto&& op) {
+        bench.run(name, op);
+        bench_alloc::report(name, paths.size(), "path", op);
+    };
+
+    // The previous implementation: percent-encode into the string and parse it
+    run("\"file://\" + percent_encode(path) and parse", [&] {
+        for (const auto& path : paths) {
+            std::string str_url{ "file://" };
+            str_url += upa::percent_encode(path, upa::posix_path_no_encode_set);
+            ankerl::nanobench::doNotOptimizeAway(upa::url{ str_url });
+        }
+    });
+
+    run("url_from_file_path", [&] {
+        for (const auto& path : paths)
+            ankerl::nanobench::doNotOptimizeAway(upa::url_from_file_path(path, upa::file_path_format::posix));
+    });
+
+    std::vector<upa::url> output(paths.size());
+    run("urls_from_file_paths", [&] {
+        upa::urls_from_file_paths(paths.begin(), paths.end(), output.begin(),
+            upa::file_path_format::posix);
+        ankerl::nanobench::doNotOptimizeAway(output);
+    });
+
+    run("path_from_file_url", [&] {
+        for (const auto& url : urls)
+            ankerl::nanobench::doNotOptimizeAway(upa::path_from_file_url(url, upa::file_path_format::posix));
+    });
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t count_def = 100000;
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc > 1 && (argv[1][0] == '-' || argc > 3)) {
+        std::cerr << "Usage: bench-file_path [<path count>] [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::uint64_t count = argc > 1 ? get_positive_or_default(argv[1], count_def) : count_def;
+    const std::uint64_t min_iters = argc > 2 ? get_positive_or_default(argv[2], min_iters_def) : min_iters_def;
+
+    return benchmark_paths(static_cast<std::size_t>(count), min_iters);
+}
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 //
 #include "upa/public_suffix_list.h"
+#include "bench-alloc.h"
 
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include "ankerl/nanobench.h"
@@ -44,14 +45,15 @@ int bench_psl_list(const std::filesystem::path& path, const std::filesystem::pat
         return 1;
     }
 
-    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("public_suffix_list",
-        [&] {
-            for (const auto& str_domain : domain_list) {
-                std::string reg_domain = ps_list.get_suffix(str_domain,
-                    upa::public_suffix_list::option::registrable_domain);
-                ankerl::nanobench::doNotOptimizeAway(reg_domain);
-            }
-        });
+    const auto lookup_all = [&] {
+        for (const auto& str_domain : domain_list) {
+            std::string reg_domain = ps_list.get_suffix(str_domain,
+                upa::public_suffix_list::option::registrable_domain);
+            ankerl::nanobench::doNotOptimizeAway(reg_domain);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("public_suffix_list", lookup_all);
+    bench_alloc::report("public_suffix_list", domain_list.size(), "domain", lookup_all);
 
     return 0;
 }
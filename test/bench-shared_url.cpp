@@ -0,0 +1,106 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/shared_url.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// Number of pipeline stages each URL is passed to
+constexpr std::size_t kStageCount = 8;
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line))) {
+            // the url_search_params object is created by stages which use it
+            url.search_params();
+            urls.push_back(std::move(url));
+        }
+    }
+
+    std::vector<upa::shared_url> shared_urls;
+    shared_urls.reserve(urls.size());
+    for (const auto& url : urls)
+        shared_urls.emplace_back(url);
+
+    // Fan-out: each URL is copied to every stage
+
+    const auto copy_urls = [&] {
+        std::vector<upa::url> url_stages;
+        url_stages.reserve(urls.size() * kStageCount);
+        for (const auto& url : urls) {
+            for (std::size_t stage = 0; stage < kStageCount; ++stage)
+                url_stages.push_back(url);
+        }
+        ankerl::nanobench::doNotOptimizeAway(url_stages);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url fan-out (copy)", copy_urls);
+    bench_alloc::report("upa::url fan-out (copy)", urls.size() * kStageCount, "copy", copy_urls);
+
+    const auto copy_shared_urls = [&] {
+        std::vector<upa::shared_url> shared_stages;
+        shared_stages.reserve(shared_urls.size() * kStageCount);
+        for (const auto& su : shared_urls) {
+            for (std::size_t stage = 0; stage < kStageCount; ++stage)
+                shared_stages.push_back(su);
+        }
+        ankerl::nanobench::doNotOptimizeAway(shared_stages);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::shared_url fan-out", copy_shared_urls);
+    bench_alloc::report("upa::shared_url fan-out", shared_urls.size() * kStageCount, "copy", copy_shared_urls);
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-shared_url <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
@@ -0,0 +1,389 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "upa/url_cache_key.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// URL operations benchmark
+//
+// Every operation is run over all samples; the results are reported per
+// sample ("op"). With the JSON output file, the results can be compared with
+// a baseline using the tools/bench-compare.py script.
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters,
+    const char* json_file_name)
+{
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line)))
+            urls.push_back(std::move(url));
+    }
+    if (urls.empty()) {
+        std::cout << "No valid URLs in " << file_name << '\n';
+        return 2;
+    }
+
+    // Setter values: the components of the next URL
+    const std::size_t count = urls.size();
+    std::vector<std::string> hrefs, hosts, pathnames, searches, hashes;
+    for (std::size_t ind = 0; ind < count; ++ind) {
+        const auto& next = urls[(ind + 1) % count];
+        hrefs.emplace_back(next.href());
+        hosts.emplace_back(next.host());
+        pathnames.emplace_back(next.pathname());
+        searches.emplace_back(next.search());
+        hashes.emplace_back(next.hash());
+    }
+
+    // File paths and file URLs made of the host and path
+    std::vector<std::string> file_paths;
+    std::vector<upa::url> file_urls;
+    for (const auto& url : urls) {
+        std::string path{ "/srv/" };
+        path += url.hostname();
+        path += upa::percent_decode(url.pathname());
+        try {
+            file_urls.push_back(upa::url_from_file_path(path, upa::file_path_format::posix));
+            file_paths.push_back(std::move(path));
+        }
+        catch (const upa::url_error&) {
+            // skip paths with ".." segments and null characters
+        }
+    }
+
+    // HTTP request pieces: scheme, Host header and origin-form request-target
+    struct http_request {
+        std::string scheme, host, target;
+    };
+    std::vector<http_request> requests;
+    for (const auto& url : urls) {
+        if (url.is_special_scheme() && !url.is_file_scheme()) {
+            auto scheme = url.protocol();
+            scheme.remove_suffix(1); // ':'
+            requests.push_back({ std::string{ scheme }, std::string{ url.host() },
+                std::string{ url.pathname() } += url.search() });
+        }
+    }
+
+    // Strings to percent encode and decode
+    std::vector<std::string> decoded, encoded;
+    for (const auto& url : urls) {
+        decoded.push_back(upa::percent_decode(url.href()));
+        encoded.push_back(upa::encode_url_component(decoded.back()));
+    }
+
+    // IP addresses made of the URL hashes
+    struct ipv6_address {
+        std::uint16_t pieces[8];
+    };
+    std::vector<std::uint32_t> ipv4s;
+    std::vector<ipv6_address> ipv6s;
+    for (const auto& url : urls) {
+        const std::size_t hash = url.hash_value();
+        ipv4s.push_back(static_cast<std::uint32_t>(hash));
+        ipv6_address ipv6{};
+        // some zero pieces to exercise the compression
+        for (std::size_t ind = 0; ind < 8; ind += 2)
+            ipv6.pieces[ind] = static_cast<std::uint16_t>(hash >> (ind * 8));
+        ipv6s.push_back(ipv6);
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("URL operations").unit("op").minEpochIterations(min_iters);
+
+    const auto run = [&](const char* name, std::size_t batch, auto&& op) {
+        bench.batch(batch).run(name, op);
+        bench_alloc::report(name, batch, "op", op);
+    };
+
+    // Setters
+
+    std::vector<upa::url> work = urls;
+
+    run("url::href(...)", count, [&] {
+        for (std::size_t ind = 0; ind < count; ++ind)
+            ankerl::nanobench::doNotOptimizeAway(work[ind].href(hrefs[ind]));
+    });
+
+    work = urls;
+    bool https = false;
+    run("url::protocol(...)", count, [&] {
+        const char* protocol = https ? "https:" : "http:";
+        for (auto& url : work)
+            ankerl::nanobench::doNotOptimizeAway(url.protocol(protocol));
+        https = !https;
+    });
+
+    work = urls;
+    run("url::host(...)", count, [&] {
+        for (std::size_t ind = 0; ind < count; ++ind)
+            ankerl::nanobench::doNotOptimizeAway(work[ind].host(hosts[ind]));
+    });
+
+    work = urls;
+    run("url::pathname(...)", count, [&] {
+        for (std::size_t ind = 0; ind < count; ++ind)
+            ankerl::nanobench::doNotOptimizeAway(work[ind].pathname(pathnames[ind]));
+    });
+
+    work = urls;
+    run("url::search(...)", count, [&] {
+        for (std::size_t ind = 0; ind < count; ++ind)
+            work[ind].search(searches[ind]);
+        ankerl::nanobench::doNotOptimizeAway(work);
+    });
+
+    work = urls;
+    run("url::hash(...)", count, [&] {
+        for (std::size_t ind = 0; ind < count; ++ind)
+            work[ind].hash(hashes[ind]);
+        ankerl::nanobench::doNotOptimizeAway(work);
+    });
+
+    // Getters
+
+    run("url getters", count, [&] {
+        std::size_t len = 0;
+        for (const auto& url : urls) {
+            len += url.href().length() + url.protocol().length() + url.host().length() +
+                url.pathname().length() + url.search().length() + url.hash().length();
+        }
+        ankerl::nanobench::doNotOptimizeAway(len);
+    });
+
+    run("url::origin()", count, [&] {
+        for (const auto& url : urls)
+            ankerl::nanobench::doNotOptimizeAway(url.origin());
+    });
+
+    // HTTP request-target
+
+    upa::url request_url;
+    run("url::parse(scheme + \"://\" + host + target)", requests.size(), [&] {
+        for (const auto& req : requests) {
+            std::string str_url = req.scheme;
+            str_url += "://";
+            str_url += req.host;
+            str_url += req.target;
+            ankerl::nanobench::doNotOptimizeAway(request_url.parse(str_url));
+        }
+    });
+
+    run("url::parse_request_target", requests.size(), [&] {
+        for (const auto& req : requests)
+            ankerl::nanobench::doNotOptimizeAway(request_url.parse_request_target(req.scheme, req.host, req.target));
+    });
+
+    // Cache keys
+
+    run("cache key: href + search_params().sort() + hash", count, [&] {
+        for (const auto& url : urls) {
+            upa::url key_url = url;
+            key_url.hash("");
+            key_url.search_params().sort();
+            ankerl::nanobench::doNotOptimizeAway(upa::hash_bytes(key_url.href()));
+        }
+    });
+
+    const upa::cache_key_builder key_builder;
+    std::string key;
+    run("cache_key_builder::append_key", count, [&] {
+        for (const auto& url : urls) {
+            key.clear();
+            ankerl::nanobench::doNotOptimizeAway(key_builder.append_key(url, key));
+        }
+    });
+
+    run("cache_key_builder::fingerprint", count, [&] {
+        for (const auto& url : urls)
+            ankerl::nanobench::doNotOptimizeAway(key_builder.fingerprint(url));
+    });
+
+    // Path segments
+
+    run("pathname split into strings", count, [&] {
+        std::vector<std::string> segments;
+        for (const auto& url : urls) {
+            segments.clear();
+            const auto path = url.pathname();
+            std::size_t pos = path.find('/');
+            while (pos != std::string_view::npos) {
+                const auto next = path.find('/', pos + 1);
+                segments.push_back(upa::percent_decode(path.substr(pos + 1,
+                    next == std::string_view::npos ? next : next - pos - 1)));
+                pos = next;
+            }
+            ankerl::nanobench::doNotOptimizeAway(segments);
+        }
+    });
+
+    run("url::path_segments()", count, [&] {
+        std::size_t len = 0;
+        for (const auto& url : urls) {
+            for (const auto segment : url.path_segments())
+                len += segment.length();
+        }
+        ankerl::nanobench::doNotOptimizeAway(len);
+    });
+
+    run("url::path_segments().decoded()", count, [&] {
+        std::size_t len = 0;
+        for (const auto& url : urls) {
+            for (const auto segment : url.path_segments().decoded())
+                len += segment.length();
+        }
+        ankerl::nanobench::doNotOptimizeAway(len);
+    });
+
+    // File paths
+
+    run("url_from_file_path", file_paths.size(), [&] {
+        for (const auto& path : file_paths)
+            ankerl::nanobench::doNotOptimizeAway(upa::url_from_file_path(path, upa::file_path_format::posix));
+    });
+
+    run("path_from_file_url", file_urls.size(), [&] {
+        for (const auto& url : file_urls)
+            ankerl::nanobench::doNotOptimizeAway(upa::path_from_file_url(url, upa::file_path_format::posix));
+    });
+
+    // Percent encoding
+
+    run("encode_url_component", count, [&] {
+        for (const auto& str : decoded)
+            ankerl::nanobench::doNotOptimizeAway(upa::encode_url_component(str));
+    });
+
+    run("percent_decode", count, [&] {
+        for (const auto& str : encoded)
+            ankerl::nanobench::doNotOptimizeAway(upa::percent_decode(str));
+    });
+
+    // IP address serializers
+
+    run("ipv4_serialize", count, [&] {
+        std::string output;
+        for (const auto ipv4 : ipv4s) {
+            output.clear();
+            upa::ipv4_serialize(ipv4, output);
+            ankerl::nanobench::doNotOptimizeAway(output);
+        }
+    });
+
+    run("ipv6_serialize", count, [&] {
+        std::string output;
+        for (const auto& ipv6 : ipv6s) {
+            output.clear();
+            upa::ipv6_serialize(ipv6.pieces, output);
+            ankerl::nanobench::doNotOptimizeAway(output);
+        }
+    });
+
+    // Copy and move
+
+    run("url copy", count, [&] {
+        for (const auto& url : urls) {
+            upa::url copy{ url }; // NOLINT(performance-unnecessary-copy-initialization)
+            ankerl::nanobench::doNotOptimizeAway(copy);
+        }
+    });
+
+    work = urls;
+    run("url move", count, [&] {
+        for (auto& url : work) {
+            upa::url moved{ std::move(url) };
+            url = std::move(moved);
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    });
+
+    // Parse the owned input string
+
+    run("url parse(const std::string&)", count, [&] {
+        for (const auto& url : urls) {
+            std::string str_url{ url.href() };
+            upa::url parsed;
+            ankerl::nanobench::doNotOptimizeAway(parsed.parse(str_url));
+            ankerl::nanobench::doNotOptimizeAway(parsed);
+        }
+    });
+
+    run("url parse(std::string&&)", count, [&] {
+        for (const auto& url : urls) {
+            std::string str_url{ url.href() };
+            upa::url parsed;
+            ankerl::nanobench::doNotOptimizeAway(parsed.parse(std::move(str_url)));
+            ankerl::nanobench::doNotOptimizeAway(parsed);
+        }
+    });
+
+    // JSON output
+
+    if (json_file_name) {
+        std::ofstream fout(json_file_name);
+        if (!fout.is_open()) {
+            std::cerr << "Failed to open " << json_file_name << '\n';
+            return 2;
+        }
+        ankerl::nanobench::render(ankerl::nanobench::templates::json(), bench, fout);
+        std::cout << "Results saved to: " << json_file_name << '\n';
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url-ops <file containing URLs> [<min iterations>]"
+            " [<JSON output file>]\n"
+            "Compare JSON outputs with: tools/bench-compare.py <baseline> <current>\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters, argc > 3 ? argv[3] : nullptr);
+}
@@ -4,7 +4,10 @@
 //
 
 #include "upa/url.h"
+#include "upa/url_parse_cache.h"
 #include "picojson_util.h"
+#include "bench-alloc.h"
+#include "bench-corpus.h"
 
 #include <cstdint>
 #include <cstdlib>
@@ -12,6 +15,8 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include "ankerl/nanobench.h"
@@ -36,7 +41,7 @@ int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iter
 
     // Run benchmark
 
-    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::parse", [&] {
+    const auto parse_all = [&] {
         upa::url url;
 
         for (const auto& str_url : url_strings) {
@@ -44,7 +49,9 @@ int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iter
 
             ankerl::nanobench::doNotOptimizeAway(url);
         }
-    });
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::parse", parse_all);
+    bench_alloc::report("Upa url::parse", url_strings.size(), "URL", parse_all);
 
     ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::can_parse", [&] {
         for (const auto& str_url : url_strings) {
@@ -54,6 +61,120 @@ int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iter
         }
     });
 
+    // Query parsing
+
+    std::vector<std::string> queries;
+    for (const auto& str_url : url_strings) {
+        upa::url url;
+        if (upa::success(url.parse(str_url)) && !url.search().empty())
+            queries.emplace_back(url.search());
+    }
+
+    const auto parse_queries = [&] {
+        for (const auto& query : queries) {
+            upa::url_search_params params{ query };
+
+            ankerl::nanobench::doNotOptimizeAway(params);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url_search_params", parse_queries);
+    bench_alloc::report("Upa url_search_params", queries.size(), "query", parse_queries);
+
+    // Parser statistics of one pass (if compiled with UPA_ENABLE_STATS)
+
+    if constexpr (upa::url_stats::enabled) {
+        upa::url_stats::reset();
+        parse_all();
+        std::cout << "URL parser statistics (one pass):\n" << upa::url_stats::snapshot();
+    }
+
+    // Parse cache: cold (empty cache) and warm (filled cache)
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url_parse_cache (cold)", [&] {
+        upa::url_parse_cache cache;
+        upa::url url;
+
+        for (const auto& str_url : url_strings) {
+            cache.parse(str_url, nullptr, url);
+
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    });
+
+    upa::url_parse_cache cache;
+    for (const auto& str_url : url_strings)
+        static_cast<void>(cache.get(str_url));
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url_parse_cache (warm)", [&] {
+        upa::url url;
+
+        for (const auto& str_url : url_strings) {
+            cache.parse(str_url, nullptr, url);
+
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    });
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url_parse_cache::get (warm)", [&] {
+        for (const auto& str_url : url_strings) {
+            const auto url = cache.get(str_url);
+
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    });
+
+    const auto stats = cache.stats();
+    std::cout << "url_parse_cache: hits: " << stats.hits
+        << "; misses: " << stats.misses
+        << "; evictions: " << stats.evictions
+        << "; size: " << stats.size << '\n';
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Benchmark samples (URL string and base URL string pairs)
+
+int benchmark_samples(const std::vector<std::pair<std::string, std::string>>& url_samples,
+    std::uint64_t min_iters)
+{
+    const auto parse_all = [&] {
+        upa::url url;
+        upa::url url_base;
+
+        for (const auto& url_strings : url_samples) {
+            upa::url* ptr_base = nullptr;
+            if (!url_strings.second.empty()) {
+                if (!upa::success(url_base.parse(url_strings.second)))
+                    continue; // invalid base
+                ptr_base = &url_base;
+            }
+            url.parse(url_strings.first, ptr_base);
+
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::parse", parse_all);
+    bench_alloc::report("Upa url::parse (bases included)", url_samples.size(), "sample", parse_all);
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::can_parse", [&] {
+        for (const auto& url_strings : url_samples) {
+            bool ok = url_strings.second.empty()
+                ? upa::url::can_parse(url_strings.first)
+                : upa::url::can_parse(url_strings.first, url_strings.second);
+
+            ankerl::nanobench::doNotOptimizeAway(ok);
+        }
+    });
+
+    // Parser statistics of one pass (if compiled with UPA_ENABLE_STATS)
+
+    if constexpr (upa::url_stats::enabled) {
+        upa::url_stats::reset();
+        parse_all();
+        std::cout << "URL parser statistics (one pass, bases included):\n" << upa::url_stats::snapshot();
+    }
+
     return 0;
 }
 
@@ -87,36 +208,21 @@ int benchmark_wpt(const std::filesystem::path& file_name, std::uint64_t min_iter
     if (err != 0)
         return err;
 
-    // Run benchmark
-
-    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::parse", [&] {
-        upa::url url;
-        upa::url url_base;
-
-        for (const auto& url_strings : url_samples) {
-            upa::url* ptr_base = nullptr;
-            if (!url_strings.second.empty()) {
-                if (!upa::success(url_base.parse(url_strings.second)))
-                    continue; // invalid base
-                ptr_base = &url_base;
-            }
-            url.parse(url_strings.first, ptr_base);
-
-            ankerl::nanobench::doNotOptimizeAway(url);
-        }
-    });
+    return benchmark_samples(url_samples, min_iters);
+}
 
-    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("Upa url::can_parse", [&] {
-        for (const auto& url_strings : url_samples) {
-            bool ok = url_strings.second.empty()
-                ? upa::url::can_parse(url_strings.first)
-                : upa::url::can_parse(url_strings.first, url_strings.second);
+// -----------------------------------------------------------------------------
+// Generate samples of the named corpus profile and benchmark
 
-            ankerl::nanobench::doNotOptimizeAway(ok);
-        }
-    });
+int benchmark_profile(const bench_corpus::profile& prof, std::uint64_t min_iters,
+    std::uint64_t count, std::uint64_t seed)
+{
+    std::cout << "Generate " << count << " URL samples of the \"" << prof.name
+        << "\" profile (seed " << seed << "): " << prof.description << '\n';
+    bench_corpus::generator gen(prof, seed);
+    const auto url_samples = gen.generate(static_cast<std::size_t>(count));
 
-    return 0;
+    return benchmark_samples(url_samples, min_iters);
 }
 
 // -----------------------------------------------------------------------------
@@ -132,9 +238,15 @@ std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
 int main(int argc, const char* argv[])
 {
     constexpr std::uint64_t min_iters_def = 3;
+    constexpr std::uint64_t count_def = 10000;
+    constexpr std::uint64_t seed_def = 1;
 
     if (argc < 2) {
-        std::cerr << "Usage: bench-url <file containing URLs> [<min iterations>]\n";
+        std::cerr << "Usage: bench-url <file containing URLs> [<min iterations>]\n"
+            "       bench-url <profile> [<min iterations>] [<sample count>] [<seed>]\n"
+            "Profiles of the generated URL corpora:\n";
+        for (const auto& prof : bench_corpus::kProfiles)
+            std::cerr << "  " << prof.name << " - " << prof.description << '\n';
         return 1;
     }
 
@@ -143,6 +255,15 @@ int main(int argc, const char* argv[])
         ? get_positive_or_default(argv[2], min_iters_def)
         : min_iters_def;
 
+    if (const auto* prof = bench_corpus::find_profile(argv[1])) {
+        const std::uint64_t count = argc > 3
+            ? get_positive_or_default(argv[3], count_def)
+            : count_def;
+        const std::uint64_t seed = argc > 4
+            ? std::strtoull(argv[4], nullptr, 10)
+            : seed_def;
+        return benchmark_profile(*prof, min_iters, count, seed);
+    }
     if (file_name.extension() == ".json") {
         return benchmark_wpt(file_name, min_iters);
     } else if (file_name.extension() == ".txt") {
@@ -0,0 +1,129 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/public_suffix_list.h"
+#include "upa/url_codec.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters,
+    const upa::public_suffix_list* psl)
+{
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    std::size_t hrefs_size = 0;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line))) {
+            hrefs_size += url.href().length();
+            urls.push_back(std::move(url));
+        }
+    }
+
+    // Learn dictionaries
+    upa::url_codec_options options;
+    options.psl = psl;
+    const upa::url_codec codec(urls.begin(), urls.end(), options);
+    std::string dicts;
+    codec.serialize(dicts);
+
+    std::string data;
+    for (const auto& url : urls)
+        codec.encode(url, data);
+
+    // Encode and decode; the throughput (byte/s) is measured in the bytes of
+    // serialized URLs
+
+    const auto encode_all = [&] {
+        std::string output;
+        for (const auto& url : urls)
+            codec.encode(url, output);
+        ankerl::nanobench::doNotOptimizeAway(output);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).batch(hrefs_size).unit("byte")
+        .run("upa::url_codec::encode", encode_all);
+    bench_alloc::report("upa::url_codec::encode", hrefs_size, "byte", encode_all);
+
+    const auto decode_all = [&] {
+        const char* first = data.data();
+        const char* last = first + data.size();
+        std::string href;
+        while (first != last && codec.decode(first, last, href))
+            ankerl::nanobench::doNotOptimizeAway(href);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).batch(hrefs_size).unit("byte")
+        .run("upa::url_codec::decode", decode_all);
+    bench_alloc::report("upa::url_codec::decode", hrefs_size, "byte", decode_all);
+
+    // Compression ratio
+
+    std::cout << "URLs: " << urls.size()
+        << "; hrefs: " << hrefs_size << " bytes"
+        << "; encoded: " << data.size() << " bytes"
+        << "; dictionaries: " << dicts.size() << " bytes\n"
+        << "Compression ratio: "
+        << static_cast<double>(hrefs_size) / static_cast<double>(data.size())
+        << " (with dictionaries: "
+        << static_cast<double>(hrefs_size) / static_cast<double>(data.size() + dicts.size())
+        << ")\n";
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_codec <file containing URLs> [<min iterations>]"
+            " [<public_suffix_list.dat>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    upa::public_suffix_list psl;
+    if (argc > 3 && !psl.load(argv[3])) {
+        std::cerr << "Can not open: " << argv[3] << '\n';
+        return 1;
+    }
+
+    return benchmark_txt(file_name, min_iters, argc > 3 ? &psl : nullptr);
+}
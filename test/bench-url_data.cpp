@@ -0,0 +1,178 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "upa/url_data.h"
+#include "bench-alloc.h"
+#include "bench-corpus.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// data: URL benchmark
+//
+// The data: URLs of the inline images: the base64 body with the percent
+// encoded line breaks every 76 characters, and the percent encoded body.
+
+std::string make_base64_body(std::size_t size, std::uint64_t seed) {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    bench_corpus::prng rng{ seed };
+    std::string body;
+    body.reserve(size + size / 76 * 6 + 8);
+    for (std::size_t ind = 0; ind < size; ++ind) {
+        body += kAlphabet[rng.below(64)];
+        if (ind % 76 == 75)
+            body += "%0D%0A";
+    }
+    // complete the last group of four characters
+    while (size % 4 != 0) {
+        body += '=';
+        ++size;
+    }
+    return body;
+}
+
+std::string make_percent_encoded_body(std::size_t size, std::uint64_t seed) {
+    bench_corpus::prng rng{ seed };
+    std::string body;
+    body.reserve(size * 2);
+    for (std::size_t ind = 0; ind < size; ++ind) {
+        // the bytes which are not ASCII alphanumeric are percent encoded
+        const auto uc = static_cast<unsigned char>(rng.below(256));
+        if ((uc >= '0' && uc <= '9') || (uc >= 'A' && uc <= 'Z') || (uc >= 'a' && uc <= 'z')) {
+            body += static_cast<char>(uc);
+        } else {
+            body += '%';
+            body += "0123456789ABCDEF"[uc >> 4];
+            body += "0123456789ABCDEF"[uc & 0xF];
+        }
+    }
+    return body;
+}
+
+// The separate decoding: percent decode to the string, remove the whitespace,
+// and base64 decode to another string
+std::string decode_base64_copying(std::string_view body) {
+    const std::string decoded = upa::percent_decode(body);
+    std::string str;
+    for (const char c : decoded) {
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\f' && c != '\r')
+            str += c;
+    }
+    while (!str.empty() && str.back() == '=')
+        str.pop_back();
+
+    std::string output;
+    std::uint32_t acc = 0;
+    unsigned count = 0;
+    for (const char c : str) {
+        std::uint32_t value = 0;
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '+') value = 62;
+        else if (c == '/') value = 63;
+        else return {};
+        acc = (acc << 6) | value;
+        if (++count == 4) {
+            output += static_cast<char>(acc >> 16);
+            output += static_cast<char>(acc >> 8);
+            output += static_cast<char>(acc);
+            acc = 0;
+            count = 0;
+        }
+    }
+    if (count == 2) {
+        output += static_cast<char>(acc >> 4);
+    } else if (count == 3) {
+        output += static_cast<char>(acc >> 10);
+        output += static_cast<char>(acc >> 2);
+    }
+    return output;
+}
+
+int benchmark_data_urls(std::size_t size, std::uint64_t min_iters) {
+    const std::string str_base64_url = "data:image/png;base64," + make_base64_body(size, 1);
+    const std::string str_pct_url = "data:application/octet-stream," + make_percent_encoded_body(size / 2, 2);
+
+    const upa::url base64_url{ str_base64_url };
+    const upa::url pct_url{ str_pct_url };
+
+    ankerl::nanobench::Bench bench;
+    bench.title("data: URLs").unit("byte").minEpochIterations(min_iters);
+
+    const auto run = [&](const char* name, std::size_t batch, auto&& op) {
+        bench.batch(batch).run(name, op);
+        bench_alloc::report(name, batch, "byte", op);
+    };
+
+    run("parse base64 data: URL", str_base64_url.length(), [&] {
+        ankerl::nanobench::doNotOptimizeAway(upa::url{ str_base64_url });
+    });
+    run("parse percent encoded data: URL", str_pct_url.length(), [&] {
+        ankerl::nanobench::doNotOptimizeAway(upa::url{ str_pct_url });
+    });
+
+    const auto base64_body = base64_url.get_href().substr(base64_url.get_href().find(',') + 1);
+    run("percent_decode and base64 decode", base64_body.length(), [&] {
+        ankerl::nanobench::doNotOptimizeAway(decode_base64_copying(base64_body));
+    });
+
+    std::vector<char> buff;
+    run("data_url base64 decode_body", base64_body.length(), [&] {
+        upa::data_url du;
+        du.parse(base64_url);
+        buff.resize(du.max_body_size());
+        ankerl::nanobench::doNotOptimizeAway(du.decode_body(buff.data()));
+    });
+
+    const auto pct_body = pct_url.get_href().substr(pct_url.get_href().find(',') + 1);
+    run("percent_decode", pct_body.length(), [&] {
+        ankerl::nanobench::doNotOptimizeAway(upa::percent_decode(pct_body));
+    });
+    run("data_url percent decode_body", pct_body.length(), [&] {
+        upa::data_url du;
+        du.parse(pct_url);
+        buff.resize(du.max_body_size());
+        ankerl::nanobench::doNotOptimizeAway(du.decode_body(buff.data()));
+    });
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t mbytes_def = 1;
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc > 1 && (argv[1][0] == '-' || argc > 3)) {
+        std::cerr << "Usage: bench-url_data [<body size in MB>] [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::uint64_t mbytes = argc > 1 ? get_positive_or_default(argv[1], mbytes_def) : mbytes_def;
+    const std::uint64_t min_iters = argc > 2 ? get_positive_or_default(argv[2], min_iters_def) : min_iters_def;
+
+    return benchmark_data_urls(static_cast<std::size_t>(mbytes << 20), min_iters);
+}
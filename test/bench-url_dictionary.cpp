@@ -0,0 +1,151 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_dictionary.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// Approximate memory used by the std::unordered_set<upa::url> (libstdc++
+// node layout: next pointer, value and cached hash)
+std::size_t approx_memory_size(const std::unordered_set<upa::url>& set) {
+    std::size_t size = set.bucket_count() * sizeof(void*);
+    for (const auto& url : set) {
+        size += sizeof(void*) + sizeof(upa::url) + sizeof(std::size_t);
+        if (url.href().length() >= sizeof(std::string))
+            size += url.href().length() + 1; // heap allocated string
+    }
+    return size;
+}
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line)))
+            urls.push_back(std::move(url));
+    }
+
+    // URLs to lookup: half are contained, half are not
+    std::vector<upa::url> lookup_urls;
+    for (const auto& url : urls) {
+        lookup_urls.push_back(url);
+        upa::url other{ url };
+        other.hash("not-contained");
+        lookup_urls.push_back(std::move(other));
+    }
+
+    // Build
+
+    const auto build_set = [&] {
+        std::unordered_set<upa::url> set(urls.begin(), urls.end());
+        ankerl::nanobench::doNotOptimizeAway(set);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::unordered_set<upa::url> build", build_set);
+    bench_alloc::report("std::unordered_set<upa::url> build", urls.size(), "URL", build_set);
+
+    const auto build_dict = [&] {
+        upa::url_dictionary dict(urls.begin(), urls.end());
+        ankerl::nanobench::doNotOptimizeAway(dict);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_dictionary build", build_dict);
+    bench_alloc::report("upa::url_dictionary build", urls.size(), "URL", build_dict);
+
+    // Lookup
+
+    const std::unordered_set<upa::url> set(urls.begin(), urls.end());
+    const upa::url_dictionary dict(urls.begin(), urls.end());
+
+    const auto lookup_set = [&] {
+        std::size_t count = 0;
+        for (const auto& url : lookup_urls)
+            count += set.count(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::unordered_set<upa::url> lookup", lookup_set);
+    bench_alloc::report("std::unordered_set<upa::url> lookup", lookup_urls.size(), "lookup", lookup_set);
+
+    const auto lookup_dict = [&] {
+        std::size_t count = 0;
+        for (const auto& url : lookup_urls)
+            count += dict.contains(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_dictionary::contains", lookup_dict);
+    bench_alloc::report("upa::url_dictionary::contains", lookup_urls.size(), "lookup", lookup_dict);
+
+    const auto get_all = [&] {
+        std::string href;
+        for (std::size_t ind = 0; ind < dict.size(); ++ind) {
+            dict.get(ind, href);
+            ankerl::nanobench::doNotOptimizeAway(href);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_dictionary::get (ordinal)", get_all);
+    bench_alloc::report("upa::url_dictionary::get (ordinal)", dict.size(), "URL", get_all);
+
+    // Size
+
+    std::size_t hrefs_size = 0;
+    for (const auto& url : set)
+        hrefs_size += url.href().length();
+    std::cout << "Unique URLs: " << dict.size()
+        << "; hrefs: " << hrefs_size << " bytes"
+        << "; std::unordered_set<upa::url>: ~" << approx_memory_size(set) << " bytes"
+        << "; upa::url_dictionary: " << dict.memory_size() << " bytes\n";
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_dictionary <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
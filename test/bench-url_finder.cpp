@@ -0,0 +1,130 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/public_suffix_list.h"
+#include "upa/url_finder.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// Number of prose words between URLs in the generated text
+constexpr std::size_t kWordsPerUrl = 40;
+
+// Prose words; some of them contain `.` and `:` to exercise the candidate
+// rejection
+const char* const kWords[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog.", "See", "also",
+    "version", "1.2.3", "at", "12:30,", "file.txt", "(details)", "ratio", "3:1", "and",
+    "e.g.", "user@example.com", "more", "info:", "text", "about", "it;"
+};
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line), generate a text with URLs
+// and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters,
+    const upa::public_suffix_list* psl)
+{
+    std::string text;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    // Generate text
+    constexpr std::size_t word_count = sizeof(kWords) / sizeof(kWords[0]);
+    std::size_t url_count = 0;
+    std::size_t word_ind = 0;
+    std::string line;
+    while (std::getline(finp, line)) {
+        for (std::size_t ind = 0; ind < kWordsPerUrl; ++ind) {
+            text += kWords[word_ind++ % word_count];
+            text += ' ';
+        }
+        text += line;
+        text += (url_count++ % 3 == 0) ? ".\n" : " ";
+    }
+
+    std::cout << "URLs: " << url_count << "; text: " << text.size() << " bytes\n";
+
+    // Find URLs; the throughput (byte/s) is measured in the bytes of text
+
+    const upa::url_finder finder;
+    std::cout << "Found: " << finder.find_all(text).size() << " URLs\n";
+
+    const auto find_all = [&] {
+        std::size_t pos = 0;
+        upa::url_match match;
+        while (finder.find_next(text, pos, match))
+            ankerl::nanobench::doNotOptimizeAway(match);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).batch(text.size()).unit("byte")
+        .run("upa::url_finder::find_next", find_all);
+    bench_alloc::report("upa::url_finder::find_next", text.size(), "byte", find_all);
+
+    if (psl) {
+        const upa::url_finder finder_psl{ psl };
+        std::cout << "Found with PSL: " << finder_psl.find_all(text).size() << " URLs\n";
+
+        const auto find_all_psl = [&] {
+            std::size_t pos = 0;
+            upa::url_match match;
+            while (finder_psl.find_next(text, pos, match))
+                ankerl::nanobench::doNotOptimizeAway(match);
+        };
+        ankerl::nanobench::Bench().minEpochIterations(min_iters).batch(text.size()).unit("byte")
+            .run("upa::url_finder::find_next with PSL", find_all_psl);
+        bench_alloc::report("upa::url_finder::find_next with PSL", text.size(), "byte", find_all_psl);
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_finder <file containing URLs> [<min iterations>]"
+            " [<public_suffix_list.dat>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    upa::public_suffix_list psl;
+    if (argc > 3 && !psl.load(argv[3])) {
+        std::cerr << "Can not open: " << argv[3] << '\n';
+        return 1;
+    }
+
+    return benchmark_txt(file_name, min_iters, argc > 3 ? &psl : nullptr);
+}
@@ -0,0 +1,193 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// Hasher which uses the standard library string hash function
+struct std_string_hasher {
+    std::size_t operator()(const upa::url& url) const noexcept {
+        return std::hash<std::string_view>{}(url.href());
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line)))
+            urls.push_back(std::move(url));
+    }
+
+    std::vector<upa::url> cached_urls{ urls };
+    for (auto& url : cached_urls)
+        url.cache_hash();
+
+    // Hash functions
+
+    const auto hash_href = [&] {
+        for (const auto& url : urls) {
+            const auto h = std::hash<std::string_view>{}(url.href());
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::hash<std::string_view> href", hash_href);
+    bench_alloc::report("std::hash<std::string_view> href", urls.size(), "URL", hash_href);
+
+    const auto hasher_href = [&] {
+        const upa::url_hasher hasher{ 1 };
+        for (const auto& url : urls) {
+            const auto h = hasher(url);
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_hasher href", hasher_href);
+    bench_alloc::report("upa::url_hasher href", urls.size(), "URL", hasher_href);
+
+    const auto hasher_href_cached = [&] {
+        const upa::url_hasher hasher;
+        for (const auto& url : cached_urls) {
+            const auto h = hasher(url);
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_hasher href (cached)", hasher_href_cached);
+    bench_alloc::report("upa::url_hasher href (cached)", cached_urls.size(), "URL", hasher_href_cached);
+
+    // Component hashes
+
+    const auto hash_origin = [&] {
+        for (const auto& url : urls) {
+            const auto h = std::hash<std::string>{}(url.origin());
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::hash<std::string> origin()", hash_origin);
+    bench_alloc::report("std::hash<std::string> origin()", urls.size(), "URL", hash_origin);
+
+    const auto hasher_origin = [&] {
+        const upa::url_hasher hasher;
+        for (const auto& url : urls) {
+            const auto h = hasher.origin(url);
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_hasher::origin", hasher_origin);
+    bench_alloc::report("upa::url_hasher::origin", urls.size(), "URL", hasher_origin);
+
+    const auto hasher_host = [&] {
+        const upa::url_hasher hasher;
+        for (const auto& url : urls) {
+            const auto h = hasher.host(url);
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_hasher::host", hasher_host);
+    bench_alloc::report("upa::url_hasher::host", urls.size(), "URL", hasher_host);
+
+    const auto hasher_path = [&] {
+        const upa::url_hasher hasher;
+        for (const auto& url : urls) {
+            const auto h = hasher.path(url);
+            ankerl::nanobench::doNotOptimizeAway(h);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_hasher::path", hasher_path);
+    bench_alloc::report("upa::url_hasher::path", urls.size(), "URL", hasher_path);
+
+    // Hash map workloads
+
+    const auto set_std_hasher = [&] {
+        std::unordered_set<upa::url, std_string_hasher> set;
+        for (const auto& url : urls)
+            set.insert(url);
+        std::size_t count = 0;
+        for (const auto& url : urls)
+            count += set.count(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("unordered_set<url, std_string_hasher> insert & find", set_std_hasher);
+    bench_alloc::report("unordered_set<url, std_string_hasher> insert & find", urls.size(), "URL", set_std_hasher);
+
+    const auto set_url_hasher = [&] {
+        std::unordered_set<upa::url, upa::url_hasher> set;
+        for (const auto& url : urls)
+            set.insert(url);
+        std::size_t count = 0;
+        for (const auto& url : urls)
+            count += set.count(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("unordered_set<url, url_hasher> insert & find", set_url_hasher);
+    bench_alloc::report("unordered_set<url, url_hasher> insert & find", urls.size(), "URL", set_url_hasher);
+
+    const auto set_url_hasher_cached = [&] {
+        std::unordered_set<upa::url, upa::url_hasher> set;
+        for (const auto& url : cached_urls)
+            set.insert(url);
+        std::size_t count = 0;
+        for (const auto& url : cached_urls)
+            count += set.count(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("unordered_set<url, url_hasher> insert & find (cached)", set_url_hasher_cached);
+    bench_alloc::report("unordered_set<url, url_hasher> insert & find (cached)", cached_urls.size(), "URL", set_url_hasher_cached);
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_hash <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line)))
+            urls.push_back(std::move(url));
+    }
+    if (urls.empty()) {
+        std::cout << "No valid URLs in " << file_name << '\n';
+        return 2;
+    }
+
+    // Compare each URL with the next one (and the last with the first)
+
+    const auto compare_origins = [&] {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < urls.size(); ++i) {
+            const auto& other = urls[(i + 1) % urls.size()];
+            const auto origin = urls[i].origin();
+            count += origin != "null" && origin == other.origin();
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("origin() == origin()", compare_origins);
+    bench_alloc::report("origin() == origin()", urls.size(), "URL", compare_origins);
+
+    const auto compare_same_origin = [&] {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < urls.size(); ++i) {
+            const auto& other = urls[(i + 1) % urls.size()];
+            count += urls[i].same_origin(other);
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::same_origin", compare_same_origin);
+    bench_alloc::report("url::same_origin", urls.size(), "URL", compare_same_origin);
+
+    // Self comparison: every tuple origin is the same
+
+    const auto compare_origins_self = [&] {
+        std::size_t count = 0;
+        for (const auto& url : urls) {
+            const auto origin = url.origin();
+            count += origin != "null" && origin == url.origin();
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("origin() == origin() (same URL)", compare_origins_self);
+    bench_alloc::report("origin() == origin() (same URL)", urls.size(), "URL", compare_origins_self);
+
+    const auto compare_same_origin_self = [&] {
+        std::size_t count = 0;
+        for (const auto& url : urls)
+            count += url.same_origin(url);
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::same_origin (same URL)", compare_same_origin_self);
+    bench_alloc::report("url::same_origin (same URL)", urls.size(), "URL", compare_same_origin_self);
+
+    // Serialization
+
+    const auto serialize_origins = [&] {
+        for (const auto& url : urls) {
+            const auto origin = url.origin();
+            ankerl::nanobench::doNotOptimizeAway(origin);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::origin", serialize_origins);
+    bench_alloc::report("url::origin", urls.size(), "URL", serialize_origins);
+
+    const auto serialize_origin_views = [&] {
+        char buffer[256];
+        for (const auto& url : urls) {
+            const auto len = url.get_origin_view().serialize(buffer, sizeof(buffer));
+            ankerl::nanobench::doNotOptimizeAway(len);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::origin_view::serialize", serialize_origin_views);
+    bench_alloc::report("upa::origin_view::serialize", urls.size(), "URL", serialize_origin_views);
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_origin <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<std::string> hrefs;
+    std::vector<std::string> records;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    std::size_t records_size = 0;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line))) {
+            hrefs.emplace_back(url.href());
+            records.emplace_back();
+            url.serialize_record(records.back());
+            records_size += records.back().size();
+        }
+    }
+    std::size_t hrefs_size = 0;
+    for (const auto& href : hrefs)
+        hrefs_size += href.size();
+    std::cout << "URLs: " << hrefs.size()
+        << "; href bytes: " << hrefs_size
+        << "; record bytes: " << records_size << '\n';
+
+    // Benchmark
+
+    const auto parse_all = [&] {
+        upa::url url;
+        for (const auto& href : hrefs) {
+            url.parse(href);
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::parse(href)", parse_all);
+    bench_alloc::report("url::parse(href)", hrefs.size(), "URL", parse_all);
+
+    const auto load_all = [&] {
+        upa::url url;
+        for (const auto& record : records) {
+            url.load_record(record);
+            ankerl::nanobench::doNotOptimizeAway(url);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::load_record", load_all);
+    bench_alloc::report("url::load_record", records.size(), "URL", load_all);
+
+    const auto serialize_all = [&] {
+        upa::url url;
+        std::string buffer;
+        for (const auto& record : records) {
+            url.load_record(record);
+            buffer.clear();
+            url.serialize_record(buffer);
+            ankerl::nanobench::doNotOptimizeAway(buffer);
+        }
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("url::serialize_record", serialize_all);
+    bench_alloc::report("url::serialize_record", records.size(), "URL", serialize_all);
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_record <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_table.h"
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<std::string> url_strings;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line))
+        url_strings.push_back(line);
+
+    std::vector<upa::url> urls;
+    for (const auto& str : url_strings) {
+        upa::url url;
+        if (upa::success(url.parse(str)))
+            urls.push_back(std::move(url));
+    }
+
+    upa::url_table table;
+    table.append_parse(url_strings.begin(), url_strings.end());
+
+    // Memory
+    std::size_t urls_memory = urls.capacity() * sizeof(upa::url);
+    for (const auto& url : urls)
+        urls_memory += url.href().length() + 1;
+    std::cout << "URLs: " << table.size()
+        << "; std::vector<upa::url> memory: ~" << urls_memory
+        << " bytes; upa::url_table memory: " << table.memory_size() << " bytes\n";
+
+    // Parse
+
+    const auto parse_vector = [&] {
+        std::vector<upa::url> vec;
+        for (const auto& str : url_strings) {
+            upa::url url;
+            if (upa::success(url.parse(str)))
+                vec.push_back(std::move(url));
+        }
+        ankerl::nanobench::doNotOptimizeAway(vec);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::vector<upa::url> parse", parse_vector);
+    bench_alloc::report("std::vector<upa::url> parse", url_strings.size(), "URL", parse_vector);
+
+    const auto parse_table = [&] {
+        upa::url_table tbl;
+        tbl.append_parse(url_strings.begin(), url_strings.end(), nullptr, 1);
+        ankerl::nanobench::doNotOptimizeAway(tbl);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_table::append_parse (1 thread)", parse_table);
+    bench_alloc::report("upa::url_table::append_parse (1 thread)", url_strings.size(), "URL", parse_table);
+
+    const auto parse_table_mt = [&] {
+        upa::url_table tbl;
+        tbl.append_parse(url_strings.begin(), url_strings.end());
+        ankerl::nanobench::doNotOptimizeAway(tbl);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_table::append_parse (all threads)", parse_table_mt);
+    // only the allocations of the calling thread are counted
+    bench_alloc::report("upa::url_table::append_parse (all threads)", url_strings.size(), "URL", parse_table_mt);
+
+    // Scan host column
+
+    const auto scan_vector = [&] {
+        std::size_t count = 0;
+        for (const auto& url : urls)
+            count += url.get_part_view(upa::url::HOST).length();
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("std::vector<upa::url> host scan", scan_vector);
+    bench_alloc::report("std::vector<upa::url> host scan", urls.size(), "URL", scan_vector);
+
+    const auto scan_table = [&] {
+        std::size_t count = 0;
+        for (const auto host : table.get_column(upa::url::HOST))
+            count += host.length();
+        ankerl::nanobench::doNotOptimizeAway(count);
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_table host column scan", scan_table);
+    bench_alloc::report("upa::url_table host column scan", table.size(), "URL", scan_table);
+
+    // Save and load
+
+    const auto table_path = std::filesystem::temp_directory_path() / "upa-bench-url_table.bin";
+    if (table.save(table_path)) {
+        const auto load_table = [&] {
+            upa::url_table tbl;
+            tbl.load(table_path);
+            ankerl::nanobench::doNotOptimizeAway(tbl);
+        };
+        ankerl::nanobench::Bench().minEpochIterations(min_iters).run("upa::url_table::load (mmap)", load_table);
+        bench_alloc::report("upa::url_table::load (mmap)", table.size(), "URL", load_table);
+        std::filesystem::remove(table_path);
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-url_table <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
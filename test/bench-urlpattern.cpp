@@ -0,0 +1,188 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "upa/urlpattern.h"
+#ifdef UPA_TEST_WITH_STD_REGEX
+# include "upa/regex_engine_std.h"
+#else
+# include "upa/regex_engine_srell.h"
+#endif
+#include "bench-alloc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "ankerl/nanobench.h"
+
+#ifdef UPA_TEST_WITH_STD_REGEX
+using urlpattern_regex_engine = upa::regex_engine_std;
+#else
+using urlpattern_regex_engine = upa::regex_engine_srell;
+#endif
+using urlpattern = upa::urlpattern<urlpattern_regex_engine>;
+
+// Patterns to match: from the wildcard to more specific ones; the search and
+// hash are wildcards (the `?` search prefix is escaped)
+const char* const kPatterns[] = {
+    "*://*/*\\?*#*",
+    "http{s}?://*/:section/*\\?*#*",
+    "https://*.example.com/*\\?*#*",
+    "*://*/*.:ext(html|php|js|css|txt)\\?*#*",
+    "*://*/*\\?*#:fragment",
+};
+
+// -----------------------------------------------------------------------------
+// Read samples from text file (URL in each line) and benchmark
+
+int benchmark_txt(const std::filesystem::path& file_name, std::uint64_t min_iters) {
+    std::vector<upa::url> urls;
+
+    // Load URL samples
+    std::cout << "Load URL samples from: " << file_name << '\n';
+    std::ifstream finp(file_name);
+    if (!finp.is_open()) {
+        std::cout << "Failed to open " << file_name << '\n';
+        return 2;
+    }
+
+    std::string line;
+    while (std::getline(finp, line)) {
+        upa::url url;
+        if (upa::success(url.parse(line)))
+            urls.push_back(std::move(url));
+    }
+
+    std::vector<urlpattern> patterns;
+    for (const char* pattern : kPatterns)
+        patterns.emplace_back(pattern);
+
+    // Execute each pattern against each URL
+
+    const auto exec_all = [&] {
+        std::size_t matches = 0;
+        for (const auto& urlp : patterns) {
+            for (const auto& url : urls) {
+                const auto res = urlp.exec(url);
+                matches += res.has_value();
+                ankerl::nanobench::doNotOptimizeAway(res);
+            }
+        }
+        return matches;
+    };
+    std::cout << "Matches: " << exec_all() << " of " << patterns.size() * urls.size() << '\n';
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern::exec", exec_all);
+    bench_alloc::report("urlpattern::exec", patterns.size() * urls.size(), "exec", exec_all);
+
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern::test", [&] {
+        for (const auto& urlp : patterns) {
+            for (const auto& url : urls) {
+                const bool res = urlp.test(url);
+                ankerl::nanobench::doNotOptimizeAway(res);
+            }
+        }
+    });
+
+    // Construction of the pattern set, and testing with the shared components
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern constructor", [&] {
+        for (const char* pattern : kPatterns)
+            ankerl::nanobench::doNotOptimizeAway(urlpattern(pattern));
+    });
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern constructor with pool", [&] {
+        upa::urlpattern_component_pool<urlpattern_regex_engine> pool;
+        for (const char* pattern : kPatterns)
+            ankerl::nanobench::doNotOptimizeAway(urlpattern(pattern, upa::urlpattern_options{}, pool));
+    });
+
+    upa::urlpattern_component_pool<urlpattern_regex_engine> pool;
+    std::vector<urlpattern> pooled_patterns;
+    for (const char* pattern : kPatterns)
+        pooled_patterns.emplace_back(pattern, upa::urlpattern_options{}, pool);
+    std::cout << "Components: " << pool.size() << " shared of " << pooled_patterns.size() * 8 << '\n';
+
+    upa::urlpattern_component_cache<urlpattern_regex_engine> cache(pool);
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern::test with cache", [&] {
+        for (const auto& url : urls) {
+            cache.reset();
+            for (const auto& urlp : pooled_patterns) {
+                const bool res = urlp.test(url, cache);
+                ankerl::nanobench::doNotOptimizeAway(res);
+            }
+        }
+    });
+
+    // The URLPatternInit input: each component is canonicalized
+    std::vector<upa::urlpattern_init> inits;
+    inits.reserve(urls.size());
+    for (const auto& url : urls) {
+        upa::urlpattern_init init;
+        init.protocol = url.get_protocol();
+        init.hostname = url.get_hostname();
+        init.port = url.get_port();
+        init.pathname = url.get_pathname();
+        init.search = url.get_search();
+        init.hash = url.get_hash();
+        inits.push_back(std::move(init));
+    }
+
+    const auto test_inits = [&] {
+        std::size_t matches = 0;
+        for (const auto& urlp : patterns) {
+            for (const auto& init : inits)
+                matches += urlp.test(init);
+        }
+        return matches;
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern::test(urlpattern_init)", test_inits);
+    bench_alloc::report("urlpattern::test(urlpattern_init)", patterns.size() * inits.size(), "test", test_inits);
+
+    upa::urlpattern_exec_context ctx;
+    const auto test_inits_ctx = [&] {
+        std::size_t matches = 0;
+        for (const auto& urlp : patterns) {
+            for (const auto& init : inits)
+                matches += urlp.test(init, ctx);
+        }
+        return matches;
+    };
+    ankerl::nanobench::Bench().minEpochIterations(min_iters).run("urlpattern::test(urlpattern_init, context)", test_inits_ctx);
+    bench_alloc::report("urlpattern::test(urlpattern_init, context)", patterns.size() * inits.size(), "test", test_inits_ctx);
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t get_positive_or_default(const char* str, std::uint64_t def)
+{
+    const std::uint64_t res = std::strtoull(str, nullptr, 10);
+    if (res > 0)
+        return res;
+    return def;
+}
+
+int main(int argc, const char* argv[])
+{
+    constexpr std::uint64_t min_iters_def = 3;
+
+    if (argc < 2) {
+        std::cerr << "Usage: bench-urlpattern <file containing URLs> [<min iterations>]\n";
+        return 1;
+    }
+
+    const std::filesystem::path file_name = argv[1];
+    const std::uint64_t min_iters = argc > 2
+        ? get_positive_or_default(argv[2], min_iters_def)
+        : min_iters_def;
+
+    return benchmark_txt(file_name, min_iters);
+}
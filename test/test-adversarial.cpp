@@ -0,0 +1,89 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Algorithmic complexity checks on adversarial inputs
+//
+// For every shape of adversarial-inputs.h, the operation on an input of
+// kScale * n bytes is compared with kScale runs of the operation on an input
+// of n bytes. If the growth is linear, both allocate about the same number
+// of bytes and take about the same time; a quadratic growth makes the large
+// input kScale times slower.
+//
+// The allocated bytes are always checked. The running time depends on the
+// machine load and sanitizers, so it is checked only if the test is built
+// with UPA_TEST_ADVERSARIAL_TIME defined (see the CMake option of the same
+// name); otherwise it is only reported. bench-adversarial fits the time
+// complexity of the shapes.
+
+// count allocations (see bench-alloc.h)
+#define UPA_BENCH_ALLOC
+#include "bench-alloc.h"
+
+#include "adversarial-inputs.h"
+#include "doctest-main.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+constexpr std::size_t kSmall = 4096;
+constexpr std::size_t kScale = 8;
+// allowed growth of the large input costs over the scaled small input costs
+[[maybe_unused]] constexpr double kMaxTimeRatio = 3.0;
+constexpr double kMaxBytesRatio = 3.0;
+
+// sink to prevent optimizing away the results
+volatile std::size_t sink;
+
+struct cost {
+    double seconds = 0;
+    std::uint64_t bytes = 0;
+};
+
+// Runs the operation `repeat` times; returns the best time of several tries
+// and the allocated bytes of one try
+cost measure(const adversarial::shape& shp, const std::string& input, std::size_t repeat) {
+    cost res;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        const auto bytes_before = bench_alloc::thread_counters.bytes;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t ind = 0; ind < repeat; ++ind)
+            sink = sink + shp.run(input);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        res.bytes = bench_alloc::thread_counters.bytes - bytes_before;
+        res.seconds = attempt ? std::min(res.seconds, elapsed.count()) : elapsed.count();
+    }
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("Adversarial inputs have linear costs") {
+    for (const auto& shp : adversarial::kShapes) {
+        INFO("shape: " << shp.name);
+
+        const std::string small_input = shp.make_input(kSmall);
+        const std::string large_input = shp.make_input(kSmall * kScale);
+
+        // warm up: static data, caches
+        sink = sink + shp.run(small_input);
+
+        const cost small_cost = measure(shp, small_input, kScale);
+        const cost large_cost = measure(shp, large_input, 1);
+
+        const double time_ratio = large_cost.seconds / std::max(small_cost.seconds, 1e-9);
+        const double bytes_ratio = static_cast<double>(large_cost.bytes) /
+            static_cast<double>(std::max<std::uint64_t>(small_cost.bytes, 1));
+        INFO("time ratio: " << time_ratio << "; allocated bytes ratio: " << bytes_ratio);
+#ifdef UPA_TEST_ADVERSARIAL_TIME
+        CHECK(time_ratio < kMaxTimeRatio);
+#endif
+        CHECK(bytes_ratio < kMaxBytesRatio);
+    }
+}
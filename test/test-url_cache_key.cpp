@@ -0,0 +1,116 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_cache_key.h"
+#include "doctest-main.h"
+#include <string>
+
+
+TEST_CASE("cache_key_builder with default options") {
+    const upa::cache_key_builder builder;
+
+    CHECK(builder.key(upa::url{ "https://example.org/p?b=2&a=1&b=1#frag" }) == "https://example.org/p?a=1&b=2&b=1");
+    CHECK(builder.key(upa::url{ "https://example.org/p?" }) == "https://example.org/p");
+    CHECK(builder.key(upa::url{ "https://example.org/p?&&" }) == "https://example.org/p");
+    CHECK(builder.key(upa::url{ "https://example.org/p?x&&a=" }) == "https://example.org/p?a=&x");
+    CHECK(builder.key(upa::url{ "https://example.org/p#?x" }) == "https://example.org/p");
+    CHECK(builder.key(upa::url{ "HTTP://u:p@EXAMPLE.org:80/p" }) == "http://u:p@example.org/p");
+    CHECK(builder.key(upa::url{ "non-spec://EXAMPLE.org/P?Q" }) == "non-spec://example.org/P?Q");
+    CHECK(builder.key(upa::url{ "non-spec://h?b&a" }) == "non-spec://h?a&b");
+    CHECK(builder.key(upa::url{ "mailto:User@EXAMPLE.org?b&a#f" }) == "mailto:User@EXAMPLE.org?a&b");
+
+    // invalid URL
+    std::string key{ "prefix" };
+    CHECK_FALSE(builder.append_key(upa::url{}, key));
+    CHECK(key == "prefix");
+
+    // appends to the buffer
+    CHECK(builder.append_key(upa::url{ "https://example.org/?a" }, key));
+    CHECK(key == "prefixhttps://example.org/?a");
+}
+
+TEST_CASE("cache_key_builder with options") {
+    SUBCASE("keep_fragment") {
+        upa::cache_key_options options;
+        options.keep_fragment = true;
+        const upa::cache_key_builder builder{ options };
+        CHECK(builder.key(upa::url{ "https://example.org/?b&a#f" }) == "https://example.org/?a&b#f");
+        CHECK(builder.key(upa::url{ "https://example.org/#" }) == "https://example.org/");
+    }
+    SUBCASE("sort_query") {
+        upa::cache_key_options options;
+        options.sort_query = false;
+        const upa::cache_key_builder builder{ options };
+        CHECK(builder.key(upa::url{ "https://example.org/?b&&a" }) == "https://example.org/?b&a");
+    }
+    SUBCASE("lowercase_host") {
+        upa::cache_key_options options;
+        options.lowercase_host = false;
+        const upa::cache_key_builder builder{ options };
+        CHECK(builder.key(upa::url{ "non-spec://EXAMPLE.org/P" }) == "non-spec://EXAMPLE.org/P");
+    }
+    SUBCASE("ignored_params") {
+        upa::cache_key_options options;
+        options.ignored_params = { "utm_*", "fbclid", "*x" };
+        const upa::cache_key_builder builder{ options };
+        CHECK(builder.key(upa::url{ "https://example.org/?b=2&utm_source=x&fbclid=1&a=1&utm=3" }) ==
+            "https://example.org/?a=1&b=2&utm=3");
+        // the name not ending with '*' matches exactly
+        CHECK(builder.key(upa::url{ "https://example.org/?*x&*xy&x" }) == "https://example.org/?*xy&x");
+        CHECK(builder.key(upa::url{ "https://example.org/?utm_a&fbclid" }) == "https://example.org/");
+    }
+    SUBCASE("kept_params") {
+        upa::cache_key_options options;
+        options.kept_params = { "id", "page*" };
+        options.ignored_params = { "page_token" };
+        const upa::cache_key_builder builder{ options };
+        CHECK(builder.key(upa::url{ "https://example.org/?page_size=10&x=1&id=7&page_token=t&page=2" }) ==
+            "https://example.org/?id=7&page=2&page_size=10");
+    }
+}
+
+TEST_CASE("cache_key_builder sorts many parameters") {
+    const upa::cache_key_builder builder;
+
+    // more parameters than sorted without allocation; the parameters with
+    // the same name must keep their order
+    std::string input{ "https://example.org/?" };
+    for (int ind = 99; ind >= 0; --ind) {
+        input += "p" + std::to_string(ind) + "=" + std::to_string(ind % 3) + "&";
+        input += "p" + std::to_string(ind) + "=x&";
+    }
+    upa::url sorted{ input };
+    sorted.search_params().sort();
+    CHECK(builder.key(upa::url{ input }) == sorted.href());
+}
+
+TEST_CASE("cache_key_builder fingerprints") {
+    upa::cache_key_options options;
+    options.ignored_params = { "utm_*" };
+    const upa::cache_key_builder builder{ options };
+
+    const upa::url url1{ "https://example.org/p?b=2&a=1&utm_source=x#f" };
+    const upa::url url2{ "https://example.org/p?a=1&b=2" };
+    const upa::url url3{ "https://example.org/p?a=1&b=3" };
+    CHECK(builder.fingerprint(url1) == builder.fingerprint(url2));
+    CHECK(builder.fingerprint(url1) != builder.fingerprint(url3));
+    CHECK(builder.fingerprint128(url1) == builder.fingerprint128(url2));
+    CHECK(builder.fingerprint128(url1) != builder.fingerprint128(url3));
+    CHECK(builder.fingerprint128(url1).low == builder.fingerprint(url1));
+
+    // the fingerprint depends only on the key, and not on how it is made
+    const upa::url url4{ "non-spec://EXAMPLE.org/p" };
+    const upa::url url5{ "non-spec://example.org/p" };
+    CHECK(builder.fingerprint(url4) == builder.fingerprint(url5));
+
+    // long keys
+    const std::string path(1000, 'a');
+    const upa::url url6{ "https://example.org/" + path + "?b&a" };
+    const upa::url url7{ "https://example.org/" + path + "?a&b" };
+    const upa::url url8{ "https://example.org/" + path + "a?a&b" };
+    CHECK(builder.fingerprint(url6) == builder.fingerprint(url7));
+    CHECK(builder.fingerprint(url6) != builder.fingerprint(url8));
+    CHECK(builder.fingerprint128(url6) == builder.fingerprint128(url7));
+}
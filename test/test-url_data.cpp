@@ -0,0 +1,255 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_data.h"
+#include "doctest-main.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Returns "<MIME type> <body>", or "failure"
+std::string process_data_url(std::string_view str_url) {
+    upa::url u;
+    upa::data_url du;
+    if (u.parse(str_url) != upa::validation_errc::ok || !du.parse(u))
+        return "failure";
+    std::string body;
+    if (!du.append_body(body))
+        return "failure";
+    return du.mime().serialize() + " " + body;
+}
+
+std::string serialize_mime_type(std::string_view input) {
+    const auto res = upa::parse_mime_type(input);
+    return res ? res->serialize() : "failure";
+}
+
+std::string base64_encode(std::string_view input) {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string res;
+    std::size_t ind = 0;
+    for (; ind + 3 <= input.length(); ind += 3) {
+        const auto v = (static_cast<unsigned char>(input[ind]) << 16) |
+            (static_cast<unsigned char>(input[ind + 1]) << 8) |
+            static_cast<unsigned char>(input[ind + 2]);
+        res += kAlphabet[(v >> 18) & 0x3F];
+        res += kAlphabet[(v >> 12) & 0x3F];
+        res += kAlphabet[(v >> 6) & 0x3F];
+        res += kAlphabet[v & 0x3F];
+    }
+    if (ind + 1 == input.length()) {
+        const auto v = static_cast<unsigned char>(input[ind]) << 16;
+        res += kAlphabet[(v >> 18) & 0x3F];
+        res += kAlphabet[(v >> 12) & 0x3F];
+        res += "==";
+    } else if (ind + 2 == input.length()) {
+        const auto v = (static_cast<unsigned char>(input[ind]) << 16) |
+            (static_cast<unsigned char>(input[ind + 1]) << 8);
+        res += kAlphabet[(v >> 18) & 0x3F];
+        res += kAlphabet[(v >> 12) & 0x3F];
+        res += kAlphabet[(v >> 6) & 0x3F];
+        res += '=';
+    }
+    return res;
+}
+
+} // namespace
+
+
+TEST_CASE("parse_mime_type") {
+    CHECK(serialize_mime_type("text/html") == "text/html");
+    CHECK(serialize_mime_type(" TEXT/Html ; Charset=UTF-8 ") == "text/html;charset=UTF-8");
+    CHECK(serialize_mime_type("text/html;charset=\"shift_jis\"iso-2022-jp") == "text/html;charset=shift_jis");
+    CHECK(serialize_mime_type("text/html;charset=\"\"") == "text/html;charset=\"\"");
+    CHECK(serialize_mime_type("text/html;charset=\"a\\\"b\\\\c\"") == "text/html;charset=\"a\\\"b\\\\c\"");
+    CHECK(serialize_mime_type("text/html;charset=\"x;y\"") == "text/html;charset=\"x;y\"");
+    CHECK(serialize_mime_type("text/html;charset=\"\\") == "text/html;charset=\"\\\\\"");
+    CHECK(serialize_mime_type("text/html;charset=a;charset=b") == "text/html;charset=a");
+    CHECK(serialize_mime_type("text/html;;;a=1;b;c=;=d;e=2") == "text/html;a=1;e=2");
+    CHECK(serialize_mime_type("text/html;a b=1;c=\xC4") == "text/html;c=\"\xC4\"");
+
+    CHECK(serialize_mime_type("") == "failure");
+    CHECK(serialize_mime_type("text") == "failure");
+    CHECK(serialize_mime_type("text/") == "failure");
+    CHECK(serialize_mime_type("/html") == "failure");
+    CHECK(serialize_mime_type("te xt/html") == "failure");
+    CHECK(serialize_mime_type("text/ht ml") == "failure");
+
+    const auto mt = upa::parse_mime_type("Image/SVG+xml;Charset=utf-8");
+    REQUIRE(mt);
+    CHECK(mt->essence() == "image/svg+xml");
+    REQUIRE(mt->parameter("charset") != nullptr);
+    CHECK(*mt->parameter("charset") == "utf-8");
+    CHECK(mt->parameter("Charset") == nullptr);
+}
+
+TEST_CASE("data_url processor") {
+    CHECK(process_data_url("data://test/,X") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data://test:test/,X") == "failure");
+    CHECK(process_data_url("data:,X") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:") == "failure");
+    CHECK(process_data_url("data:text/html") == "failure");
+    CHECK(process_data_url("data:text/html    ;charset=x   ") == "failure");
+    CHECK(process_data_url("data:,") == "text/plain;charset=US-ASCII ");
+    CHECK(process_data_url("data:,X#X") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:,X?X") == "text/plain;charset=US-ASCII X?X");
+    CHECK(process_data_url("data:,%FF") == "text/plain;charset=US-ASCII \xFF");
+    CHECK(process_data_url("data:,%X%4") == "text/plain;charset=US-ASCII %X%4");
+    CHECK(process_data_url("data:text/plain,X") == "text/plain X");
+    CHECK(process_data_url("data:text/plain ,X") == "text/plain X");
+    CHECK(process_data_url("data:text/plain%20,X") == "text/plain%20 X");
+    CHECK(process_data_url("data:text/plain\f,X") == "text/plain%0c X");
+    CHECK(process_data_url("data:text/plain;,X") == "text/plain X");
+    CHECK(process_data_url("data:;x=x;charset=x,X") == "text/plain;x=x;charset=x X");
+    CHECK(process_data_url("data:;x=x,X") == "text/plain;x=x X");
+    CHECK(process_data_url("data:text/html;charset=gbk,%C2%B1") == "text/html;charset=gbk \xC2\xB1");
+    CHECK(process_data_url("data:x,X") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("DATA:,X") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("http://x/,X") == "failure");
+    CHECK_FALSE(upa::data_url{}.parse(upa::url{}));
+
+    // the failed parse resets the previous result
+    {
+        upa::data_url du;
+        CHECK(du.parse(upa::url{ "data:text/html;base64,WA" }));
+        CHECK_FALSE(du.parse(upa::url{ "data:no-comma" }));
+        CHECK(du.mime().type.empty());
+        CHECK_FALSE(du.is_base64());
+        CHECK(du.encoded_body().empty());
+        CHECK(du.max_body_size() == 0);
+        std::string body;
+        CHECK(du.append_body(body));
+        CHECK(body.empty());
+    }
+
+    // the opaque path of UTF-16 input
+    const upa::url u{ u"data:,a\u0105b\x01 c\x7F ?q" };
+    CHECK(u.href() == "data:,a%C4%85b%01 c%7F%20?q");
+
+    // base64
+    CHECK(process_data_url("data:;base64,WA") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64,W%20A") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64,W%0CA") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64,W%41") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64,WA%3D%3D") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64,W%") == "failure");
+    CHECK(process_data_url("data:;base64,W%25") == "failure");
+    CHECK(process_data_url("data:;base64;base64,WA") == "text/plain X");
+    CHECK(process_data_url("data:x/x;base64;base64,WA") == "x/x X");
+    CHECK(process_data_url("data:x/x;base64;charset=x,WA") == "x/x;charset=x WA");
+    CHECK(process_data_url("data:x/x;base64;charset=x;base64,WA") == "x/x;charset=x X");
+    CHECK(process_data_url("data:;basE64,WA") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base 64,WA") == "text/plain WA");
+    CHECK(process_data_url("data:;base64 ,WA") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:;base64;,WA") == "text/plain WA");
+    CHECK(process_data_url("data:;  base64,WA") == "text/plain;charset=US-ASCII X");
+    CHECK(process_data_url("data:base64,WA") == "text/plain;charset=US-ASCII WA");
+    CHECK(process_data_url("data: ;charset=x   ;base64,WA") == "text/plain;charset=x X");
+    CHECK(process_data_url("data:;charset=,X") == "text/plain X");
+    CHECK(process_data_url("data:;charset=\"x\",X") == "text/plain;charset=x X");
+    CHECK(process_data_url("data:;CHARSET=\"X\",X") == "text/plain;charset=X X");
+}
+
+TEST_CASE("data_url forgiving-base64 decode") {
+    const auto decode = [](std::string_view body) -> std::optional<std::string> {
+        std::string str_url{ "data:;base64," };
+        str_url += body;
+        const upa::url u{ str_url };
+        upa::data_url du;
+        REQUIRE(du.parse(u));
+        std::vector<char> buff(du.max_body_size());
+        const auto size = du.decode_body(buff.data());
+        if (!size)
+            return std::nullopt;
+        return std::string(buff.data(), *size);
+    };
+
+    CHECK(decode("") == "");
+    CHECK(decode("abcd") == "i\xB7\x1D");
+    CHECK(decode(" abcd") == "i\xB7\x1D");
+    CHECK(decode("abcd ") == "i\xB7\x1D");
+    CHECK(decode("ab cd") == "i\xB7\x1D");
+    CHECK(decode("ab\tcd") == "i\xB7\x1D");
+    CHECK(decode("ab") == "i");
+    CHECK(decode("ab=") == std::nullopt);
+    CHECK(decode("ab==") == "i");
+    CHECK(decode("ab===") == std::nullopt);
+    CHECK(decode("ab= =") == "i");
+    CHECK(decode("abc") == "i\xB7");
+    CHECK(decode("abc=") == "i\xB7");
+    CHECK(decode("abc==") == std::nullopt);
+    CHECK(decode("abcde") == std::nullopt);
+    CHECK(decode("abcd=") == std::nullopt);
+    CHECK(decode("abcd==") == std::nullopt);
+    CHECK(decode("a") == std::nullopt);
+    CHECK(decode("=") == std::nullopt);
+    CHECK(decode("==") == std::nullopt);
+    CHECK(decode("ab=c") == std::nullopt);
+    CHECK(decode("ab==c=") == std::nullopt);
+    CHECK(decode("ab-d") == std::nullopt);
+    CHECK(decode("ab_d") == std::nullopt);
+    CHECK(decode("/+/+") == "\xFF\xEF\xFE");
+    CHECK(decode("YWJjZGVmZ2hpamts") == "abcdefghijkl");
+    CHECK(decode("YWJjZGVmZ2hpamtsbQ") == "abcdefghijklm");
+    CHECK(decode("YWJjZGVm Z2hpamtsbQ==") == "abcdefghijklm");
+    CHECK(decode("YWJjZGVm\xC4\x85Z2hp") == std::nullopt);
+}
+
+TEST_CASE("data_url large body") {
+    std::string data;
+    for (int ind = 0; ind < 100000; ++ind)
+        data += static_cast<char>((ind * 7919) >> 3);
+
+    const auto encoded = base64_encode(data);
+    // line breaks are percent encoded in the URL
+    std::string body;
+    for (std::size_t pos = 0; pos < encoded.length(); pos += 76) {
+        body += encoded.substr(pos, 76);
+        body += "%0D%0A";
+    }
+
+    SUBCASE("base64") {
+        const upa::url u{ "data:application/octet-stream;base64," + body + "#frag" };
+        upa::data_url du;
+        REQUIRE(du.parse(u));
+        CHECK(du.is_base64());
+        CHECK(du.mime().essence() == "application/octet-stream");
+        std::string output{ "prefix" };
+        REQUIRE(du.append_body(output));
+        CHECK(output == "prefix" + data);
+    }
+    SUBCASE("percent encoded") {
+        // percent encode the bytes which are not ASCII alphanumeric
+        std::string str_url{ "data:application/octet-stream," };
+        for (const char c : data) {
+            const auto uc = static_cast<unsigned char>(c);
+            if ((uc >= '0' && uc <= '9') || (uc >= 'A' && uc <= 'Z') || (uc >= 'a' && uc <= 'z')) {
+                str_url += c;
+            } else {
+                str_url += '%';
+                str_url += "0123456789ABCDEF"[uc >> 4];
+                str_url += "0123456789ABCDEF"[uc & 0xF];
+            }
+        }
+        const upa::url u{ str_url };
+        upa::data_url du;
+        REQUIRE(du.parse(u));
+        CHECK_FALSE(du.is_base64());
+        std::string output;
+        REQUIRE(du.append_body(output));
+        CHECK(output == data);
+    }
+    SUBCASE("invalid base64") {
+        const upa::url u{ "data:;base64," + body + "%" };
+        upa::data_url du;
+        REQUIRE(du.parse(u));
+        std::string output{ "prefix" };
+        CHECK_FALSE(du.append_body(output));
+        CHECK(output == "prefix");
+    }
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_dictionary.h"
+#include "doctest-main.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<upa::url> make_urls() {
+    std::vector<upa::url> urls;
+    for (int host = 0; host < 7; ++host) {
+        for (int path = 0; path < 13; ++path) {
+            urls.emplace_back("https://host" + std::to_string(host) + ".example/dir/" +
+                std::to_string(path * 7));
+        }
+    }
+    // prefixes of other URLs
+    urls.emplace_back("https://host1.example/dir/1");
+    urls.emplace_back("https://host1.example/dir/");
+    urls.emplace_back("https://host1.example/");
+    urls.emplace_back("http://example.org/");
+    urls.emplace_back("wss://example.org/chat");
+    // duplicates
+    urls.emplace_back("https://host0.example/dir/0");
+    urls.emplace_back("http://example.org/");
+    return urls;
+}
+
+std::vector<std::string> sorted_hrefs(const std::vector<upa::url>& urls) {
+    std::vector<std::string> hrefs;
+    for (const auto& url : urls)
+        hrefs.emplace_back(url.href());
+    std::sort(hrefs.begin(), hrefs.end());
+    hrefs.erase(std::unique(hrefs.begin(), hrefs.end()), hrefs.end());
+    return hrefs;
+}
+
+void check_dictionary(const upa::url_dictionary& dict, const std::vector<std::string>& hrefs) {
+    REQUIRE(dict.size() == hrefs.size());
+
+    for (std::size_t ind = 0; ind < hrefs.size(); ++ind) {
+        CHECK(dict.at(ind) == hrefs[ind]);
+        CHECK(dict.find(hrefs[ind]) == ind);
+        CHECK(dict.lower_bound(hrefs[ind]) == ind);
+        CHECK(dict.contains(hrefs[ind]));
+    }
+    CHECK_THROWS_AS(static_cast<void>(dict.at(hrefs.size())), std::out_of_range);
+
+    // not contained strings
+    for (const auto& href : hrefs) {
+        for (const auto& str : { href + "x", href + "/", href.substr(0, href.length() - 1),
+            href.substr(0, 10), href + '\x7F', href + '\xFF' }) {
+            const auto expected = static_cast<std::size_t>(
+                std::lower_bound(hrefs.begin(), hrefs.end(), str) - hrefs.begin());
+            CHECK(dict.lower_bound(str) == expected);
+            CHECK(dict.contains(str) == std::binary_search(hrefs.begin(), hrefs.end(), str));
+        }
+    }
+    CHECK(dict.lower_bound("") == 0);
+    CHECK(dict.lower_bound("\xFF") == hrefs.size());
+    CHECK(dict.find("\xFF") == upa::url_dictionary::npos);
+}
+
+} // namespace
+
+
+TEST_CASE("url_dictionary") {
+    const auto urls = make_urls();
+    const auto hrefs = sorted_hrefs(urls);
+
+    for (const std::size_t block_size : { 1, 2, 5, 16, 1000 }) {
+        const upa::url_dictionary dict(urls.begin(), urls.end(), block_size);
+        CHECK(dict.block_size() == block_size);
+        check_dictionary(dict, hrefs);
+    }
+
+    SUBCASE("url lookup") {
+        const upa::url_dictionary dict(urls.begin(), urls.end());
+        CHECK(dict.contains(upa::url{ "HTTPS://HOST1.EXAMPLE/dir/14" }));
+        CHECK(dict.find(upa::url{ "http://example.org" }) == 0);
+        CHECK_FALSE(dict.contains(upa::url{ "https://host1.example/dir/15" }));
+    }
+    SUBCASE("empty dictionary") {
+        const upa::url_dictionary dict;
+        CHECK(dict.empty());
+        CHECK(dict.lower_bound("https://example.org/") == 0);
+        CHECK_FALSE(dict.contains("https://example.org/"));
+
+        const std::vector<upa::url> no_urls;
+        const upa::url_dictionary dict2(no_urls.begin(), no_urls.end());
+        CHECK(dict2.empty());
+    }
+    SUBCASE("memory size") {
+        const upa::url_dictionary dict(urls.begin(), urls.end());
+        std::size_t total = 0;
+        for (const auto& href : hrefs)
+            total += href.length();
+        CHECK(dict.memory_size() < total);
+    }
+}
+
+TEST_CASE("url_dictionary save and load") {
+    const auto path = std::filesystem::temp_directory_path() / "upa-test-url_dictionary.bin";
+    const auto urls = make_urls();
+    const auto hrefs = sorted_hrefs(urls);
+
+    const upa::url_dictionary dict(urls.begin(), urls.end(), 4);
+    REQUIRE(dict.save(path));
+
+    upa::url_dictionary loaded;
+    REQUIRE(loaded.load(path));
+    CHECK(loaded.is_mapped());
+    CHECK(loaded.block_size() == 4);
+    check_dictionary(loaded, hrefs);
+
+    // corrupted file
+    std::string content;
+    {
+        std::ifstream file(path, std::ios_base::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    loaded = upa::url_dictionary{}; // unmap file before overwriting
+    const auto write_file = [&](const std::string& str) {
+        std::ofstream file(path, std::ios_base::binary | std::ios_base::trunc);
+        file << str;
+    };
+    write_file(content.substr(0, content.length() - 1));
+    CHECK_FALSE(loaded.load(path));
+    CHECK(loaded.empty());
+    write_file("not a dictionary");
+    CHECK_FALSE(loaded.load(path));
+
+    // swap two URLs in the first block; it breaks the order
+    auto swapped = content;
+    const auto pos = swapped.find("http://example.org/");
+    REQUIRE(pos != std::string::npos);
+    swapped[pos + 4] = 'z'; // "httpz://..." > next URLs
+    write_file(swapped);
+    CHECK_FALSE(loaded.load(path));
+
+    std::filesystem::remove(path);
+}
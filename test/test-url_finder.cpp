@@ -0,0 +1,161 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_finder.h"
+#include "upa/public_suffix_list.h"
+#include "doctest-main.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+static std::vector<std::string_view> found_strings(const upa::url_finder& finder,
+    std::string_view text)
+{
+    std::vector<std::string_view> res;
+    for (const auto& m : finder.find_all(text))
+        res.push_back(text.substr(m.offset, m.length));
+    return res;
+}
+
+using strings = std::vector<std::string_view>;
+
+TEST_CASE("url_finder finds URLs with scheme") {
+    const upa::url_finder finder;
+
+    const std::string_view text = "See https://example.org/docs and ftp://ftp.example.net/file.txt now";
+    const auto matches = finder.find_all(text);
+    REQUIRE(matches.size() == 2);
+    CHECK(matches[0].offset == 4);
+    CHECK(matches[0].length == 24);
+    CHECK(matches[0].value.href() == "https://example.org/docs");
+    CHECK(matches[1].value.href() == "ftp://ftp.example.net/file.txt");
+
+    CHECK(found_strings(finder, "https://a.example/") == strings{ "https://a.example/" });
+    CHECK(found_strings(finder, "<a href=\"http://a.example/x\">") == strings{ "http://a.example/x" });
+    CHECK(found_strings(finder, "scheme:https://a.example") == strings{ "https://a.example" });
+    CHECK(found_strings(finder, "custom+scheme://host/path") == strings{ "custom+scheme://host/path" });
+    CHECK(found_strings(finder, "http://a.example\nhttp://b.example") ==
+        strings{ "http://a.example", "http://b.example" });
+
+    // not URLs
+    CHECK(found_strings(finder, "").empty());
+    CHECK(found_strings(finder, "ratio 1:2, time 12:30, ://").empty());
+    CHECK(found_strings(finder, "123://host").empty());
+    CHECK(found_strings(finder, "http://").empty());
+    CHECK(found_strings(finder, "http://[::1 is invalid").empty());
+}
+
+TEST_CASE("url_finder trims trailing punctuation") {
+    const upa::url_finder finder;
+
+    CHECK(found_strings(finder, "Visit https://example.org.") == strings{ "https://example.org" });
+    CHECK(found_strings(finder, "https://example.org/a, https://example.org/b;") ==
+        strings{ "https://example.org/a", "https://example.org/b" });
+    CHECK(found_strings(finder, "Really? https://example.org/?!") == strings{ "https://example.org/" });
+    CHECK(found_strings(finder, "'https://example.org/'") == strings{ "https://example.org/" });
+
+    // brackets
+    CHECK(found_strings(finder, "(see https://example.org/docs)") ==
+        strings{ "https://example.org/docs" });
+    CHECK(found_strings(finder, "(https://en.wikipedia.org/wiki/URL_(disambiguation))") ==
+        strings{ "https://en.wikipedia.org/wiki/URL_(disambiguation)" });
+    CHECK(found_strings(finder, "[https://example.org/a[1]]") == strings{ "https://example.org/a[1]" });
+    CHECK(found_strings(finder, "{https://example.org/}.") == strings{ "https://example.org/" });
+    CHECK(found_strings(finder, "([https://example.org/a(b)]);") == strings{ "https://example.org/a(b)" });
+    CHECK(found_strings(finder, "https://example.org/a)b)") == strings{ "https://example.org/a)b" });
+}
+
+TEST_CASE("url_finder candidates in the same span") {
+    const upa::url_finder finder;
+
+    // the failed candidates are followed by the valid one
+    CHECK(found_strings(finder, "a://[a://[http://example.org/x))") ==
+        strings{ "http://example.org/x" });
+    CHECK(found_strings(finder, "http://[x(http://example.org/(a)))") ==
+        strings{ "http://example.org/(a)" });
+    CHECK(found_strings(finder, "www.a[www.example.org/a]") == strings{ "www.example.org/a" });
+    // special URLs ignore the slashes before the authority
+    CHECK(found_strings(finder, "http:///example.org/x") == strings{ "http:///example.org/x" });
+
+    // too long authority of the www. candidate
+    const std::string long_host = "www." + std::string(1100, 'a') + ".example";
+    CHECK(found_strings(finder, long_host).empty());
+    CHECK(found_strings(finder, "http://" + long_host) == strings{ "http://" + long_host });
+}
+
+TEST_CASE("url_finder finds www. URLs") {
+    const upa::url_finder finder;
+
+    const std::string_view text = "Go to www.example.com/path?q=1.";
+    const auto matches = finder.find_all(text);
+    REQUIRE(matches.size() == 1);
+    CHECK(matches[0].offset == 6);
+    CHECK(matches[0].length == 24);
+    CHECK(matches[0].value.href() == "http://www.example.com/path?q=1");
+
+    CHECK(found_strings(finder, "WWW.Example.COM") == strings{ "WWW.Example.COM" });
+    CHECK(found_strings(finder, "(www.example.com)") == strings{ "www.example.com" });
+
+    // not URLs
+    CHECK(found_strings(finder, "www.").empty());
+    CHECK(found_strings(finder, "awww.example.com").empty());
+    CHECK(found_strings(finder, "user@www.example.com").empty());
+    // bare domains are not searched without the Public Suffix List
+    CHECK(found_strings(finder, "example.com").empty());
+}
+
+TEST_CASE("url_finder finds bare domains") {
+    upa::public_suffix_list psl;
+    upa::public_suffix_list::push_context ctx;
+    psl.push_line(ctx, "com");
+    psl.push_line(ctx, "org");
+    psl.push_line(ctx, "co.uk");
+    REQUIRE(psl.finalize(ctx));
+
+    const upa::url_finder finder{ &psl };
+
+    const std::string_view text = "Mirrors: example.com/dist, sub.example.co.uk and www.example.org.";
+    const auto matches = finder.find_all(text);
+    REQUIRE(matches.size() == 3);
+    CHECK(matches[0].offset == 9);
+    CHECK(matches[0].value.href() == "http://example.com/dist");
+    CHECK(matches[1].value.href() == "http://sub.example.co.uk/");
+    CHECK(matches[2].value.href() == "http://www.example.org/");
+
+    CHECK(found_strings(finder, "https://example.com and example.org") ==
+        strings{ "https://example.com", "example.org" });
+
+    // not URLs
+    CHECK(found_strings(finder, "file.txt version 1.2.3 pi=3.14").empty());
+    CHECK(found_strings(finder, "e-mail: user@example.com").empty());
+    CHECK(found_strings(finder, "path /usr/example.com or C:\\example.com").empty());
+    CHECK(found_strings(finder, "com.").empty());
+    CHECK(found_strings(finder, "co.uk").empty());
+}
+
+TEST_CASE("url_finder::find_next") {
+    const upa::url_finder finder;
+
+    const std::string_view text = "http://a.example http://b.example";
+    std::size_t pos = 0;
+    upa::url_match match;
+
+    REQUIRE(finder.find_next(text, pos, match));
+    CHECK(match.value.href() == "http://a.example/");
+    CHECK(pos == 16);
+    REQUIRE(finder.find_next(text, pos, match));
+    CHECK(match.offset == 17);
+    CHECK(match.value.href() == "http://b.example/");
+    CHECK(pos == text.size());
+    CHECK_FALSE(finder.find_next(text, pos, match));
+    CHECK(pos == text.size());
+
+    // start in the middle of URL
+    pos = 18;
+    REQUIRE(finder.find_next(text, pos, match));
+    CHECK(match.offset == 18);
+    CHECK(match.value.href() == "ttp://b.example");
+}
@@ -0,0 +1,125 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_parse_cache.h"
+#include "doctest-main.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("url_parse_cache") {
+    upa::url_parse_cache cache;
+
+    const auto u1 = cache.get("https://example.org/path");
+    REQUIRE(u1);
+    CHECK(u1->href() == "https://example.org/path");
+    auto st = cache.stats();
+    CHECK(st.hits == 0);
+    CHECK(st.misses == 1);
+    CHECK(st.size == 1);
+
+    // the same object is returned
+    const auto u2 = cache.get("https://example.org/path");
+    CHECK(u2 == u1);
+    st = cache.stats();
+    CHECK(st.hits == 1);
+    CHECK(st.misses == 1);
+
+    // copy
+    upa::url u;
+    CHECK(cache.parse("https://example.org/path", nullptr, u) == upa::validation_errc::ok);
+    CHECK(u.href() == "https://example.org/path");
+    CHECK(cache.stats().hits == 2);
+
+    SUBCASE("base URL") {
+        const upa::url base1{ "https://example.org/dir/" };
+        const upa::url base2{ "https://example.net/" };
+        const auto r1 = cache.get("file", &base1);
+        const auto r2 = cache.get("file", &base2);
+        REQUIRE(r1);
+        REQUIRE(r2);
+        CHECK(r1->href() == "https://example.org/dir/file");
+        CHECK(r2->href() == "https://example.net/file");
+        CHECK(cache.get("file", &base1) == r1);
+        CHECK(cache.get("file") == nullptr);
+        CHECK(cache.stats().size == 4);
+    }
+    SUBCASE("failures are cached") {
+        upa::url v{ "https://example.org/" };
+        CHECK(cache.parse("http://[::1", nullptr, v) == upa::validation_errc::ipv6_unclosed);
+        CHECK(v.href() == "https://example.org/"); // unchanged
+        CHECK(cache.get("http://[::1") == nullptr);
+        st = cache.stats();
+        CHECK(st.hits == 3);
+        CHECK(st.misses == 2);
+
+        const upa::url invalid_base;
+        CHECK(cache.parse("file", &invalid_base, v) == upa::validation_errc::invalid_base);
+        CHECK(cache.parse("file", nullptr, v) == upa::validation_errc::missing_scheme_non_relative_url);
+    }
+    SUBCASE("clear") {
+        cache.clear();
+        st = cache.stats();
+        CHECK(st.hits == 0);
+        CHECK(st.misses == 0);
+        CHECK(st.size == 0);
+        // the shared object lives on
+        CHECK(u1->href() == "https://example.org/path");
+    }
+}
+
+TEST_CASE("url_parse_cache eviction") {
+    upa::url_parse_cache cache(2, 1);
+    CHECK(cache.capacity() == 2);
+
+    const auto a = cache.get("https://a.example/");
+    static_cast<void>(cache.get("https://b.example/"));
+    // make "a" most recently used
+    CHECK(cache.get("https://a.example/") == a);
+    // evicts "b"
+    static_cast<void>(cache.get("https://c.example/"));
+    auto st = cache.stats();
+    CHECK(st.evictions == 1);
+    CHECK(st.size == 2);
+
+    CHECK(cache.get("https://a.example/") == a);
+    CHECK(cache.stats().hits == 2);
+    static_cast<void>(cache.get("https://b.example/"));
+    st = cache.stats();
+    CHECK(st.misses == 4);
+    CHECK(st.evictions == 2);
+    CHECK(st.size == 2);
+}
+
+TEST_CASE("url_parse_cache concurrent use") {
+    upa::url_parse_cache cache(64, 4);
+
+    std::vector<std::string> inputs;
+    for (int ind = 0; ind < 100; ++ind)
+        inputs.push_back("https://host" + std::to_string(ind % 10) + ".example/" + std::to_string(ind));
+
+    std::atomic<int> errors{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int pass = 0; pass < 20; ++pass) {
+                for (const auto& input : inputs) {
+                    const auto u = cache.get(input);
+                    if (!u || u->href() != input)
+                        ++errors;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(errors == 0);
+    const auto st = cache.stats();
+    CHECK(st.hits + st.misses == 4 * 20 * inputs.size());
+    CHECK(st.size <= cache.capacity());
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url.h"
+#include "doctest-main.h"
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+template <class Range>
+static std::vector<std::string> to_vector(const Range& range) {
+    std::vector<std::string> res;
+    for (const auto segment : range)
+        res.emplace_back(segment);
+    return res;
+}
+
+using strings = std::vector<std::string>;
+
+TEST_CASE("url::path_segments") {
+    SUBCASE("segments") {
+        const upa::url url{ "https://example.org/api/users/42?q#f" };
+        const auto segments = url.path_segments();
+        CHECK(to_vector(segments) == strings{ "api", "users", "42" });
+        CHECK(segments.size() == 3);
+        CHECK_FALSE(segments.empty());
+        CHECK(segments.front() == "api");
+        CHECK(segments.back() == "42");
+        CHECK(segments[1] == "users");
+    }
+    SUBCASE("empty segments") {
+        CHECK(to_vector(upa::url{ "http://h/" }.path_segments()) == strings{ "" });
+        CHECK(to_vector(upa::url{ "http://h/a/" }.path_segments()) == strings{ "a", "" });
+        CHECK(to_vector(upa::url{ "http://h//a" }.path_segments()) == strings{ "", "a" });
+        CHECK(to_vector(upa::url{ "non-spec:/.//p" }.path_segments()) == strings{ "", "p" });
+        CHECK(upa::url{ "http://h/" }.path_segments().back().empty());
+    }
+    SUBCASE("no segments") {
+        const upa::url url{ "non-spec://h" };
+        CHECK(url.path_segments().empty());
+        CHECK(url.path_segments().begin() == url.path_segments().end());
+        CHECK(upa::url{}.path_segments().empty());
+        // opaque path
+        CHECK(upa::url{ "mailto:user@example.org" }.path_segments().empty());
+        CHECK(to_vector(upa::url{ "mailto:user@example.org" }.path_segments()).empty());
+    }
+    SUBCASE("size matches the iterated segments") {
+        for (const char* str_url : {
+            "http://h/", "http://h/a/b/c", "http://h/a/../b/./c/..", "file:///C:/dir/file",
+            "file://h/C|/../..", "non-spec:/a/b", "non-spec://h", "blob:http://h/p" }) {
+            INFO("url: " << str_url);
+            const upa::url url{ str_url };
+            const auto segments = url.path_segments();
+            CHECK(segments.size() == static_cast<std::size_t>(std::distance(segments.begin(), segments.end())));
+        }
+    }
+    SUBCASE("after setters") {
+        upa::url url{ "http://h/a/b" };
+        url.pathname("/x/y/z");
+        CHECK(to_vector(url.path_segments()) == strings{ "x", "y", "z" });
+        CHECK(url.path_segments().size() == 3);
+        url.href("http://h/a/b/../c/");
+        CHECK(to_vector(url.path_segments()) == strings{ "a", "c", "" });
+        CHECK(url.path_segments().size() == 3);
+    }
+}
+
+TEST_CASE("path_segments_view::decoded") {
+    const upa::url url{ "http://h/my%20file/%E2%82%AC/%zz/plain/%C4" };
+    const auto decoded = url.path_segments().decoded();
+    CHECK(decoded.size() == 5);
+    CHECK(to_vector(decoded) == strings{ "my file", "\xE2\x82\xAC", "%zz", "plain", "\xEF\xBF\xBD" });
+
+    // copied iterator has its own buffer
+    auto it = decoded.begin();
+    const auto copy = it;
+    ++it;
+    CHECK(*copy == "my file");
+    CHECK(*it == "\xE2\x82\xAC");
+
+    const upa::url url_opaque{ "mailto:x" };
+    CHECK(url_opaque.path_segments().decoded().begin() == url_opaque.path_segments().decoded().end());
+}
+
+TEST_CASE("path_segments_index") {
+    const upa::url url{ "https://example.org/users/42/orders/" };
+
+    upa::path_segments_index index{ url.path_segments() };
+    REQUIRE(index.size() == 4);
+    CHECK(index[0] == "users");
+    CHECK(index[1] == "42");
+    CHECK(index[2] == "orders");
+    CHECK(index[3] == "");
+
+    const upa::url url2{ "https://example.org/" };
+    index.assign(url2.path_segments());
+    REQUIRE(index.size() == 1);
+    CHECK(index[0] == "");
+
+    index.assign(upa::url{ "mailto:x" }.path_segments());
+    CHECK(index.empty());
+    CHECK(upa::path_segments_index{}.empty());
+}
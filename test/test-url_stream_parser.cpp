@@ -0,0 +1,107 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "upa/url_stream_parser.h"
+#include "doctest-main.h"
+#include <string>
+#include <string_view>
+
+
+// Parses input split into chunks at every position (two chunks), and in
+// one-byte chunks; the results must match the one-shot parse result
+static void check_chunked_parse(std::string_view input, const upa::url* base = nullptr) {
+    INFO("input: " << input);
+
+    upa::url expected;
+    const auto expected_res = expected.parse(input, base);
+
+    upa::url_stream_parser parser{ base };
+    for (std::size_t split = 0; split <= input.length(); ++split) {
+        INFO("split at: " << split);
+        parser.push(input.substr(0, split));
+        parser.push(input.substr(split));
+
+        upa::url url;
+        REQUIRE(parser.finish(url) == expected_res);
+        if (upa::success(expected_res))
+            CHECK(url.href() == expected.href());
+    }
+
+    for (const char c : input)
+        parser.push(std::string_view{ &c, 1 });
+    upa::url url;
+    REQUIRE(parser.finish(url) == expected_res);
+    if (upa::success(expected_res))
+        CHECK(url.href() == expected.href());
+}
+
+TEST_CASE("url_stream_parser gives the same results as url::parse") {
+    check_chunked_parse("https://example.org/path?query#fragment");
+    check_chunked_parse("https://example.org/path");
+    check_chunked_parse("https://example.org/?a=1&b=%20#");
+    check_chunked_parse("https://example.org#frag?not-query#x");
+    check_chunked_parse("non-spec://h/p?q 'x'#f 'y'");
+    check_chunked_parse("http://h/?q 'x'#f");
+    // leading and trailing C0 controls and spaces
+    check_chunked_parse("  http://h/ ?\x01q \x01 #  f \x01 ");
+    check_chunked_parse("http://h/?q  \x01 ");
+    // ASCII tab or newline
+    check_chunked_parse("ht\ttp://h/\np?a\t=\n1\r#f\tg\n");
+    // UTF-8 and invalid UTF-8 sequences
+    check_chunked_parse("http://h/\xC4\x85?\xC4\x85\xE2\x82\xAC\xF0\x9F\x98\x80#\xE2\x82\xAC");
+    check_chunked_parse("http://h/?\xE2\x82#\xF0\x9F\x98");
+    check_chunked_parse("http://h/?\xE2\t\x82\n\xAC");
+    check_chunked_parse("http://h/?\xE0\x80\xBF\xC0\xAFx\xE2 ");
+    check_chunked_parse("http://h/?\xF0\x9F\x98 #");
+    // opaque path
+    check_chunked_parse("data:text/plain,a b ?q#f");
+    check_chunked_parse("javascript:alert(1)  #f");
+    // failure
+    check_chunked_parse("http://a b/?q");
+    check_chunked_parse("http://[::1/#f");
+    check_chunked_parse("/path?q");
+}
+
+TEST_CASE("url_stream_parser parses relative request-target") {
+    const upa::url base{ "http://example.org/dir/" };
+    check_chunked_parse("/path?q=1#f", &base);
+    check_chunked_parse("file?q", &base);
+    check_chunked_parse("../up#f", &base);
+    check_chunked_parse("?only-query", &base);
+    check_chunked_parse("//other.example/?q", &base);
+}
+
+TEST_CASE("url_stream_parser rejects invalid URL early") {
+    upa::url_stream_parser parser;
+
+    CHECK(parser.push("http://exa"));
+    CHECK(parser.push("mple org/path"));
+    CHECK_FALSE(parser.failed());
+    // the URL before the query is parsed when the query starts
+    CHECK_FALSE(parser.push("?a=1"));
+    CHECK(parser.failed());
+    CHECK_FALSE(parser.push("&b=2"));
+
+    upa::url url{ "http://unchanged/" };
+    CHECK(parser.finish(url) == upa::url{}.parse("http://example org/path?a=1&b=2"));
+    CHECK(url.href() == "http://unchanged/");
+
+    // the parser is reset by finish
+    CHECK_FALSE(parser.failed());
+    CHECK(parser.push("http://example.org/?a=1"));
+    CHECK(upa::success(parser.finish(url)));
+    CHECK(url.href() == "http://example.org/?a=1");
+}
+
+TEST_CASE("url_stream_parser updates search params") {
+    upa::url_stream_parser parser;
+    parser.push("http://example.org/?a=1");
+    parser.push("&b=2");
+
+    upa::url url;
+    REQUIRE(upa::success(parser.finish(url)));
+    CHECK(url.search_params().to_string() == "a=1&b=2");
+    CHECK(url.search_params().has("b", "2"));
+}
@@ -0,0 +1,188 @@
+// Copyright 2026 Rimas Misevičius
+// Distributed under the BSD-style license that can be
+// found in the LICENSE file.
+//
+#include "upa/url.h"
+#include "upa/urlpattern.h"
+#ifdef UPA_TEST_WITH_STD_REGEX
+# include "upa/regex_engine_std.h"
+#else
+# include "upa/regex_engine_srell.h"
+#endif
+#include "doctest-main.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef UPA_TEST_WITH_STD_REGEX
+using regex_engine = upa::regex_engine_std;
+#else
+using regex_engine = upa::regex_engine_srell;
+#endif
+using urlpattern = upa::urlpattern<regex_engine>;
+
+
+TEST_CASE("urlpattern_component_pool shares components") {
+    upa::urlpattern_component_pool<regex_engine> pool;
+
+    std::vector<urlpattern> patterns;
+    patterns.emplace_back("https://example.com/books/:id", upa::urlpattern_options{}, pool);
+    // the "*" username, password, search and hash components are distinct,
+    // because they have different encoding callbacks
+    CHECK(pool.size() == 8);
+    patterns.emplace_back("https://example.com/authors/:id", upa::urlpattern_options{}, pool);
+    CHECK(pool.size() == 9);
+    patterns.emplace_back("https://example.org/authors/:id", upa::urlpattern_options{}, pool);
+    CHECK(pool.size() == 10);
+    // ignore case changes the pathname, search and hash components
+    patterns.emplace_back("https://example.org/authors/:id", upa::urlpattern_options{ true }, pool);
+    CHECK(pool.size() == 13);
+    // base URL
+    patterns.emplace_back("/books/:id", "https://example.com", upa::urlpattern_options{}, pool);
+    CHECK(pool.size() == 13);
+    // urlpattern_init
+    upa::urlpattern_init init;
+    init.protocol = "https";
+    init.hostname = "example.com";
+    patterns.emplace_back(init, upa::urlpattern_options{}, pool);
+    // the "*" port and pathname are new
+    CHECK(pool.size() == 15);
+
+    CHECK(patterns[0].get_pathname() == "/books/:id");
+    CHECK(patterns[4].get_pathname() == "/books/:id");
+    CHECK(patterns[5].get_pathname() == "*");
+
+    const upa::url url{ "https://example.com/books/123" };
+    CHECK(patterns[0].test(url));
+    CHECK_FALSE(patterns[1].test(url));
+    CHECK_FALSE(patterns[2].test(url));
+    CHECK(patterns[4].test(url));
+    CHECK(patterns[5].test(url));
+
+    // the patterns do not depend on the pool
+    pool.clear();
+    CHECK(pool.size() == 0);
+    const auto res = patterns[0].exec(url);
+    REQUIRE(res);
+    CHECK(res->pathname.groups.at("id") == "123");
+
+    // invalid pattern
+    CHECK_THROWS_AS(urlpattern("https://example.com/(", upa::urlpattern_options{}, pool), upa::urlpattern_error);
+}
+
+TEST_CASE("urlpattern copy and move") {
+    const upa::url url{ "https://example.com/books/123" };
+
+    urlpattern a{ "https://example.com/books/:id" };
+    const urlpattern copy{ a };
+    CHECK(copy.get_pathname() == "/books/:id");
+    CHECK(copy.test(url));
+
+    // the moved-from URL pattern keeps its components
+    const urlpattern b{ std::move(a) };
+    CHECK(b.get_pathname() == "/books/:id");
+    CHECK(b.test(url));
+    CHECK(a.get_protocol() == "https"); // NOLINT(bugprone-use-after-move)
+    CHECK(a.test(url));
+    const auto res = a.exec(url);
+    REQUIRE(res);
+    CHECK(res->pathname.groups.at("id") == "123");
+
+    urlpattern c{ "http://*" };
+    c = std::move(a);
+    CHECK(c.get_pathname() == "/books/:id");
+    CHECK(a.get_pathname() == "/books/:id"); // NOLINT(bugprone-use-after-move)
+    c = copy;
+    CHECK(c.test(url));
+}
+
+TEST_CASE("urlpattern_component_cache") {
+    upa::urlpattern_component_pool<regex_engine> pool;
+    upa::urlpattern_component_pool<regex_engine> other_pool;
+
+    std::vector<urlpattern> patterns;
+    patterns.emplace_back("https://example.com/books/:id", upa::urlpattern_options{}, pool);
+    patterns.emplace_back("https://example.com/authors/:id", upa::urlpattern_options{}, pool);
+    patterns.emplace_back("http{s}?://*.example.org/*", upa::urlpattern_options{}, pool);
+    patterns.emplace_back("https://example.com/authors/:id", upa::urlpattern_options{}, other_pool);
+    patterns.emplace_back("https://example.com/authors/:id");
+
+    const std::vector<upa::url> urls{
+        upa::url{ "https://example.com/books/1" },
+        upa::url{ "https://example.com/authors/2" },
+        upa::url{ "http://www.example.org/" },
+        upa::url{ "https://user@example.com/books/1" },
+        upa::url{}
+    };
+
+    upa::urlpattern_component_cache<regex_engine> cache(pool);
+    for (const auto& url : urls) {
+        cache.reset();
+        for (const auto& urlp : patterns) {
+            CHECK(urlp.test(url, cache) == urlp.test(url));
+            // the cached results are used
+            CHECK(urlp.test(url, cache) == urlp.test(url));
+        }
+    }
+}
+
+TEST_CASE("urlpattern with urlpattern_exec_context") {
+    const std::vector<urlpattern> patterns{
+        urlpattern{ "https://*.example.com/books/:id" },
+        urlpattern{ "http{s}?://example.org:8080/*" },
+        urlpattern{ "mailto:*" },
+        urlpattern{ "*://*/a%20b?q=*#*" }
+    };
+
+    const auto make_init = [](std::initializer_list<std::optional<std::string>> list) {
+        upa::urlpattern_init init;
+        std::optional<std::string>* fields[] = {
+            &init.protocol, &init.username, &init.password, &init.hostname,
+            &init.port, &init.pathname, &init.search, &init.hash, &init.base_url
+        };
+        std::size_t ind = 0;
+        for (const auto& value : list)
+            *fields[ind++] = value;
+        return init;
+    };
+    const auto none = std::optional<std::string>{};
+    const std::vector<upa::urlpattern_init> inputs{
+        make_init({ "https", none, none, "www.EXAMPLE.com", none, "/books/12" }),
+        make_init({ "HTTPS:", none, none, "www.example.com", "443", "/books/../books/12" }),
+        make_init({ none, none, none, none, none, "12", none, none, "https://a.example.com/books/x" }),
+        make_init({ none, none, none, none, none, "/x/y", "?a", "#b", "http://u:p@example.org:8080/" }),
+        make_init({ none, "user", none, none, none, none, none, none, "http://u:p@example.org:8080/" }),
+        make_init({ "http", none, none, "example.org", "08080", "/" }),
+        make_init({ "mailto", none, none, none, none, "User@example.com" }),
+        make_init({ "foo", none, none, "h", none, "/a b", "q=x", "y z" }),
+        make_init({ "foo", none, none, "h", none, "a b", none, none }),
+        // invalid inputs
+        make_init({ "https", none, none, "a b.example.com", none, "/books/12" }),
+        make_init({ "https", none, none, "www.example.com", "x", "/books/12" }),
+        make_init({ "ht tp" }),
+        make_init({ none, none, none, none, none, "/books/12", none, none, "not a url" })
+    };
+
+    upa::urlpattern_exec_context ctx;
+    for (const auto& input : inputs) {
+        for (const auto& urlp : patterns) {
+            CHECK(urlp.test(input, ctx) == urlp.test(input));
+            const auto res_ctx = urlp.exec(input, ctx);
+            const auto res = urlp.exec(input);
+            REQUIRE(res_ctx.has_value() == res.has_value());
+            if (res) {
+                CHECK(res_ctx->pathname.input == res->pathname.input);
+                CHECK(res_ctx->pathname.groups == res->pathname.groups);
+                CHECK(res_ctx->hostname.groups == res->hostname.groups);
+                CHECK(res_ctx->search.input == res->search.input);
+                CHECK(res_ctx->hash.input == res->hash.input);
+            }
+        }
+    }
+
+    const auto res = patterns[0].exec(inputs[0], ctx);
+    REQUIRE(res);
+    CHECK(res->hostname.input == "www.example.com");
+    CHECK(res->pathname.groups.at("id") == "12");
+    CHECK(ctx.component(5) == "/books/12");
+}
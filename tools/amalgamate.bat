@@ -17,6 +17,16 @@ python tools/amalgamate/amalgamate.py -c tools/amalgamate/config-urlpattern-cpp.
 python tools/amalgamate/amalgamate.py -c tools/amalgamate/config-urlpattern-h.json -s .
 
 REM Copy other header files
+copy /y include\upa\mapped_file.h single_include\upa
 copy /y include\upa\public_suffix_list.h single_include\upa
 copy /y include\upa\regex_engine_*.h single_include\upa
+copy /y include\upa\shared_url.h single_include\upa
+copy /y include\upa\url_cache_key.h single_include\upa
+copy /y include\upa\url_codec.h single_include\upa
+copy /y include\upa\url_data.h single_include\upa
+copy /y include\upa\url_dictionary.h single_include\upa
+copy /y include\upa\url_finder.h single_include\upa
 copy /y include\upa\url_for_*.h single_include\upa
+copy /y include\upa\url_parse_cache.h single_include\upa
+copy /y include\upa\url_stream_parser.h single_include\upa
+copy /y include\upa\url_table.h single_include\upa
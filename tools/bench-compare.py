@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#
+# Compare nanobench JSON outputs (for example, of bench-url-ops) with a
+# baseline, and report changes per operation
+#
+# Usage: bench-compare.py <baseline.json> <current.json> [<threshold %>]
+#
+# Exits with status 1 if some operation is slower than the baseline by more
+# than the threshold (5% by default).
+#
+# Copyright 2026 Rimas Misevičius
+# Distributed under the BSD-style license that can be
+# found in the LICENSE file.
+import json
+import sys
+
+# Load results: {(title, name): (ns per unit, unit, error %)}
+def load_results(file_path):
+    with open(file_path, "r", encoding="utf-8") as file:
+        results = json.load(file)["results"]
+    res = {}
+    for item in results:
+        batch = item.get("batch", 1) or 1
+        ns = item["median(elapsed)"] / batch * 1e9
+        err = item.get("medianAbsolutePercentError(elapsed)", 0.0) * 100
+        res[(item.get("title", ""), item["name"])] = (ns, item.get("unit", "op"), err)
+    return res
+
+def main():
+    if len(sys.argv) < 3:
+        print("Usage: bench-compare.py <baseline.json> <current.json> [<threshold %>]")
+        return 2
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 5.0
+
+    baseline = load_results(sys.argv[1])
+    current = load_results(sys.argv[2])
+
+    regressions = 0
+    print(f"{'change':>9} {'baseline':>14} {'current':>14}  operation")
+    for key, (ns, unit, err) in current.items():
+        name = key[1]
+        if key not in baseline:
+            print(f"{'new':>9} {'':>14} {ns:11.2f} ns/{unit}  {name}")
+            continue
+        base_ns = baseline[key][0]
+        change = (ns - base_ns) / base_ns * 100 if base_ns else 0.0
+        mark = ""
+        if change > threshold:
+            mark = "  <- REGRESSION"
+            regressions += 1
+        elif change < -threshold:
+            mark = "  <- improvement"
+        print(f"{change:+8.1f}% {base_ns:11.2f} ns {ns:11.2f} ns  {name} (±{err:.1f}%){mark}")
+    for key in baseline:
+        if key not in current:
+            print(f"{'removed':>9} {baseline[key][0]:11.2f} ns {'':>14}  {key[1]}")
+
+    if regressions:
+        print(f"{regressions} operation(s) slower by more than {threshold}%")
+        return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())